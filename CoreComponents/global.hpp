@@ -36,6 +36,22 @@
  */
 typedef uint8_t (*uint8_array_t)[];
 
+/**
+ * @brief  Assumed size of a cache line in bytes, used to place data that is written by different threads on separate cache lines.
+ */
+constexpr std::size_t cacheLineSize = 64;
+
+/**
+ * @brief      Check at compile time whether a value is a power of two.
+ * @param[in]  value
+ *             The value to check.
+ * @return     `true` if `value` is a power of two, `false` otherwise (including zero).
+ */
+constexpr bool isPowerOfTwo(std::size_t value)
+{
+  return (value != 0) && ((value & (value - 1)) == 0);
+}
+
 /*************************************************************************\
  * Prototypes
 \*************************************************************************/
@@ -0,0 +1,458 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     timer_wheel.hpp
+ * @version  0.1
+ * @brief    Definition of the timerWheel class.
+ * @details  The `timerWheel` class is a hierarchical timing wheel with statically allocated memory, after Varghese and Lauck.
+ *           It manages many timeouts, like command acknowledgements, retries and polling intervals, and calls `process()` of a
+ *           `baseClass`-derived object when its timer expires.
+ *
+ *           Time advances in ticks of a fixed, application defined length. The wheel consists of `levelCount` levels of
+ *           `slotsPerLevel` slots each. A slot of level 0 holds the timers that expire in one particular tick, a slot of
+ *           level 1 the timers of `slotsPerLevel` consecutive ticks, and so on. Every slot is an intrusive doubly linked list
+ *           of timers, so scheduling and cancelling a timer take O(1), independent of the number of timers. Whenever level 0
+ *           completes a rotation, the timers of the next slot of level 1 are distributed over level 0 (and likewise for the
+ *           higher levels). Every timer is moved at most `levelCount - 1` times, so a tick costs amortized O(1) plus the
+ *           timers that expire in it.
+ *
+ *           Timers are identified by a handle. A handle becomes invalid once its one-shot timer expired or it was cancelled,
+ *           so a stale handle never cancels a newer timer that reuses the same storage.
+ *
+ *           To use the `timerWheel` class, follow these steps:
+ *           -# Instantiate an instance with the maximum number of timers as template parameter,
+ *              like this: `timerWheel<1024> myTimerWheel;`.
+ *           -# Call `schedule()` with the object to process and the delay in ticks, like this:
+ *              `const timerWheel<1024>::handle_t myTimeout = myTimerWheel.schedule(myDevice, 50);`.
+ *              Pass a period as well to process the object repeatedly, like this: `myTimerWheel.schedule(myPoller, 10, 10);`.
+ *           -# Call `tick()` once per tick, or `advance()` with the number of ticks that passed, e.g. from a periodic task.
+ *              The expired objects are processed from within these calls.
+ *           -# Call `cancel()` with the handle when the timeout is no longer needed, e.g. when the acknowledgement arrived.
+ *
+ * @note     Not thread-safe: `schedule()`, `cancel()`, `tick()` and `advance()` must be called from the same thread, which is
+ *           also the thread that `process()` runs in. `process()` may schedule and cancel timers, including its own.
+ *           The number of slots per level must be a power of two, and the wheel needs at least two levels. Delays beyond the
+ *           range of the wheel (`slotsPerLevel` to the power of `levelCount` ticks) are supported, such timers just wait in
+ *           the last level and are placed again whenever their slot cascades, until they are in range.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+/**
+ * @brief    Class template for a hierarchical timing wheel with statically allocated memory.
+ * @tparam   timerCount
+ *           The maximum number of timers that can be scheduled at the same time, at most 65534.
+ * @tparam   slotsPerLevel
+ *           The number of slots per level, which must be a power of two of at least 2. The default is 64.
+ * @tparam   levelCount
+ *           The number of levels, at least 2. The default of 4 covers 2^24 ticks with 64 slots per level.
+ */
+template <std::size_t timerCount, std::size_t slotsPerLevel = 64, std::size_t levelCount = 4>
+class timerWheel
+{
+public:
+  typedef uint32_t handle_t; //!< Identifies a scheduled timer.
+
+  static constexpr handle_t invalidHandle = 0; //!< Returned by `schedule()` when all timers are in use.
+
+  /**
+   * @brief  Constructor that initializes the wheel at tick 0 without any timers.
+   */
+  timerWheel();
+
+  // Rule of Five
+  timerWheel(const timerWheel&)            = delete;
+  timerWheel& operator=(const timerWheel&) = delete;
+  timerWheel(timerWheel&&)                 = delete;
+  timerWheel& operator=(timerWheel&&)      = delete;
+  ~timerWheel()                            = default;
+
+  /**
+   * @brief      Schedule an object to be processed after a delay.
+   * @param[in]  target
+   *             The object whose `process()` is called when the timer expires. It must outlive the timer.
+   * @param[in]  delay
+   *             The number of ticks until the timer expires, at least 1. A delay of 1 expires in the next `tick()`.
+   * @param[in]  period
+   *             The number of ticks between repeated expiries, or 0 (the default) for a one-shot timer.
+   * @return     The handle of the timer, or `invalidHandle` if all timers are in use.
+   */
+  handle_t schedule(baseClass& target, uint64_t delay, uint64_t period = 0);
+
+  /**
+   * @brief      Cancel a scheduled timer.
+   * @param[in]  handle
+   *             The handle returned by `schedule()`.
+   * @return     `true` if the timer was cancelled, `false` if it already expired or the handle is invalid.
+   */
+  bool cancel(handle_t handle);
+
+  /**
+   * @brief      Check if a timer is still scheduled.
+   * @param[in]  handle
+   *             The handle returned by `schedule()`.
+   * @return     `true` if the timer will still expire, `false` if it expired, was cancelled or the handle is invalid.
+   */
+  bool isScheduled(handle_t handle) const;
+
+  /**
+   * @brief   Advance the wheel by one tick and process the objects whose timers expire in it.
+   * @return  The number of objects processed.
+   */
+  std::size_t tick();
+
+  /**
+   * @brief      Advance the wheel by several ticks and process the objects whose timers expire in them, in expiry order.
+   * @details    While no timer is scheduled, the ticks are skipped at once.
+   * @param[in]  ticks
+   *             The number of ticks to advance.
+   * @return     The number of objects processed.
+   */
+  std::size_t advance(uint64_t ticks);
+
+  /**
+   * @brief   Get the current time of the wheel.
+   * @return  The number of ticks that passed since construction.
+   */
+  uint64_t now() const;
+
+  /**
+   * @brief   Get the number of scheduled timers.
+   * @return  The number of timers that will still expire.
+   */
+  std::size_t activeCount() const;
+
+  /**
+   * @brief   Get the maximum number of timers that can be scheduled at the same time.
+   * @return  The capacity of the wheel.
+   */
+  constexpr std::size_t capacity() const;
+
+private:
+  static_assert(timerCount > 0 && timerCount < 0xFFFF, "timerCount must be between 1 and 65534.");
+  static_assert(isPowerOfTwo(slotsPerLevel) && slotsPerLevel > 1, "slotsPerLevel must be a power of two of at least 2.");
+  static_assert(levelCount > 1, "The wheel needs at least two levels, a single level never cascades its timers.");
+
+  /**
+   * @brief      Calculate the number of bits of a slot index at compile time.
+   * @param[in]  value
+   *             The number of slots, a power of two.
+   * @return     The base-2 logarithm of `value`.
+   */
+  static constexpr std::size_t log2(std::size_t value)
+  {
+    return (value <= 1) ? 0 : 1 + log2(value / 2);
+  }
+
+  static constexpr std::size_t slotBits = log2(slotsPerLevel); //!< Number of bits of a slot index.
+  static constexpr uint64_t    slotMask = slotsPerLevel - 1;   //!< Mask to convert a tick into a slot index.
+  static_assert(slotBits * levelCount < 64, "The wheel must not span more than 2^63 ticks.");
+  static constexpr uint64_t maxOffset = (uint64_t(1) << (slotBits * levelCount)) - 1; //!< Farthest offset the wheel can place.
+
+  static constexpr uint32_t noTimer      = 0xFFFF;                     //!< Marks the end of a list.
+  static constexpr uint32_t expiringList = levelCount * slotsPerLevel; //!< List of the timers expiring in the current tick.
+  static constexpr uint32_t freeList     = expiringList + 1;           //!< List of the unused timers.
+  static constexpr uint32_t listCount    = freeList + 1;               //!< Number of lists, the slots followed by both.
+
+  /**
+   * @brief  A timer, linked into the list of its slot, the expiring list or the free list.
+   */
+  struct timer_t
+  {
+    baseClass* target;     //!< Object to process on expiry.
+    uint64_t   expiry;     //!< Tick in which the timer expires.
+    uint64_t   period;     //!< Ticks between repeated expiries, 0 for a one-shot timer.
+    uint32_t   list;       //!< List the timer is linked into.
+    uint16_t   next;       //!< Next timer in the list.
+    uint16_t   previous;   //!< Previous timer in the list.
+    uint16_t   generation; //!< Incremented on every reuse, so stale handles can be told apart.
+  };
+
+  /**
+   * @brief      Find the timer of a handle.
+   * @param[in]  handle
+   *             The handle to look up.
+   * @return     The index of the timer, or `noTimer` if the handle does not belong to a scheduled timer.
+   */
+  uint32_t find(handle_t handle) const;
+
+  /**
+   * @brief      Link a timer into the slot that matches its expiry, relative to the next tick to process.
+   * @param[in]  index
+   *             The index of the timer, which must not be linked into a list.
+   */
+  void place(uint32_t index);
+
+  /**
+   * @brief      Distribute the timers of a slot over the lower levels.
+   * @param[in]  level
+   *             The level of the slot, at least 1.
+   * @param[in]  slot
+   *             The index of the slot within the level.
+   */
+  void cascade(std::size_t level, std::size_t slot);
+
+  /**
+   * @brief      Link a timer at the front of a list.
+   * @param[in]  index
+   *             The index of the timer, which must not be linked into a list.
+   * @param[in]  list
+   *             The list to link the timer into.
+   */
+  void link(uint32_t index, uint32_t list);
+
+  /**
+   * @brief      Remove a timer from its list.
+   * @param[in]  index
+   *             The index of the timer.
+   */
+  void unlink(uint32_t index);
+
+  timer_t     m_timers[timerCount];  //!< The statically allocated timers.
+  uint16_t    m_listHead[listCount]; //!< First timer of every slot, of the expiring list and of the free list.
+  uint64_t    m_nextTick;            //!< The tick that the next call of `tick()` processes.
+  std::size_t m_activeCount;         //!< Number of scheduled timers.
+};
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+timerWheel<timerCount, slotsPerLevel, levelCount>::timerWheel() : m_nextTick(0), m_activeCount(0)
+{
+  for (uint32_t list = 0; list < listCount; ++list)
+  {
+    m_listHead[list] = noTimer;
+  }
+  for (uint32_t index = timerCount; index > 0; --index)
+  {
+    m_timers[index - 1].target     = nullptr;
+    m_timers[index - 1].generation = 0;
+    link(index - 1, freeList);
+  }
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+typename timerWheel<timerCount, slotsPerLevel, levelCount>::handle_t
+timerWheel<timerCount, slotsPerLevel, levelCount>::schedule(baseClass& target, uint64_t delay, uint64_t period)
+{
+  const uint32_t index = m_listHead[freeList];
+  if (index == noTimer)
+  {
+    return invalidHandle;
+  }
+  unlink(index);
+
+  timer_t& timer = m_timers[index];
+  timer.target   = &target;
+  timer.expiry   = m_nextTick + ((delay > 0) ? delay - 1 : 0);
+  timer.period   = period;
+
+  // Generation 0 is skipped, so no handle equals invalidHandle
+  timer.generation = static_cast<uint16_t>((timer.generation == 0xFFFF) ? 1 : timer.generation + 1);
+  place(index);
+  m_activeCount++;
+
+  return (static_cast<handle_t>(timer.generation) << 16) | index;
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+bool timerWheel<timerCount, slotsPerLevel, levelCount>::cancel(handle_t handle)
+{
+  const uint32_t index = find(handle);
+  if (index == noTimer)
+  {
+    return false;
+  }
+
+  unlink(index);
+  link(index, freeList);
+  m_activeCount--;
+  return true;
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+bool timerWheel<timerCount, slotsPerLevel, levelCount>::isScheduled(handle_t handle) const
+{
+  return find(handle) != noTimer;
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+std::size_t timerWheel<timerCount, slotsPerLevel, levelCount>::tick()
+{
+  const uint64_t    currentTick = m_nextTick;
+  const std::size_t slot        = static_cast<std::size_t>(currentTick & slotMask);
+
+  // Once level 0 completes a rotation, refill it from the next slot of level 1, and so on upwards
+  if (slot == 0)
+  {
+    for (std::size_t level = 1; level < levelCount; ++level)
+    {
+      const std::size_t levelSlot = static_cast<std::size_t>((currentTick >> (level * slotBits)) & slotMask);
+      cascade(level, levelSlot);
+      if (levelSlot != 0)
+      {
+        break;
+      }
+    }
+  }
+  m_nextTick++;
+
+  // Move the expiring timers to their own list first, so timers scheduled by process() never expire in this tick
+  uint32_t index = m_listHead[slot];
+  while (index != noTimer)
+  {
+    const uint32_t next = m_timers[index].next;
+    unlink(index);
+    link(index, expiringList);
+    index = next;
+  }
+
+  std::size_t processedCount = 0;
+  while (m_listHead[expiringList] != noTimer)
+  {
+    index          = m_listHead[expiringList];
+    timer_t& timer = m_timers[index];
+    unlink(index);
+
+    // Periodic timers are rescheduled before processing, so process() can still cancel them
+    if (timer.period > 0)
+    {
+      timer.expiry = currentTick + timer.period;
+      place(index);
+    }
+    else
+    {
+      link(index, freeList);
+      m_activeCount--;
+    }
+    timer.target->process();
+    processedCount++;
+  }
+  return processedCount;
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+std::size_t timerWheel<timerCount, slotsPerLevel, levelCount>::advance(uint64_t ticks)
+{
+  std::size_t processedCount = 0;
+  for (uint64_t i = 0; i < ticks; ++i)
+  {
+    if (m_activeCount == 0)
+    {
+      // All slots are empty, so the remaining ticks need no cascading
+      m_nextTick += ticks - i;
+      break;
+    }
+    processedCount += tick();
+  }
+  return processedCount;
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+uint64_t timerWheel<timerCount, slotsPerLevel, levelCount>::now() const
+{
+  return m_nextTick;
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+std::size_t timerWheel<timerCount, slotsPerLevel, levelCount>::activeCount() const
+{
+  return m_activeCount;
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+constexpr std::size_t timerWheel<timerCount, slotsPerLevel, levelCount>::capacity() const
+{
+  return timerCount;
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+uint32_t timerWheel<timerCount, slotsPerLevel, levelCount>::find(handle_t handle) const
+{
+  const uint32_t index      = handle & 0xFFFF;
+  const uint16_t generation = static_cast<uint16_t>(handle >> 16);
+
+  if (index >= timerCount || generation == 0 || m_timers[index].generation != generation || m_timers[index].list == freeList)
+  {
+    return noTimer;
+  }
+  return index;
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+void timerWheel<timerCount, slotsPerLevel, levelCount>::place(uint32_t index)
+{
+  const uint64_t offset = m_timers[index].expiry - m_nextTick;
+
+  // Timers beyond the range of the wheel wait in the last slot it can reach and are placed again when it cascades
+  const uint64_t placedOffset = (offset > maxOffset) ? maxOffset : offset;
+  const uint64_t placedTick   = m_nextTick + placedOffset;
+
+  std::size_t level = 0;
+  while ((level + 1 < levelCount) && (placedOffset >> ((level + 1) * slotBits)) != 0)
+  {
+    level++;
+  }
+  const std::size_t slot = static_cast<std::size_t>((placedTick >> (level * slotBits)) & slotMask);
+  link(index, static_cast<uint32_t>(level * slotsPerLevel + slot));
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+void timerWheel<timerCount, slotsPerLevel, levelCount>::cascade(std::size_t level, std::size_t slot)
+{
+  const uint32_t list  = static_cast<uint32_t>(level * slotsPerLevel + slot);
+  uint32_t       index = m_listHead[list];
+  m_listHead[list]     = noTimer;
+
+  while (index != noTimer)
+  {
+    const uint32_t next = m_timers[index].next;
+    place(index);
+    index = next;
+  }
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+void timerWheel<timerCount, slotsPerLevel, levelCount>::link(uint32_t index, uint32_t list)
+{
+  timer_t& timer = m_timers[index];
+  timer.list     = list;
+  timer.previous = noTimer;
+  timer.next     = m_listHead[list];
+  if (timer.next != noTimer)
+  {
+    m_timers[timer.next].previous = static_cast<uint16_t>(index);
+  }
+  m_listHead[list] = static_cast<uint16_t>(index);
+}
+
+template <std::size_t timerCount, std::size_t slotsPerLevel, std::size_t levelCount>
+void timerWheel<timerCount, slotsPerLevel, levelCount>::unlink(uint32_t index)
+{
+  timer_t& timer = m_timers[index];
+  if (timer.previous != noTimer)
+  {
+    m_timers[timer.previous].next = timer.next;
+  }
+  else
+  {
+    m_listHead[timer.list] = timer.next;
+  }
+  if (timer.next != noTimer)
+  {
+    m_timers[timer.next].previous = timer.previous;
+  }
+}
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
@@ -0,0 +1,216 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../timer_wheel.hpp"
+#include <algorithm>
+#include <vector>
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+namespace
+{
+  /**
+   * @brief   Device that records the ticks in which it was processed.
+   * @tparam  wheel_t
+   *          The timer wheel that processes the device.
+   */
+  template <typename wheel_t>
+  class recordingDevice : public baseClass
+  {
+  public:
+    explicit recordingDevice(const wheel_t& wheel) : m_wheel(wheel)
+    {
+    }
+
+    void process() override
+    {
+      processedTicks.push_back(m_wheel.now());
+    }
+
+    std::vector<uint64_t> processedTicks; //!< Time of the wheel in every call of `process()`.
+
+  private:
+    const wheel_t& m_wheel;
+  };
+
+  /**
+   * @brief   Device that cancels a timer of the wheel when it is processed.
+   * @tparam  wheel_t
+   *          The timer wheel that processes the device.
+   */
+  template <typename wheel_t>
+  class cancellingDevice : public baseClass
+  {
+  public:
+    explicit cancellingDevice(wheel_t& wheel) : handle(wheel_t::invalidHandle), processedCount(0), m_wheel(wheel)
+    {
+    }
+
+    void process() override
+    {
+      processedCount++;
+      m_wheel.cancel(handle);
+    }
+
+    typename wheel_t::handle_t handle;         //!< The timer to cancel.
+    int                        processedCount; //!< Number of calls of `process()`.
+
+  private:
+    wheel_t& m_wheel;
+  };
+} // namespace
+
+#if defined(QT_TESTLIB_LIB)
+class testTimerWheel : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testTimerWheelOneShot();
+  void testTimerWheelPeriodicAndCancel();
+  void testTimerWheelCapacity();
+  void testTimerWheelLongDelays();
+  void testTimerWheelBeyondRange();
+};
+#endif
+
+TEST_CASE(testTimerWheel, testTimerWheelOneShot)
+{
+  typedef timerWheel<16, 8, 3> wheel_t;
+  wheel_t                      wheel;
+  recordingDevice<wheel_t>     device(wheel);
+
+  // Delays within level 0, at the level boundaries and in the last level
+  const uint64_t DELAYS[] = {1, 5, 8, 9, 64, 65, 300, 511};
+  for (uint64_t delay : DELAYS)
+  {
+    QVERIFY(wheel.schedule(device, delay) != wheel_t::invalidHandle);
+  }
+  QCOMPARE(static_cast<int>(wheel.activeCount()), 8);
+
+  QCOMPARE(static_cast<int>(wheel.advance(600)), 8);
+  QCOMPARE(static_cast<int>(device.processedTicks.size()), 8);
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    QCOMPARE(device.processedTicks[i], DELAYS[i]);
+  }
+  QCOMPARE(static_cast<int>(wheel.activeCount()), 0);
+  QCOMPARE(wheel.now(), uint64_t(600));
+
+  // A delay of 0 is treated as 1, scheduling is relative to the current time
+  wheel.schedule(device, 0);
+  QCOMPARE(static_cast<int>(wheel.tick()), 1);
+  QCOMPARE(device.processedTicks.back(), uint64_t(601));
+}
+
+TEST_CASE(testTimerWheel, testTimerWheelPeriodicAndCancel)
+{
+  typedef timerWheel<16>    wheel_t;
+  wheel_t                   wheel;
+  recordingDevice<wheel_t>  poller(wheel);
+  recordingDevice<wheel_t>  timeout(wheel);
+  cancellingDevice<wheel_t> acknowledgement(wheel);
+
+  // A periodic poller every 10 ticks and a timeout that is cancelled by the acknowledgement before it expires
+  const wheel_t::handle_t pollHandle    = wheel.schedule(poller, 10, 10);
+  const wheel_t::handle_t timeoutHandle = wheel.schedule(timeout, 50);
+  acknowledgement.handle                = timeoutHandle;
+  wheel.schedule(acknowledgement, 20);
+
+  wheel.advance(100);
+  QCOMPARE(static_cast<int>(poller.processedTicks.size()), 10);
+  QCOMPARE(poller.processedTicks[9], uint64_t(100));
+  QVERIFY(timeout.processedTicks.empty());
+  QCOMPARE(acknowledgement.processedCount, 1);
+  QVERIFY(!wheel.isScheduled(timeoutHandle));
+  QVERIFY(!wheel.cancel(timeoutHandle));
+
+  // A periodic timer stays scheduled until it is cancelled, even from its own process()
+  QVERIFY(wheel.isScheduled(pollHandle));
+  cancellingDevice<wheel_t> selfCancelling(wheel);
+  selfCancelling.handle = wheel.schedule(selfCancelling, 3, 3);
+  wheel.advance(30);
+  QCOMPARE(selfCancelling.processedCount, 1);
+  QVERIFY(wheel.cancel(pollHandle));
+  QCOMPARE(static_cast<int>(wheel.activeCount()), 0);
+
+  // A stale handle does not cancel a newer timer in the same storage
+  const wheel_t::handle_t newHandle = wheel.schedule(timeout, 5);
+  QVERIFY(!wheel.cancel(pollHandle));
+  QVERIFY(!wheel.cancel(wheel_t::invalidHandle));
+  QVERIFY(wheel.isScheduled(newHandle));
+}
+
+TEST_CASE(testTimerWheel, testTimerWheelCapacity)
+{
+  typedef timerWheel<4>    wheel_t;
+  wheel_t                  wheel;
+  recordingDevice<wheel_t> device(wheel);
+
+  QCOMPARE(static_cast<int>(wheel.capacity()), 4);
+  for (int i = 0; i < 4; ++i)
+  {
+    QVERIFY(wheel.schedule(device, 10) != wheel_t::invalidHandle);
+  }
+  QCOMPARE(wheel.schedule(device, 10), wheel_t::invalidHandle);
+
+  // Expired one-shot timers are available again
+  QCOMPARE(static_cast<int>(wheel.advance(10)), 4);
+  QVERIFY(wheel.schedule(device, 10) != wheel_t::invalidHandle);
+}
+
+TEST_CASE(testTimerWheel, testTimerWheelLongDelays)
+{
+  // A small wheel of 512 ticks, so most delays need cascading and many are beyond its range
+  typedef timerWheel<1000, 8, 3>  wheel_t;
+  static wheel_t                  wheel;
+  static recordingDevice<wheel_t> device(wheel);
+  std::vector<uint64_t>           expectedTicks;
+  uint32_t                        random = 1;
+
+  wheel.advance(12345);
+  for (int i = 0; i < 1000; ++i)
+  {
+    random               = random * 1103515245u + 12345u;
+    const uint64_t delay = 1 + (random >> 8) % 5000;
+    expectedTicks.push_back(wheel.now() + delay);
+    wheel.schedule(device, delay);
+  }
+
+  // Every timer expires exactly in its tick, in expiry order
+  QCOMPARE(static_cast<int>(wheel.advance(6000)), 1000);
+  std::sort(expectedTicks.begin(), expectedTicks.end());
+  QVERIFY(device.processedTicks == expectedTicks);
+  QCOMPARE(static_cast<int>(wheel.activeCount()), 0);
+}
+
+TEST_CASE(testTimerWheel, testTimerWheelBeyondRange)
+{
+  // The smallest wheel covers 64 ticks, longer delays and periods wait in the last level until they are in range
+  typedef timerWheel<4, 8, 2> wheel_t;
+  wheel_t                     wheel;
+  recordingDevice<wheel_t>    oneShotDevice(wheel);
+  recordingDevice<wheel_t>    periodicDevice(wheel);
+
+  wheel.advance(5);
+  QVERIFY(wheel.schedule(oneShotDevice, 200) != wheel_t::invalidHandle);
+  QVERIFY(wheel.schedule(periodicDevice, 70, 100) != wheel_t::invalidHandle);
+
+  QCOMPARE(static_cast<int>(wheel.advance(199)), 2);
+  QVERIFY(oneShotDevice.processedTicks.empty());
+  QCOMPARE(static_cast<int>(wheel.tick()), 1);
+  QCOMPARE(static_cast<int>(oneShotDevice.processedTicks.size()), 1);
+  QCOMPARE(oneShotDevice.processedTicks[0], uint64_t(205));
+
+  QCOMPARE(static_cast<int>(wheel.advance(100)), 1);
+  const std::vector<uint64_t> expectedTicks = {75, 175, 275};
+  QVERIFY(periodicDevice.processedTicks == expectedTicks);
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testTimerWheel)
+#include "timer_wheel_test.moc"
+#endif
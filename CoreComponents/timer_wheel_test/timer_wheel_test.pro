@@ -0,0 +1,17 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle release
+
+TEMPLATE = app
+
+SOURCES +=  \
+    timer_wheel_test.cpp \
+
+HEADERS += \
+    ../timer_wheel.hpp \
+    ../global.hpp \
+
+INCLUDEPATH += \
+    .. \
@@ -13,6 +13,7 @@ SOURCES += \
 
 HEADERS += \
     CoreComponents/global.hpp \
+    CoreComponents/timer_wheel.hpp \
     DeviceManagement/GPS/device_gps_generic.hpp \
     DeviceManagement/GPS/device_gps_nmea.hpp \
     DeviceManagement/GPS/device_gps_pmtk.hpp \
@@ -21,8 +22,22 @@ HEADERS += \
     MemoryManagement/linked_list.hpp \
     MemoryManagement/memory_compression.hpp \
     MemoryManagement/memory_pool.hpp \
+    MemoryManagement/memory_span.hpp \
     MemoryManagement/ring_buffer.hpp \
     MemoryManagement/queue.hpp \
+    MemoryManagement/spsc_ring_buffer.hpp \
+    MemoryManagement/mpmc_ring_buffer.hpp \
+    MemoryManagement/mirrored_ring_buffer.hpp \
+    MemoryManagement/wait_point.hpp \
+    MemoryManagement/broadcast_ring_buffer.hpp \
+    MemoryManagement/timestamped_ring_buffer.hpp \
+    MemoryManagement/byte_ring_buffer.hpp \
+    MemoryManagement/record_ring_buffer.hpp \
+    MemoryManagement/shared_memory_ring_buffer.hpp \
+    MemoryManagement/persistent_ring_buffer.hpp \
+    MemoryManagement/lock_policy.hpp \
+    MemoryManagement/work_stealing_deque.hpp \
+    MemoryManagement/sharded_queue.hpp \
     Tools/Testing/test_helper_test/test_helper_test.cpp \
 
 INCLUDEPATH += \
@@ -41,5 +56,19 @@ SUBDIRS += \
     MemoryManagement/memory_compression_test/memory_compression_test.pro \
     MemoryManagement/memory_pool_test/memory_pool_test.pro \
     MemoryManagement/ring_buffer_test/ring_buffer_test.pro \
-    MemoryManagement/queue_test/queue_test.pro
+    MemoryManagement/queue_test/queue_test.pro \
+    MemoryManagement/spsc_ring_buffer_test/spsc_ring_buffer_test.pro \
+    MemoryManagement/mpmc_ring_buffer_test/mpmc_ring_buffer_test.pro \
+    MemoryManagement/memory_benchmark/memory_benchmark.pro \
+    MemoryManagement/mirrored_ring_buffer_test/mirrored_ring_buffer_test.pro \
+    MemoryManagement/wait_point_test/wait_point_test.pro \
+    MemoryManagement/broadcast_ring_buffer_test/broadcast_ring_buffer_test.pro \
+    MemoryManagement/timestamped_ring_buffer_test/timestamped_ring_buffer_test.pro \
+    MemoryManagement/byte_ring_buffer_test/byte_ring_buffer_test.pro \
+    MemoryManagement/record_ring_buffer_test/record_ring_buffer_test.pro \
+    MemoryManagement/shared_memory_ring_buffer_test/shared_memory_ring_buffer_test.pro \
+    MemoryManagement/persistent_ring_buffer_test/persistent_ring_buffer_test.pro \
+    MemoryManagement/work_stealing_deque_test/work_stealing_deque_test.pro \
+    MemoryManagement/sharded_queue_test/sharded_queue_test.pro \
+    CoreComponents/timer_wheel_test/timer_wheel_test.pro
 
@@ -0,0 +1,345 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     broadcast_ring_buffer.hpp
+ * @version  0.1
+ * @brief    Definition of the broadcastRingBuffer class.
+ * @details  The `broadcastRingBuffer` class is a lock-free single-writer/multi-reader ring buffer with statically allocated
+ *           memory, in which every reader receives every element. It replaces one `ringBuffer` per consumer of the same data
+ *           stream with a single buffer, so each element is stored and written only once, however many readers there are.
+ *
+ *           The writer publishes elements by advancing a 64-bit write sequence. Every reader owns a cursor with the sequence
+ *           of the next element it reads, on its own cache line, and elements are never removed by reading. How the writer
+ *           treats a full buffer depends on the overwrite behavior that is passed to the constructor, as for `ringBuffer`:
+ *           - `RINGBUFFER_NO_OVERWRITE`: the writer is gated by the slowest reader. A write fails while the slowest reader
+ *             has not yet read the element that would be overwritten.
+ *           - `RINGBUFFER_ALLOW_OVERWRITE`: the writer never waits. A reader that falls more than the capacity behind skips
+ *             to the oldest element still stored, and the skipped elements are added to the reader's lost count. Copies that
+ *             were overwritten while the reader made them are detected and discarded as well.
+ *
+ *           To use the `broadcastRingBuffer` class, follow these steps:
+ *           -# Instantiate an instance with the desired data type, buffer size in bytes and number of readers as template
+ *              parameters, like this: `broadcastRingBuffer<gpsFix_t, 1024, 3> myBroadcastRingBuffer;`.
+ *           -# Call `write()` only from the writer thread, like this: `myBroadcastRingBuffer.write(myFix);`.
+ *           -# Give every reader thread its own reader index and let it call `read()` with it only,
+ *              like this: `gpsFix_t myFix; myBroadcastRingBuffer.read(1, myFix);`.
+ *           -# Check the return value of `write()` and `read()` to determine whether or not an operation was successful, and
+ *              `getLostCount()` to find out whether a reader missed elements in overwrite mode.
+ *
+ * @note     `T` must be trivially copyable, since in overwrite mode a reader may copy an element while the writer replaces it.
+ *           The number of elements that fit into `bufferSize` must be a power of two, so that positions are derived from the
+ *           sequences with a mask. If it is not, a compile-time error will occur.
+ *           `reset()` is not thread-safe and may only be called while neither side is accessing the buffer.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include "ring_buffer.hpp"
+#include <atomic>
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+  /**
+   * @brief    Class template for a lock-free single-writer/multi-reader broadcast ring buffer with statically allocated memory.
+   * @details  The `bufferSize` specifies the size of the element storage in bytes.
+   *           The class calculates how many elements of type `T` can fit into the buffer.
+   * @tparam   T
+   *           Data type of the elements in the ring buffer.
+   * @tparam   bufferSize
+   *           The size of the element storage in bytes.
+   * @tparam   readerCount
+   *           The number of readers, each of which receives every element.
+   */
+  template <typename T, std::size_t bufferSize, std::size_t readerCount>
+  class broadcastRingBuffer
+  {
+  public:
+    /**
+     * @brief      Constructor that initializes an empty ring buffer.
+     * @param[in]  overwrite
+     *             `RINGBUFFER_NO_OVERWRITE` to gate the writer on the slowest reader (default), `RINGBUFFER_ALLOW_OVERWRITE` to
+     *             let the writer overwrite elements that slow readers have not read yet.
+     */
+    explicit broadcastRingBuffer(MEM::ringBufferOverwrite_e overwrite = MEM::RINGBUFFER_NO_OVERWRITE);
+
+    // Rule of Five
+    broadcastRingBuffer(const broadcastRingBuffer&)            = delete;
+    broadcastRingBuffer& operator=(const broadcastRingBuffer&) = delete;
+    broadcastRingBuffer(broadcastRingBuffer&&)                 = delete;
+    broadcastRingBuffer& operator=(broadcastRingBuffer&&)      = delete;
+    ~broadcastRingBuffer()                                     = default;
+
+    /**
+     * @brief  Reset the ring buffer to its initial, empty state and clear the lost counts of all readers.
+     * @note   Not thread-safe, neither the writer nor any reader may access the buffer during the reset.
+     */
+    void reset();
+
+    /**
+     * @brief   Get the overwrite behavior the buffer was constructed with.
+     * @return  The overwrite behavior.
+     */
+    MEM::ringBufferOverwrite_e getOverwriteBehavior() const;
+
+    /**
+     * @brief   Get the maximum number of elements that can be stored in the ring buffer.
+     * @return  The capacity of the ring buffer.
+     */
+    constexpr std::size_t capacity() const;
+
+    /**
+     * @brief   Check if a write would fail because the slowest reader has not caught up, may only be called by the writer.
+     * @return  `true` if the buffer is full, always `false` in overwrite mode.
+     */
+    bool isFull() const;
+
+    /**
+     * @brief      Write a single element to the ring buffer, may only be called by the writer.
+     * @param[in]  data
+     *             The element to be written to the buffer.
+     * @return     `true` if the data was written successfully, `false` if the buffer is full and overwriting is not allowed.
+     */
+    bool write(const T& data);
+
+    /**
+     * @brief       Read the next element for a reader, may only be called by the thread owning that reader index.
+     * @param[in]   readerIndex
+     *              The zero-based index of the reader, smaller than `readerCount`.
+     * @param[out]  data
+     *              The variable to store the read element.
+     * @return      `true` if an element was read, `false` if the reader has read all elements or the index is out of range.
+     */
+    bool read(std::size_t readerIndex, T& data);
+
+    /**
+     * @brief      Get the number of elements a reader has not read yet.
+     * @param[in]  readerIndex
+     *             The zero-based index of the reader.
+     * @return     The number of unread elements, at most the capacity, 0 if the index is out of range.
+     */
+    std::size_t count(std::size_t readerIndex) const;
+
+    /**
+     * @brief      Get the number of elements a reader missed because they were overwritten before it read them.
+     * @param[in]  readerIndex
+     *             The zero-based index of the reader.
+     * @return     The number of lost elements since construction or the last `reset()`, 0 if the index is out of range.
+     */
+    uint64_t getLostCount(std::size_t readerIndex) const;
+
+  private:
+    static constexpr std::size_t elementCount = bufferSize / sizeof(T); //!< Number of elements that can fit in the buffer.
+    static_assert(elementCount > 0, "Buffer size is too small to hold even one element of type T.");
+    static_assert(isPowerOfTwo(elementCount), "The number of elements that fit in the buffer must be a power of two.");
+    static_assert(readerCount > 0, "The buffer needs at least one reader.");
+    static_assert(std::is_trivially_copyable<T>::value, "Type T must be trivially copyable.");
+    static constexpr uint64_t indexMask = elementCount - 1; //!< Mask to convert a sequence into an array position.
+
+    /**
+     * @brief  The position of a single reader, on its own cache line.
+     */
+    struct alignas(cacheLineSize) readerCursor_t
+    {
+      std::atomic<uint64_t> sequence;  //!< Sequence of the next element to read, owned by the reader.
+      std::atomic<uint64_t> lostCount; //!< Number of elements the reader missed, owned by the reader.
+    };
+
+    const MEM::ringBufferOverwrite_e m_overwriteSetting; //!< Overwrite behavior when the slowest reader is a full buffer behind.
+    alignas(cacheLineSize) std::atomic<uint64_t> m_writeSequence; //!< Sequence of the next element to write, owned by the writer.
+    std::atomic<uint64_t> m_claimSequence;                        //!< Sequence after the element being overwritten, owned by the writer.
+    uint64_t              m_cachedMinimumSequence;                //!< Writer's last observed sequence of the slowest reader.
+    readerCursor_t        m_readers[readerCount];                 //!< The cursors of all readers.
+    alignas(cacheLineSize) T m_dataArray[elementCount];           //!< The statically allocated array used as the ring buffer.
+
+    /**
+     * @brief   Get the sequence of the slowest reader.
+     * @return  The smallest sequence of all reader cursors.
+     */
+    uint64_t minimumReadSequence() const;
+  };
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+namespace MEM
+{
+  template <typename T, std::size_t bufferSize, std::size_t readerCount>
+  broadcastRingBuffer<T, bufferSize, readerCount>::broadcastRingBuffer(MEM::ringBufferOverwrite_e overwrite)
+    : m_overwriteSetting(overwrite), m_writeSequence(0), m_claimSequence(0), m_cachedMinimumSequence(0)
+  {
+    for (std::size_t i = 0; i < readerCount; ++i)
+    {
+      m_readers[i].sequence.store(0, std::memory_order_relaxed);
+      m_readers[i].lostCount.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  template <typename T, std::size_t bufferSize, std::size_t readerCount>
+  void broadcastRingBuffer<T, bufferSize, readerCount>::reset()
+  {
+    m_writeSequence.store(0, std::memory_order_relaxed);
+    m_claimSequence.store(0, std::memory_order_relaxed);
+    m_cachedMinimumSequence = 0;
+    for (std::size_t i = 0; i < readerCount; ++i)
+    {
+      m_readers[i].sequence.store(0, std::memory_order_relaxed);
+      m_readers[i].lostCount.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  template <typename T, std::size_t bufferSize, std::size_t readerCount>
+  MEM::ringBufferOverwrite_e broadcastRingBuffer<T, bufferSize, readerCount>::getOverwriteBehavior() const
+  {
+    return m_overwriteSetting;
+  }
+
+  template <typename T, std::size_t bufferSize, std::size_t readerCount>
+  constexpr std::size_t broadcastRingBuffer<T, bufferSize, readerCount>::capacity() const
+  {
+    return elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize, std::size_t readerCount>
+  bool broadcastRingBuffer<T, bufferSize, readerCount>::isFull() const
+  {
+    if (m_overwriteSetting == MEM::RINGBUFFER_ALLOW_OVERWRITE)
+    {
+      return false;
+    }
+    return (m_writeSequence.load(std::memory_order_relaxed) - minimumReadSequence()) >= elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize, std::size_t readerCount>
+  bool broadcastRingBuffer<T, bufferSize, readerCount>::write(const T& data)
+  {
+    const uint64_t sequence = m_writeSequence.load(std::memory_order_relaxed);
+
+    if (m_overwriteSetting == MEM::RINGBUFFER_NO_OVERWRITE)
+    {
+      if ((sequence - m_cachedMinimumSequence) >= elementCount)
+      {
+        // Only scan the reader cursors when the cached view is insufficient
+        m_cachedMinimumSequence = minimumReadSequence();
+        if ((sequence - m_cachedMinimumSequence) >= elementCount)
+        {
+          return false;
+        }
+      }
+    }
+    else
+    {
+      // Announce the element being overwritten before touching it, so readers can detect a torn copy
+      m_claimSequence.store(sequence + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    m_dataArray[sequence & indexMask] = data;
+    m_writeSequence.store(sequence + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize, std::size_t readerCount>
+  bool broadcastRingBuffer<T, bufferSize, readerCount>::read(std::size_t readerIndex, T& data)
+  {
+    if (readerIndex >= readerCount)
+    {
+      return false;
+    }
+
+    readerCursor_t& reader    = m_readers[readerIndex];
+    uint64_t        sequence  = reader.sequence.load(std::memory_order_relaxed);
+    uint64_t        lostCount = 0;
+    bool            itemRead  = false;
+
+    while (!itemRead)
+    {
+      const uint64_t writeSequence = m_writeSequence.load(std::memory_order_acquire);
+      if (sequence == writeSequence)
+      {
+        break;
+      }
+
+      if (m_overwriteSetting == MEM::RINGBUFFER_NO_OVERWRITE)
+      {
+        data     = m_dataArray[sequence & indexMask];
+        itemRead = true;
+      }
+      else
+      {
+        if ((writeSequence - sequence) > elementCount)
+        {
+          // The reader fell behind, skip to the oldest element still stored
+          lostCount += writeSequence - elementCount - sequence;
+          sequence = writeSequence - elementCount;
+        }
+
+        data = m_dataArray[sequence & indexMask];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        itemRead = (m_claimSequence.load(std::memory_order_relaxed) - sequence) <= elementCount;
+        if (!itemRead)
+        {
+          // Overwritten during the copy, discard it and continue with the newer elements
+          ++lostCount;
+        }
+      }
+      ++sequence;
+    }
+
+    if (lostCount > 0)
+    {
+      reader.lostCount.store(reader.lostCount.load(std::memory_order_relaxed) + lostCount, std::memory_order_relaxed);
+    }
+    // Releases the slot to the writer only after the copy is complete
+    reader.sequence.store(sequence, std::memory_order_release);
+    return itemRead;
+  }
+
+  template <typename T, std::size_t bufferSize, std::size_t readerCount>
+  std::size_t broadcastRingBuffer<T, bufferSize, readerCount>::count(std::size_t readerIndex) const
+  {
+    if (readerIndex >= readerCount)
+    {
+      return 0;
+    }
+
+    const uint64_t writeSequence = m_writeSequence.load(std::memory_order_acquire);
+    const uint64_t unread        = writeSequence - m_readers[readerIndex].sequence.load(std::memory_order_acquire);
+    return (unread < elementCount) ? static_cast<std::size_t>(unread) : elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize, std::size_t readerCount>
+  uint64_t broadcastRingBuffer<T, bufferSize, readerCount>::getLostCount(std::size_t readerIndex) const
+  {
+    if (readerIndex >= readerCount)
+    {
+      return 0;
+    }
+    return m_readers[readerIndex].lostCount.load(std::memory_order_relaxed);
+  }
+
+  template <typename T, std::size_t bufferSize, std::size_t readerCount>
+  uint64_t broadcastRingBuffer<T, bufferSize, readerCount>::minimumReadSequence() const
+  {
+    uint64_t minimum = m_readers[0].sequence.load(std::memory_order_acquire);
+    for (std::size_t i = 1; i < readerCount; ++i)
+    {
+      const uint64_t sequence = m_readers[i].sequence.load(std::memory_order_acquire);
+      minimum                 = (sequence < minimum) ? sequence : minimum;
+    }
+    return minimum;
+  }
+
+} // namespace MEM
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
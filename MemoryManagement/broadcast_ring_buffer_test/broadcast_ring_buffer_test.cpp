@@ -0,0 +1,187 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../broadcast_ring_buffer.hpp"
+#include <thread>
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class testBroadcastRingBuffer : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testBroadcastRingBufferEveryReaderReceivesAll();
+  void testBroadcastRingBufferGateOnSlowestReader();
+  void testBroadcastRingBufferOverwriteLagDetection();
+  void testBroadcastRingBufferInvalidReader();
+  void testBroadcastRingBufferReset();
+  void testBroadcastRingBufferConcurrentReaders();
+};
+#endif
+
+TEST_CASE(testBroadcastRingBuffer, testBroadcastRingBufferEveryReaderReceivesAll)
+{
+  MEM::broadcastRingBuffer<int, 4 * sizeof(int), 3> myBroadcastRingBuffer;
+  int                                               value;
+
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.capacity()), 4);
+  QVERIFY(myBroadcastRingBuffer.write(1));
+  QVERIFY(myBroadcastRingBuffer.write(2));
+
+  // Readers progress independently of each other
+  for (std::size_t reader = 0; reader < 3; ++reader)
+  {
+    QCOMPARE(static_cast<int>(myBroadcastRingBuffer.count(reader)), 2);
+    QVERIFY(myBroadcastRingBuffer.read(reader, value));
+    QCOMPARE(value, 1);
+  }
+  QVERIFY(myBroadcastRingBuffer.read(0, value));
+  QCOMPARE(value, 2);
+  QVERIFY(!myBroadcastRingBuffer.read(0, value));
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.count(0)), 0);
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.count(1)), 1);
+}
+
+TEST_CASE(testBroadcastRingBuffer, testBroadcastRingBufferGateOnSlowestReader)
+{
+  MEM::broadcastRingBuffer<int, 4 * sizeof(int), 2> myBroadcastRingBuffer;
+  int                                               value;
+
+  for (int i = 0; i < 4; ++i)
+  {
+    QVERIFY(myBroadcastRingBuffer.write(i));
+  }
+
+  // Reader 0 has read everything, but reader 1 still holds the oldest element
+  while (myBroadcastRingBuffer.read(0, value))
+  {
+  }
+  QVERIFY(myBroadcastRingBuffer.isFull());
+  QVERIFY(!myBroadcastRingBuffer.write(4));
+
+  QVERIFY(myBroadcastRingBuffer.read(1, value));
+  QCOMPARE(value, 0);
+  QVERIFY(!myBroadcastRingBuffer.isFull());
+  QVERIFY(myBroadcastRingBuffer.write(4));
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.getLostCount(1)), 0);
+}
+
+TEST_CASE(testBroadcastRingBuffer, testBroadcastRingBufferOverwriteLagDetection)
+{
+  MEM::broadcastRingBuffer<int, 4 * sizeof(int), 2> myBroadcastRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+  int                                               value;
+
+  QVERIFY(myBroadcastRingBuffer.write(0));
+  QVERIFY(myBroadcastRingBuffer.read(0, value));
+
+  // The writer never waits, reader 0 keeps up while reader 1 falls six elements behind
+  for (int i = 1; i < 7; ++i)
+  {
+    QVERIFY(!myBroadcastRingBuffer.isFull());
+    QVERIFY(myBroadcastRingBuffer.write(i));
+    QVERIFY(myBroadcastRingBuffer.read(0, value));
+    QCOMPARE(value, i);
+  }
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.count(1)), 4);
+
+  // Reader 1 skips to the oldest stored element and reports what it missed
+  QVERIFY(myBroadcastRingBuffer.read(1, value));
+  QCOMPARE(value, 3);
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.getLostCount(1)), 3);
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.getLostCount(0)), 0);
+  for (int i = 4; i < 7; ++i)
+  {
+    QVERIFY(myBroadcastRingBuffer.read(1, value));
+    QCOMPARE(value, i);
+  }
+  QVERIFY(!myBroadcastRingBuffer.read(1, value));
+}
+
+TEST_CASE(testBroadcastRingBuffer, testBroadcastRingBufferInvalidReader)
+{
+  MEM::broadcastRingBuffer<int, 4 * sizeof(int), 2> myBroadcastRingBuffer;
+  int                                               value;
+
+  QVERIFY(myBroadcastRingBuffer.write(1));
+  QVERIFY(!myBroadcastRingBuffer.read(2, value));
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.count(2)), 0);
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.getLostCount(2)), 0);
+}
+
+TEST_CASE(testBroadcastRingBuffer, testBroadcastRingBufferReset)
+{
+  MEM::broadcastRingBuffer<int, 2 * sizeof(int), 1> myBroadcastRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+  int                                               value;
+
+  for (int i = 0; i < 5; ++i)
+  {
+    QVERIFY(myBroadcastRingBuffer.write(i));
+  }
+  QVERIFY(myBroadcastRingBuffer.read(0, value));
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.getLostCount(0)), 3);
+
+  myBroadcastRingBuffer.reset();
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.count(0)), 0);
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.getLostCount(0)), 0);
+  QCOMPARE(myBroadcastRingBuffer.getOverwriteBehavior(), MEM::RINGBUFFER_ALLOW_OVERWRITE);
+}
+
+TEST_CASE(testBroadcastRingBuffer, testBroadcastRingBufferConcurrentReaders)
+{
+  static MEM::broadcastRingBuffer<uint32_t, 32 * sizeof(uint32_t), 3> myBroadcastRingBuffer;
+  const uint32_t                                                       ELEMENT_COUNT = 50000;
+  bool                                                                 inOrder[3]    = { true, true, true };
+
+  // Every reader verifies that it receives every element exactly once and in order
+  std::thread readers[3];
+  for (std::size_t reader = 0; reader < 3; ++reader)
+  {
+    readers[reader] = std::thread(
+      [&, reader]()
+      {
+        uint32_t expected = 0;
+        uint32_t value;
+        while (expected < ELEMENT_COUNT)
+        {
+          if (myBroadcastRingBuffer.read(reader, value))
+          {
+            inOrder[reader] = inOrder[reader] && (value == expected);
+            ++expected;
+          }
+          else
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+
+  for (uint32_t next = 0; next < ELEMENT_COUNT;)
+  {
+    if (myBroadcastRingBuffer.write(next))
+    {
+      ++next;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+  for (std::size_t reader = 0; reader < 3; ++reader)
+  {
+    readers[reader].join();
+  }
+
+  QVERIFY(inOrder[0] && inOrder[1] && inOrder[2]);
+  QCOMPARE(static_cast<int>(myBroadcastRingBuffer.count(0)), 0);
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testBroadcastRingBuffer)
+#include "broadcast_ring_buffer_test.moc"
+#endif
@@ -0,0 +1,228 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     byte_ring_buffer.hpp
+ * @version  0.1
+ * @brief    Definition of the byteRingBuffer class.
+ * @details  The `byteRingBuffer` class is a `ringBuffer` of bytes for byte streams such as UART data, extended with functions
+ *           to find a delimiter and to take a whole frame up to it, instead of reading and checking one byte at a time.
+ *
+ *           The stored bytes are scanned as (at most two) contiguous segments with a memchr-style kernel. The kernel is
+ *           selected at compile time: AVX2 compares 32 bytes per step, SSE2 and NEON compare 16 bytes per step, and on all
+ *           other targets (e.g. Cortex-M) `std::memchr()` of the C library is used. Frames are handed back as spans inside
+ *           the buffer, so they can be parsed without copying and freed with `readRelease()` afterwards.
+ *
+ *           To use the `byteRingBuffer` class, follow these steps:
+ *           -# Instantiate an instance with the desired buffer size in bytes as template parameter,
+ *              like this: `byteRingBuffer<256> myByteRingBuffer;`.
+ *           -# Use the `write()` functions of `ringBuffer` to add the received bytes.
+ *           -# Use the `readUntil()` function to obtain the next complete frame, like this:
+ *              `memorySpanPair<const uint8_t> myFrame = myByteRingBuffer.readUntil('\n');`.
+ *           -# Process the frame and free it with `readRelease()`, like this: `myByteRingBuffer.readRelease(myFrame.size());`.
+ *              Alternatively, let `readUntil()` copy the frame into an array and free it in one step.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include "memory_span.hpp"
+#include "ring_buffer.hpp"
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+  /**
+   * @brief      Find the first occurrence of a byte in a contiguous memory range.
+   * @details    Vectorized with AVX2, SSE2 or NEON where available, `std::memchr()` otherwise.
+   * @param[in]  data
+   *             Pointer to the first byte of the range, may be `nullptr` if `size` is 0.
+   * @param[in]  size
+   *             The number of bytes in the range.
+   * @param[in]  value
+   *             The byte to search for.
+   * @return     The zero-based position of the first occurrence, or `size` if the byte does not occur.
+   */
+  std::size_t findByteInRange(const uint8_t* data, std::size_t size, uint8_t value);
+
+  /**
+   * @brief    Class template for a ring buffer of bytes with statically allocated memory and delimiter scanning.
+   * @details  Provides all functions of `ringBuffer<uint8_t, bufferSize>`.
+   * @tparam   bufferSize
+   *           The size of the buffer in bytes.
+   */
+  template <std::size_t bufferSize>
+  class byteRingBuffer : public ringBuffer<uint8_t, bufferSize>
+  {
+  public:
+    /**
+     * @brief      Constructor that initializes the ring buffer.
+     * @param[in]  overwrite
+     *             Specifies whether to overwrite the oldest byte in the buffer when it is full.
+     *             Default is `RINGBUFFER_NO_OVERWRITE`.
+     */
+    explicit byteRingBuffer(MEM::ringBufferOverwrite_e overwrite = MEM::RINGBUFFER_NO_OVERWRITE);
+
+    /**
+     * @brief       Find the first occurrence of a byte in the ring buffer.
+     * @param[in]   value
+     *              The byte to search for.
+     * @param[out]  offset
+     *              The zero-based index of the byte relative to the oldest byte, only valid if the byte was found.
+     * @param[in]   startOffset
+     *              The zero-based index of the first byte to search, relative to the oldest byte. Default is 0.
+     * @return      `true` if the byte was found, `false` otherwise.
+     */
+    bool findByte(uint8_t value, std::size_t& offset, std::size_t startOffset = 0) const;
+
+    /**
+     * @brief      Acquire the next frame, from the oldest byte up to and including a delimiter, without copying.
+     * @details    The frame stays in the buffer until it is freed with `readRelease(frame.size())`.
+     * @param[in]  delimiter
+     *             The byte that terminates the frame.
+     * @return     The frame as spans inside the buffer, both empty if the buffer does not contain the delimiter.
+     */
+    MEM::memorySpanPair<const uint8_t> readUntil(uint8_t delimiter) const;
+
+    /**
+     * @brief       Read the next frame, from the oldest byte up to and including a delimiter, into an array.
+     * @param[in]   delimiter
+     *              The byte that terminates the frame.
+     * @param[out]  data
+     *              The array to store the frame.
+     * @param[in]   dataCount
+     *              The size of the array.
+     * @return      The number of bytes of the frame, 0 if the buffer does not contain the delimiter or the frame does not fit
+     *              into the array. In both cases the buffer is left unchanged.
+     */
+    std::size_t readUntil(uint8_t delimiter, uint8_t data[], std::size_t dataCount);
+  };
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+namespace MEM
+{
+  inline std::size_t findByteInRange(const uint8_t* data, std::size_t size, uint8_t value)
+  {
+    std::size_t position = 0;
+
+#if defined(__AVX2__)
+    const __m256i pattern = _mm256_set1_epi8(static_cast<char>(value));
+    for (; position + 32 <= size; position += 32)
+    {
+      const __m256i  block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position));
+      const uint32_t mask  = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+      if (mask != 0)
+      {
+        return position + static_cast<std::size_t>(__builtin_ctz(mask));
+      }
+    }
+#elif defined(__SSE2__)
+    const __m128i pattern = _mm_set1_epi8(static_cast<char>(value));
+    for (; position + 16 <= size; position += 16)
+    {
+      const __m128i  block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+      const uint32_t mask  = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+      if (mask != 0)
+      {
+        return position + static_cast<std::size_t>(__builtin_ctz(mask));
+      }
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t pattern = vdupq_n_u8(value);
+    for (; position + 16 <= size; position += 16)
+    {
+      const uint8x16_t matches = vceqq_u8(vld1q_u8(data + position), pattern);
+      const uint8x8_t  folded  = vorr_u8(vget_low_u8(matches), vget_high_u8(matches));
+      if (vget_lane_u64(vreinterpret_u64_u8(folded), 0) != 0)
+      {
+        // Only the block with a match is scanned byte by byte
+        while (data[position] != value)
+        {
+          ++position;
+        }
+        return position;
+      }
+    }
+#endif
+
+    // Remaining bytes after the vector blocks, or the whole range without vector support
+    if (position < size)
+    {
+      const void* match = std::memchr(data + position, value, size - position);
+      if (match != nullptr)
+      {
+        return static_cast<std::size_t>(static_cast<const uint8_t*>(match) - data);
+      }
+    }
+    return size;
+  }
+
+  template <std::size_t bufferSize>
+  byteRingBuffer<bufferSize>::byteRingBuffer(MEM::ringBufferOverwrite_e overwrite) : ringBuffer<uint8_t, bufferSize>(overwrite)
+  {
+  }
+
+  template <std::size_t bufferSize>
+  bool byteRingBuffer<bufferSize>::findByte(uint8_t value, std::size_t& offset, std::size_t startOffset) const
+  {
+    const MEM::memorySpanPair<const uint8_t> stored = this->readAcquire();
+    const MEM::memorySpanPair<const uint8_t> spans  = stored.subRange(startOffset, stored.size());
+
+    std::size_t position = findByteInRange(spans.first.data, spans.first.size, value);
+    if (position == spans.first.size)
+    {
+      position += findByteInRange(spans.second.data, spans.second.size, value);
+    }
+
+    if (position == spans.size())
+    {
+      return false;
+    }
+    offset = startOffset + position;
+    return true;
+  }
+
+  template <std::size_t bufferSize>
+  MEM::memorySpanPair<const uint8_t> byteRingBuffer<bufferSize>::readUntil(uint8_t delimiter) const
+  {
+    std::size_t offset;
+    if (!findByte(delimiter, offset))
+    {
+      return MEM::memorySpanPair<const uint8_t>{};
+    }
+    return this->readAcquire().subRange(0, offset + 1);
+  }
+
+  template <std::size_t bufferSize>
+  std::size_t byteRingBuffer<bufferSize>::readUntil(uint8_t delimiter, uint8_t data[], std::size_t dataCount)
+  {
+    const MEM::memorySpanPair<const uint8_t> frame = readUntil(delimiter);
+    if (frame.size() == 0 || frame.size() > dataCount)
+    {
+      return 0;
+    }
+    return this->read(data, frame.size());
+  }
+
+} // namespace MEM
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
@@ -0,0 +1,146 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../byte_ring_buffer.hpp"
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class testByteRingBuffer : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testFindByteInRange();
+  void testByteRingBufferFindByte();
+  void testByteRingBufferFindByteAcrossWrap();
+  void testByteRingBufferReadUntilSpans();
+  void testByteRingBufferReadUntilArray();
+};
+#endif
+
+namespace
+{
+  /**
+   * @brief          Write a string to a byte ring buffer, without the terminating zero.
+   * @param[in,out]  buffer
+   *                 The ring buffer to write to.
+   * @param[in]      text
+   *                 The string to write.
+   * @return         The number of bytes written.
+   */
+  template <typename buffer_t>
+  std::size_t writeText(buffer_t& buffer, const char* text)
+  {
+    return buffer.write(reinterpret_cast<const uint8_t*>(text), std::strlen(text));
+  }
+} // namespace
+
+TEST_CASE(testByteRingBuffer, testFindByteInRange)
+{
+  uint8_t data[100] = {};
+
+  QCOMPARE(static_cast<int>(MEM::findByteInRange(nullptr, 0, '\n')), 0);
+  QCOMPARE(static_cast<int>(MEM::findByteInRange(data, 100, '\n')), 100);
+
+  // Every position, so each vector block and the scalar tail are covered
+  for (int position = 0; position < 100; ++position)
+  {
+    data[position] = '\n';
+    QCOMPARE(static_cast<int>(MEM::findByteInRange(data, 100, '\n')), position);
+    QCOMPARE(static_cast<int>(MEM::findByteInRange(data, static_cast<std::size_t>(position), '\n')), position);
+    data[position] = 0;
+  }
+
+  // The first of several occurrences is found, also for bytes with the highest bit set
+  data[70] = 0xFF;
+  data[40] = 0xFF;
+  QCOMPARE(static_cast<int>(MEM::findByteInRange(data, 100, 0xFF)), 40);
+}
+
+TEST_CASE(testByteRingBuffer, testByteRingBufferFindByte)
+{
+  MEM::byteRingBuffer<64> myByteRingBuffer;
+  std::size_t             offset = 0;
+
+  QVERIFY(!myByteRingBuffer.findByte('*', offset));
+  QCOMPARE(static_cast<int>(writeText(myByteRingBuffer, "$GPGGA,1*4F\r\n$GPRMC")), 19);
+
+  QVERIFY(myByteRingBuffer.findByte('*', offset));
+  QCOMPARE(static_cast<int>(offset), 8);
+  QVERIFY(myByteRingBuffer.findByte('$', offset, 1));
+  QCOMPARE(static_cast<int>(offset), 13);
+  QVERIFY(!myByteRingBuffer.findByte('*', offset, 9));
+  QVERIFY(!myByteRingBuffer.findByte('$', offset, 100));
+}
+
+TEST_CASE(testByteRingBuffer, testByteRingBufferFindByteAcrossWrap)
+{
+  MEM::byteRingBuffer<40> myByteRingBuffer;
+  uint8_t                 scratch[40];
+  std::size_t             offset = 0;
+
+  // Move the read position close to the end, so the stored bytes wrap around
+  QCOMPARE(static_cast<int>(writeText(myByteRingBuffer, "0123456789012345678901234567890123")), 34);
+  QCOMPARE(static_cast<int>(myByteRingBuffer.read(scratch, 34)), 34);
+  QCOMPARE(static_cast<int>(writeText(myByteRingBuffer, "abcdefghijklmnopqrstuvwxyz\n")), 27);
+  QVERIFY(myByteRingBuffer.readAcquire().second.size > 0);
+
+  QVERIFY(myByteRingBuffer.findByte('c', offset));
+  QCOMPARE(static_cast<int>(offset), 2);
+  QVERIFY(myByteRingBuffer.findByte('\n', offset));
+  QCOMPARE(static_cast<int>(offset), 26);
+  QVERIFY(myByteRingBuffer.findByte('z', offset, 7));
+  QCOMPARE(static_cast<int>(offset), 25);
+}
+
+TEST_CASE(testByteRingBuffer, testByteRingBufferReadUntilSpans)
+{
+  MEM::byteRingBuffer<16> myByteRingBuffer;
+  uint8_t                 scratch[16];
+
+  // The first frame wraps around the end of the storage
+  QCOMPARE(static_cast<int>(writeText(myByteRingBuffer, "0123456789")), 10);
+  QCOMPARE(static_cast<int>(myByteRingBuffer.read(scratch, 10)), 10);
+  QCOMPARE(static_cast<int>(writeText(myByteRingBuffer, "$ABCDEFGH\n$IJ")), 13);
+
+  MEM::memorySpanPair<const uint8_t> frame = myByteRingBuffer.readUntil('\n');
+  QCOMPARE(static_cast<int>(frame.size()), 10);
+  QCOMPARE(static_cast<int>(frame.first.size), 6);
+  QCOMPARE(static_cast<int>(frame.first.data[0]), static_cast<int>('$'));
+  QCOMPARE(static_cast<int>(frame.second.data[3]), static_cast<int>('\n'));
+  QCOMPARE(static_cast<int>(myByteRingBuffer.readRelease(frame.size())), 10);
+
+  // The incomplete frame stays in the buffer
+  frame = myByteRingBuffer.readUntil('\n');
+  QCOMPARE(static_cast<int>(frame.size()), 0);
+  QVERIFY(frame.first.data == nullptr);
+  QCOMPARE(static_cast<int>(myByteRingBuffer.count()), 3);
+}
+
+TEST_CASE(testByteRingBuffer, testByteRingBufferReadUntilArray)
+{
+  MEM::byteRingBuffer<32> myByteRingBuffer;
+  uint8_t                 frame[8];
+
+  QCOMPARE(static_cast<int>(writeText(myByteRingBuffer, "OK\nTOO LONG LINE\nEND")), 20);
+
+  QCOMPARE(static_cast<int>(myByteRingBuffer.readUntil('\n', frame, sizeof(frame))), 3);
+  QVERIFY(std::memcmp(frame, "OK\n", 3) == 0);
+
+  // A frame that does not fit is left in the buffer
+  QCOMPARE(static_cast<int>(myByteRingBuffer.readUntil('\n', frame, sizeof(frame))), 0);
+  QCOMPARE(static_cast<int>(myByteRingBuffer.count()), 17);
+  QCOMPARE(static_cast<int>(myByteRingBuffer.readRelease(14)), 14);
+
+  QCOMPARE(static_cast<int>(myByteRingBuffer.readUntil('\n', frame, sizeof(frame))), 0);
+  QCOMPARE(static_cast<int>(myByteRingBuffer.count()), 3);
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testByteRingBuffer)
+#include "byte_ring_buffer_test.moc"
+#endif
@@ -0,0 +1,166 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     lock_policy.hpp
+ * @version  0.1
+ * @brief    Definition of the lock policies for the containers.
+ * @details  A lock policy selects how a container synchronizes concurrent accesses, as a template parameter instead of a
+ *           fixed `std::mutex` member. All locking policies provide `lock()` and `unlock()`, so they work with
+ *           `std::lock_guard`:
+ *           - `noLock`: No synchronization at all. The calls are empty and optimized away, for containers that are only used
+ *             by a single thread.
+ *           - `spinLock`: Busy-waits on an atomic flag, without any system call. Suited for very short critical sections
+ *             on multi-core systems.
+ *           - `mutexLock`: A `std::mutex`, which puts waiting threads to sleep. The default.
+ *
+ *           The tags `lockFreeSpsc` and `lockFreeMpsc` do not lock at all. They select a lock-free algorithm instead, for a
+ *           single producer and a single consumer, or for multiple producers and a single consumer respectively. Only
+ *           containers that provide such an algorithm accept them, like `fifoQueue`.
+ *
+ *           To select a lock policy, pass it as the template parameter of the container, like this:
+ *           `fifoQueue<int, 64, spinLock> myFifoQueue;`.
+ *
+ * @note     `spinLock` must not be taken in an interrupt handler on a single-core system while the interrupted code may hold
+ *           it, since the interrupted code can never release it.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include <atomic>
+#include <mutex>
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+  /**
+   * @brief  Lock policy without any synchronization, for containers used by a single thread only.
+   */
+  class noLock
+  {
+  public:
+    /**
+     * @brief  Does nothing.
+     */
+    void lock();
+
+    /**
+     * @brief  Does nothing.
+     */
+    void unlock();
+  };
+
+  /**
+   * @brief    Lock policy that busy-waits on an atomic flag.
+   * @details  Waiting threads only read the flag while it is taken, so the cache line is not written back and forth.
+   */
+  class spinLock
+  {
+  public:
+    /**
+     * @brief  Constructor that initializes an unlocked spin lock.
+     */
+    spinLock();
+
+    /**
+     * @brief  Take the lock, spinning until it is available.
+     */
+    void lock();
+
+    /**
+     * @brief  Release the lock.
+     */
+    void unlock();
+
+  private:
+    std::atomic<bool> m_locked; //!< `true` while a thread holds the lock.
+  };
+
+  /**
+   * @brief  Lock policy based on `std::mutex`, which puts waiting threads to sleep.
+   */
+  class mutexLock
+  {
+  public:
+    /**
+     * @brief  Take the lock, sleeping until it is available.
+     */
+    void lock();
+
+    /**
+     * @brief  Release the lock.
+     */
+    void unlock();
+
+  private:
+    std::mutex m_mutex; //!< The mutex that is locked.
+  };
+
+  /**
+   * @brief  Tag that selects a lock-free algorithm for a single producer and a single consumer.
+   */
+  struct lockFreeSpsc
+  {
+  };
+
+  /**
+   * @brief  Tag that selects a lock-free algorithm for multiple producers and a single consumer.
+   */
+  struct lockFreeMpsc
+  {
+  };
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+namespace MEM
+{
+  inline void noLock::lock()
+  {
+  }
+
+  inline void noLock::unlock()
+  {
+  }
+
+  inline spinLock::spinLock() : m_locked(false)
+  {
+  }
+
+  inline void spinLock::lock()
+  {
+    while (m_locked.exchange(true, std::memory_order_acquire))
+    {
+      while (m_locked.load(std::memory_order_relaxed))
+      {
+      }
+    }
+  }
+
+  inline void spinLock::unlock()
+  {
+    m_locked.store(false, std::memory_order_release);
+  }
+
+  inline void mutexLock::lock()
+  {
+    m_mutex.lock();
+  }
+
+  inline void mutexLock::unlock()
+  {
+    m_mutex.unlock();
+  }
+
+} // namespace MEM
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
@@ -0,0 +1,662 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../byte_ring_buffer.hpp"
+#include "../queue.hpp"
+#include "../ring_buffer.hpp"
+#include "../sharded_queue.hpp"
+#include "../work_stealing_deque.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class memoryBenchmark : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void benchmarkRingBufferIndexing();
+  void benchmarkQueueIndexing();
+  void benchmarkByteFraming();
+  void benchmarkQueueLockPolicy();
+  void benchmarkQueueDispatch();
+  void benchmarkQueueBatch();
+  void benchmarkPriorityQueue();
+  void benchmarkWorkStealing();
+  void benchmarkShardedQueue();
+};
+#endif
+
+namespace
+{
+  const std::size_t BENCHMARK_ELEMENTS = 1u << 22; //!< Number of elements moved through each container per measurement.
+  const std::size_t BENCHMARK_BURST    = 8;        //!< Number of elements written before they are read back.
+
+  volatile uint32_t benchmarkSink; //!< Keeps the compiler from optimizing the measured work away.
+
+  /**
+   * @brief      Measure the average cost of moving one element through a container.
+   * @param[in]  operation
+   *             Callable that moves `elementCount` elements through the container.
+   * @param[in]  elementCount
+   *             The number of elements the callable moves, `BENCHMARK_ELEMENTS` by default.
+   * @return     The average time per element in picoseconds.
+   */
+  template <typename operation_t>
+  uint64_t picosecondsPerElement(operation_t operation, std::size_t elementCount = BENCHMARK_ELEMENTS)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    operation();
+    const auto stop = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count()) * 1000 / elementCount;
+  }
+
+  /**
+   * @brief   Replica of the ring buffer indexing before the power-of-two specialization, used as the reference.
+   * @tparam  elementCount
+   *          The number of elements the ring buffer can hold.
+   */
+  template <std::size_t elementCount>
+  class moduloReferenceRing
+  {
+  public:
+    bool write(uint32_t data)
+    {
+      if (m_elementsStored == elementCount)
+      {
+        return false;
+      }
+      m_dataArray[m_writeIndex] = data;
+      m_writeIndex              = (m_writeIndex + 1) % elementCount;
+      ++m_elementsStored;
+      return true;
+    }
+
+    bool read(uint32_t& data)
+    {
+      if (m_elementsStored == 0)
+      {
+        return false;
+      }
+      data        = m_dataArray[m_readIndex];
+      m_readIndex = (m_readIndex + 1) % elementCount;
+      --m_elementsStored;
+      return true;
+    }
+
+  private:
+    uint32_t    m_dataArray[elementCount] = {};
+    std::size_t m_readIndex               = 0;
+    std::size_t m_writeIndex              = 0;
+    std::size_t m_elementsStored          = 0;
+  };
+
+  /**
+   * @brief          Move `BENCHMARK_ELEMENTS` elements through a ring buffer in bursts.
+   * @param[in,out]  ring
+   *                 The ring buffer to use, must be able to hold at least `BENCHMARK_BURST` elements.
+   */
+  template <typename ring_t>
+  void transferThroughRing(ring_t& ring)
+  {
+    uint32_t checksum = 0;
+    uint32_t value    = 0;
+    for (std::size_t i = 0; i < BENCHMARK_ELEMENTS; i += BENCHMARK_BURST)
+    {
+      for (std::size_t j = 0; j < BENCHMARK_BURST; ++j)
+      {
+        ring.write(static_cast<uint32_t>(i + j));
+      }
+      for (std::size_t j = 0; j < BENCHMARK_BURST; ++j)
+      {
+        ring.read(value);
+        checksum += value;
+      }
+    }
+    benchmarkSink = checksum;
+  }
+
+  /**
+   * @brief  Replica of the queue interface before the static polymorphism, with virtual `push()` and `pop()`.
+   */
+  class virtualQueueInterface
+  {
+  public:
+    virtual ~virtualQueueInterface() = default;
+    virtual bool push(const uint32_t& item) = 0;
+    virtual bool pop(uint32_t& item)        = 0;
+  };
+
+  /**
+   * @brief   Unlocked queue behind the virtual interface, used as the reference.
+   * @tparam  queue_t
+   *          The queue that stores the elements.
+   */
+  template <typename queue_t>
+  class virtualReferenceQueue : public virtualQueueInterface
+  {
+  public:
+    bool push(const uint32_t& item) override
+    {
+      return m_queue.push(item);
+    }
+
+    bool pop(uint32_t& item) override
+    {
+      return m_queue.pop(item);
+    }
+
+  private:
+    queue_t m_queue;
+  };
+
+  /**
+   * @brief          Move `BENCHMARK_ELEMENTS` elements through a queue in bursts.
+   * @param[in,out]  queue
+   *                 The queue to use, must be able to hold at least `BENCHMARK_BURST` elements.
+   */
+  template <typename queue_t>
+  void transferThroughQueue(queue_t& queue)
+  {
+    uint32_t checksum = 0;
+    uint32_t value    = 0;
+    for (std::size_t i = 0; i < BENCHMARK_ELEMENTS; i += BENCHMARK_BURST)
+    {
+      for (std::size_t j = 0; j < BENCHMARK_BURST; ++j)
+      {
+        queue.push(static_cast<uint32_t>(i + j));
+      }
+      for (std::size_t j = 0; j < BENCHMARK_BURST; ++j)
+      {
+        queue.pop(value);
+        checksum += value;
+      }
+    }
+    benchmarkSink = checksum;
+  }
+
+  /**
+   * @brief   Replica of scheduling with a hand-sorted array, used as the reference for the priority queue.
+   * @details The array is kept sorted in descending order, so the smallest element is popped from the end and every push
+   *          shifts the larger elements up by one position.
+   * @tparam  elementCount
+   *          The number of elements the array can hold.
+   */
+  template <std::size_t elementCount>
+  class sortedArrayReference
+  {
+  public:
+    bool push(uint32_t data)
+    {
+      if (m_elementsStored == elementCount)
+      {
+        return false;
+      }
+      std::size_t position = m_elementsStored;
+      while (position > 0 && m_dataArray[position - 1] < data)
+      {
+        m_dataArray[position] = m_dataArray[position - 1];
+        --position;
+      }
+      m_dataArray[position] = data;
+      ++m_elementsStored;
+      return true;
+    }
+
+    bool pop(uint32_t& data)
+    {
+      if (m_elementsStored == 0)
+      {
+        return false;
+      }
+      data = m_dataArray[--m_elementsStored];
+      return true;
+    }
+
+  private:
+    uint32_t    m_dataArray[elementCount] = {};
+    std::size_t m_elementsStored          = 0;
+  };
+
+  /**
+   * @brief          Schedule `BENCHMARK_ELEMENTS` commands through a priority queue that holds `backlog` of them.
+   * @details        Each step pops the command with the earliest deadline and schedules a new one at a pseudo-random delay
+   *                 after it, like a scheduler whose time advances to the next due command.
+   * @param[in,out]  queue
+   *                 The priority queue to use, must be able to hold at least `backlog` elements.
+   * @param[in]      backlog
+   *                 The number of commands that stay queued.
+   */
+  template <typename queue_t>
+  void scheduleThroughQueue(queue_t& queue, std::size_t backlog)
+  {
+    uint32_t checksum = 0;
+    uint32_t random   = 1;
+    uint32_t now      = 0;
+    for (std::size_t i = 0; i < backlog; ++i)
+    {
+      random = random * 1664525u + 1013904223u;
+      queue.push(random >> 12);
+    }
+    for (std::size_t i = 0; i < BENCHMARK_ELEMENTS; ++i)
+    {
+      queue.pop(now);
+      checksum += now;
+      random = random * 1664525u + 1013904223u;
+      queue.push(now + (random >> 12));
+    }
+    while (queue.pop(now))
+    {
+      checksum += now;
+    }
+    benchmarkSink = checksum;
+  }
+
+  /**
+   * @brief      Simulated task of a few dozen nanoseconds, like parsing a short message.
+   * @param[in]  task
+   *             The index of the task.
+   * @return     A checksum of the work done.
+   */
+  uint32_t runTask(uint32_t task)
+  {
+    uint32_t state = task | 1u;
+    for (int i = 0; i < 64; ++i)
+    {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+    }
+    return state;
+  }
+
+  /**
+   * @brief          Execute `taskCount` tasks with `workerCount` threads: the first worker creates all tasks in its deque and
+   *                 executes them from the bottom, all other workers steal them from the top.
+   * @param[in,out]  deque
+   *                 The deque of the first worker.
+   * @param[in]      workerCount
+   *                 The number of worker threads, including the first one.
+   * @param[in]      taskCount
+   *                 The number of tasks to execute.
+   */
+  template <typename deque_t>
+  void executeWithStealing(deque_t& deque, std::size_t workerCount, std::size_t taskCount)
+  {
+    std::atomic<bool>        ownerDone(false);
+    std::atomic<uint32_t>    checksum(0);
+    std::vector<std::thread> thieves;
+
+    for (std::size_t i = 1; i < workerCount; ++i)
+    {
+      thieves.emplace_back([&]() {
+        uint32_t localChecksum = 0;
+        uint32_t task;
+        while (!ownerDone.load(std::memory_order_acquire) || !deque.isEmpty())
+        {
+          if (deque.steal(task))
+          {
+            localChecksum += runTask(task);
+          }
+        }
+        checksum.fetch_add(localChecksum);
+      });
+    }
+
+    uint32_t localChecksum = 0;
+    uint32_t task;
+    for (uint32_t next = 0; next < taskCount; ++next)
+    {
+      // When the deque is full the owner works on the newest task itself
+      while (!deque.push(next))
+      {
+        if (deque.pop(task))
+        {
+          localChecksum += runTask(task);
+        }
+      }
+    }
+    while (deque.pop(task))
+    {
+      localChecksum += runTask(task);
+    }
+    ownerDone.store(true, std::memory_order_release);
+
+    for (auto& thief : thieves)
+    {
+      thief.join();
+    }
+    benchmarkSink = checksum.load() + localChecksum;
+  }
+
+  /**
+   * @brief      Move elements from several producer threads to the calling thread, which consumes them in batches.
+   * @param[in]  producerCount
+   *             The number of producer threads.
+   * @param[in]  elementCount
+   *             The total number of elements, split evenly among the producers.
+   * @param[in]  produce
+   *             Callable that pushes the given number of elements, run once in every producer thread.
+   * @param[in]  consume
+   *             Callable that pops up to the given number of elements into the given array and returns how many it popped.
+   */
+  template <typename produce_t, typename consume_t>
+  void transferFromProducers(std::size_t producerCount, std::size_t elementCount, produce_t produce, consume_t consume)
+  {
+    const std::size_t        producerElements = elementCount / producerCount;
+    std::vector<std::thread> producers;
+
+    for (std::size_t i = 0; i < producerCount; ++i)
+    {
+      producers.emplace_back([&]() { produce(producerElements); });
+    }
+
+    uint32_t    checksum = 0;
+    uint32_t    values[64];
+    std::size_t received = 0;
+    while (received < producerElements * producerCount)
+    {
+      const std::size_t count = consume(values, 64);
+      if (count == 0)
+      {
+        std::this_thread::yield();
+      }
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        checksum += values[i];
+      }
+      received += count;
+    }
+
+    for (auto& producer : producers)
+    {
+      producer.join();
+    }
+    benchmarkSink = checksum;
+  }
+
+  /**
+   * @brief          Move `BENCHMARK_ELEMENTS` elements through a queue in batches of `batchSize`, one element at a time or
+   *                 with one `pushN()` and `popN()` per batch.
+   * @tparam         batchSize
+   *                 The number of elements written before they are read back.
+   * @param[in,out]  queue
+   *                 The queue to use, must be able to hold at least `batchSize` elements.
+   * @param[in]      batched
+   *                 `true` to use `pushN()` and `popN()`, `false` to use `push()` and `pop()`.
+   */
+  template <std::size_t batchSize, typename queue_t>
+  void transferThroughQueueInBatches(queue_t& queue, bool batched)
+  {
+    uint32_t batch[batchSize];
+    uint32_t checksum = 0;
+    for (std::size_t i = 0; i < BENCHMARK_ELEMENTS; i += batchSize)
+    {
+      for (std::size_t j = 0; j < batchSize; ++j)
+      {
+        batch[j] = static_cast<uint32_t>(i + j);
+      }
+      if (batched)
+      {
+        queue.pushN(batch, batchSize);
+        queue.popN(batch, batchSize);
+      }
+      else
+      {
+        for (std::size_t j = 0; j < batchSize; ++j)
+        {
+          queue.push(batch[j]);
+        }
+        for (std::size_t j = 0; j < batchSize; ++j)
+        {
+          queue.pop(batch[j]);
+        }
+      }
+      for (std::size_t j = 0; j < batchSize; ++j)
+      {
+        checksum += batch[j];
+      }
+    }
+    benchmarkSink = checksum;
+  }
+
+  /**
+   * @brief          Split `BENCHMARK_ELEMENTS` bytes of NMEA-like lines into frames by reading one byte at a time.
+   * @param[in,out]  ring
+   *                 The byte ring buffer to use, must be able to hold at least one line.
+   * @param[in]      line
+   *                 The line to feed, terminated by a line feed.
+   * @param[in]      lineLength
+   *                 The number of bytes of the line.
+   */
+  template <typename ring_t>
+  void frameBytewise(ring_t& ring, const uint8_t line[], std::size_t lineLength)
+  {
+    uint32_t frameCount = 0;
+    uint8_t  value      = 0;
+    for (std::size_t i = 0; i < BENCHMARK_ELEMENTS; i += lineLength)
+    {
+      ring.write(line, lineLength);
+      while (ring.read(value))
+      {
+        frameCount += (value == '\n') ? 1 : 0;
+      }
+    }
+    benchmarkSink = frameCount;
+  }
+
+  /**
+   * @brief          Split `BENCHMARK_ELEMENTS` bytes of NMEA-like lines into frames with the delimiter scan.
+   * @param[in,out]  ring
+   *                 The byte ring buffer to use, must be able to hold at least one line.
+   * @param[in]      line
+   *                 The line to feed, terminated by a line feed.
+   * @param[in]      lineLength
+   *                 The number of bytes of the line.
+   */
+  template <typename ring_t>
+  void frameByDelimiterScan(ring_t& ring, const uint8_t line[], std::size_t lineLength)
+  {
+    uint32_t frameCount = 0;
+    for (std::size_t i = 0; i < BENCHMARK_ELEMENTS; i += lineLength)
+    {
+      ring.write(line, lineLength);
+      MEM::memorySpanPair<const uint8_t> frame = ring.readUntil('\n');
+      while (frame.size() > 0)
+      {
+        ++frameCount;
+        ring.readRelease(frame.size());
+        frame = ring.readUntil('\n');
+      }
+    }
+    benchmarkSink = frameCount;
+  }
+} // namespace
+
+TEST_CASE(memoryBenchmark, benchmarkRingBufferIndexing)
+{
+  static moduloReferenceRing<1000>           moduloRing;
+  static MEM::ringBuffer<uint32_t, 1000 * 4> wrappedRing;
+  static MEM::ringBuffer<uint32_t, 1024 * 4> maskedRing;
+
+  const uint64_t moduloTime  = picosecondsPerElement([&]() { transferThroughRing(moduloRing); });
+  const uint64_t wrappedTime = picosecondsPerElement([&]() { transferThroughRing(wrappedRing); });
+  const uint64_t maskedTime  = picosecondsPerElement([&]() { transferThroughRing(maskedRing); });
+
+  QINFO("ring buffer, modulo indexing (before):         " << moduloTime << " ps/element");
+  QINFO("ring buffer, compare-and-wrap (1000 elements): " << wrappedTime << " ps/element");
+  QINFO("ring buffer, masked counters (1024 elements):  " << maskedTime << " ps/element");
+  QVERIFY(wrappedRing.isEmpty() && maskedRing.isEmpty());
+}
+
+TEST_CASE(memoryBenchmark, benchmarkQueueIndexing)
+{
+  static MEM::fifoQueue<uint32_t, 1000> wrappedQueue;
+  static MEM::fifoQueue<uint32_t, 1024> maskedQueue;
+
+  const uint64_t wrappedTime = picosecondsPerElement([&]() { transferThroughQueue(wrappedQueue); });
+  const uint64_t maskedTime  = picosecondsPerElement([&]() { transferThroughQueue(maskedQueue); });
+
+  QINFO("fifo queue, compare-and-wrap (1000 elements): " << wrappedTime << " ps/element");
+  QINFO("fifo queue, masked indices (1024 elements):   " << maskedTime << " ps/element");
+  QVERIFY(wrappedQueue.isEmpty() && maskedQueue.isEmpty());
+}
+
+TEST_CASE(memoryBenchmark, benchmarkByteFraming)
+{
+  static MEM::byteRingBuffer<1024> bytewiseRing;
+  static MEM::byteRingBuffer<1024> scanningRing;
+  const char                       LINE[]      = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+  const std::size_t                LINE_LENGTH = sizeof(LINE) - 1;
+  const uint8_t*                   line        = reinterpret_cast<const uint8_t*>(LINE);
+
+  const uint64_t bytewiseTime = picosecondsPerElement([&]() { frameBytewise(bytewiseRing, line, LINE_LENGTH); });
+  const uint64_t scanningTime = picosecondsPerElement([&]() { frameByDelimiterScan(scanningRing, line, LINE_LENGTH); });
+
+  QINFO("byte framing, read() per byte (before): " << bytewiseTime << " ps/byte");
+  QINFO("byte framing, readUntil() scan:         " << scanningTime << " ps/byte");
+  QVERIFY(bytewiseRing.isEmpty() && scanningRing.isEmpty());
+}
+
+TEST_CASE(memoryBenchmark, benchmarkQueueLockPolicy)
+{
+  static MEM::fifoQueue<uint32_t, 1024, MEM::mutexLock>    mutexQueue;
+  static MEM::fifoQueue<uint32_t, 1024, MEM::spinLock>     spinQueue;
+  static MEM::fifoQueue<uint32_t, 1024, MEM::noLock>       unlockedQueue;
+  static MEM::fifoQueue<uint32_t, 1024, MEM::lockFreeSpsc> lockFreeQueue;
+
+  const uint64_t mutexTime    = picosecondsPerElement([&]() { transferThroughQueue(mutexQueue); });
+  const uint64_t spinTime     = picosecondsPerElement([&]() { transferThroughQueue(spinQueue); });
+  const uint64_t unlockedTime = picosecondsPerElement([&]() { transferThroughQueue(unlockedQueue); });
+  const uint64_t lockFreeTime = picosecondsPerElement([&]() { transferThroughQueue(lockFreeQueue); });
+
+  QINFO("fifo queue, mutexLock (before): " << mutexTime << " ps/element");
+  QINFO("fifo queue, spinLock:           " << spinTime << " ps/element");
+  QINFO("fifo queue, noLock:             " << unlockedTime << " ps/element");
+  QINFO("fifo queue, lockFreeSpsc:       " << lockFreeTime << " ps/element");
+  QVERIFY(mutexQueue.isEmpty() && spinQueue.isEmpty() && unlockedQueue.isEmpty() && lockFreeQueue.isEmpty());
+}
+
+TEST_CASE(memoryBenchmark, benchmarkQueueDispatch)
+{
+  static virtualReferenceQueue<MEM::fifoQueue<uint32_t, 1024, MEM::noLock>> virtualFifoQueue;
+  static virtualReferenceQueue<MEM::lifoQueue<uint32_t, 1024, MEM::noLock>> virtualLifoQueue;
+  static MEM::fifoQueue<uint32_t, 1024, MEM::noLock>                        staticFifoQueue;
+  static MEM::lifoQueue<uint32_t, 1024, MEM::noLock>                        staticLifoQueue;
+
+  // Like a queue handed over as interface reference, the compiler cannot see which implementation is called
+  virtualQueueInterface* volatile virtualFifoAccess = &virtualFifoQueue;
+  virtualQueueInterface* volatile virtualLifoAccess = &virtualLifoQueue;
+
+  const uint64_t virtualFifoTime = picosecondsPerElement([&]() { transferThroughQueue(*virtualFifoAccess); });
+  const uint64_t staticFifoTime  = picosecondsPerElement([&]() { transferThroughQueue(staticFifoQueue); });
+  const uint64_t virtualLifoTime = picosecondsPerElement([&]() { transferThroughQueue(*virtualLifoAccess); });
+  const uint64_t staticLifoTime  = picosecondsPerElement([&]() { transferThroughQueue(staticLifoQueue); });
+
+  QINFO("fifo queue, virtual push()/pop() (before): " << virtualFifoTime << " ps/element");
+  QINFO("fifo queue, static dispatch:               " << staticFifoTime << " ps/element");
+  QINFO("lifo queue, virtual push()/pop() (before): " << virtualLifoTime << " ps/element");
+  QINFO("lifo queue, static dispatch:               " << staticLifoTime << " ps/element");
+  uint32_t value;
+  QVERIFY(!virtualFifoAccess->pop(value) && !virtualLifoAccess->pop(value));
+  QVERIFY(staticFifoQueue.isEmpty() && staticLifoQueue.isEmpty());
+}
+
+TEST_CASE(memoryBenchmark, benchmarkQueueBatch)
+{
+  static MEM::fifoQueue<uint32_t, 1024> singleQueue;
+  static MEM::fifoQueue<uint32_t, 1024> batchQueue;
+
+  const uint64_t singleTime = picosecondsPerElement([&]() { transferThroughQueueInBatches<256>(singleQueue, false); });
+  const uint64_t batchTime  = picosecondsPerElement([&]() { transferThroughQueueInBatches<256>(batchQueue, true); });
+
+  QINFO("fifo queue, 256 x push()/pop() (before): " << singleTime << " ps/element");
+  QINFO("fifo queue, pushN()/popN() of 256:       " << batchTime << " ps/element");
+  QVERIFY(singleQueue.isEmpty() && batchQueue.isEmpty());
+}
+
+TEST_CASE(memoryBenchmark, benchmarkPriorityQueue)
+{
+  static sortedArrayReference<1024>                                               sortedArray;
+  static MEM::priorityQueue<uint32_t, 1024, std::less<uint32_t>, MEM::noLock> heapQueue;
+
+  const uint64_t sortedTime = picosecondsPerElement([&]() { scheduleThroughQueue(sortedArray, 512); });
+  const uint64_t heapTime   = picosecondsPerElement([&]() { scheduleThroughQueue(heapQueue, 512); });
+
+  QINFO("scheduling 512 deadlines, sorted array (before): " << sortedTime << " ps/element");
+  QINFO("scheduling 512 deadlines, 4-ary heap:            " << heapTime << " ps/element");
+  QVERIFY(heapQueue.isEmpty());
+}
+
+TEST_CASE(memoryBenchmark, benchmarkWorkStealing)
+{
+  static MEM::workStealingDeque<uint32_t, 1024 * 4> deque;
+  const std::size_t                                 TASK_COUNT  = BENCHMARK_ELEMENTS / 16;
+  const std::size_t                                 CORE_COUNT  = std::thread::hardware_concurrency();
+  const std::size_t                                 MAX_WORKERS = (CORE_COUNT > 2) ? CORE_COUNT : 2; // Always measure stealing
+
+  uint64_t singleTime = 0;
+  for (std::size_t workerCount = 1; workerCount <= MAX_WORKERS; workerCount *= 2)
+  {
+    const uint64_t time = picosecondsPerElement([&]() { executeWithStealing(deque, workerCount, TASK_COUNT); }, TASK_COUNT);
+    singleTime          = (workerCount == 1) ? time : singleTime;
+    QINFO("work stealing, " << workerCount << " worker(s): " << time << " ps/task, speedup " << (singleTime * 100 / time) / 100.0);
+  }
+  QVERIFY(deque.isEmpty());
+}
+
+TEST_CASE(memoryBenchmark, benchmarkShardedQueue)
+{
+  static MEM::fifoQueue<uint32_t, 1024>       lockedQueue(MEM::QUEUE_REJECT);
+  static MEM::shardedQueue<uint32_t, 1024, 8> shardedQueue;
+  const std::size_t                           ELEMENT_COUNT = BENCHMARK_ELEMENTS / 4;
+
+  auto produceLocked = [&](std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      while (!lockedQueue.push(static_cast<uint32_t>(i)))
+      {
+        std::this_thread::yield();
+      }
+    }
+  };
+  auto produceSharded = [&](std::size_t count) {
+    const std::size_t lane = shardedQueue.attachProducer();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      while (!shardedQueue.push(lane, static_cast<uint32_t>(i)))
+      {
+        std::this_thread::yield();
+      }
+    }
+  };
+  auto consumeLocked  = [&](uint32_t values[], std::size_t count) { return lockedQueue.popN(values, count); };
+  auto consumeSharded = [&](uint32_t values[], std::size_t count) { return shardedQueue.popN(values, count); };
+
+  shardedQueue.setDrainBatch(64);
+  for (std::size_t producerCount = 1; producerCount <= 8; producerCount *= 2)
+  {
+    const uint64_t lockedTime = picosecondsPerElement(
+      [&]() { transferFromProducers(producerCount, ELEMENT_COUNT, produceLocked, consumeLocked); }, ELEMENT_COUNT);
+    shardedQueue.reset();
+    const uint64_t shardedTime = picosecondsPerElement(
+      [&]() { transferFromProducers(producerCount, ELEMENT_COUNT, produceSharded, consumeSharded); }, ELEMENT_COUNT);
+
+    QINFO(producerCount << " producer(s), fifo queue with mutexLock (before): " << lockedTime << " ps/element");
+    QINFO(producerCount << " producer(s), sharded queue:                      " << shardedTime << " ps/element");
+  }
+  QVERIFY(lockedQueue.isEmpty() && shardedQueue.isEmpty());
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(memoryBenchmark)
+#include "memory_benchmark.moc"
+#endif
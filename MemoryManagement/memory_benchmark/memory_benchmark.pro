@@ -0,0 +1,21 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle release
+
+TEMPLATE = app
+
+SOURCES +=  \
+    memory_benchmark.cpp \
+
+HEADERS += \
+    ../ring_buffer.hpp \
+    ../byte_ring_buffer.hpp \
+    ../memory_span.hpp \
+    ../queue.hpp \
+    ../../CoreComponents/global.hpp \
+
+INCLUDEPATH += \
+    ../../CoreComponents \
+    ../MemoryManagement \
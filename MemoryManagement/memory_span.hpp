@@ -0,0 +1,116 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     memory_span.hpp
+ * @version  0.2
+ * @brief    Definition of the memorySpan and memorySpanPair types.
+ * @details  A `memorySpan` refers to a contiguous run of elements that is owned by a container, so the caller can access the
+ *           storage directly (e.g. by a DMA engine, `recv()` or a compression routine) instead of copying element by element.
+ *           Circular containers hand out a `memorySpanPair`, since a range that crosses the end of the storage consists of
+ *           two contiguous runs: the part up to the end of the storage and the part that continues at its start.
+ *
+ * @note     A span does not own the memory it refers to and is only valid until the container is modified.
+ *           Process `first` before `second`; `second` is empty when the range does not wrap around.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+  /**
+   * @brief   A contiguous run of elements inside a container's storage.
+   * @tparam  T
+   *          Data type of the elements, `const` qualified for read-only access.
+   */
+  template <typename T>
+  struct memorySpan
+  {
+    T*          data; //!< Pointer to the first element, `nullptr` if the span is empty.
+    std::size_t size; //!< Number of elements in the span.
+  };
+
+  /**
+   * @brief   A range of elements inside a circular container, split at the end of the storage.
+   * @tparam  T
+   *          Data type of the elements, `const` qualified for read-only access.
+   */
+  template <typename T>
+  struct memorySpanPair
+  {
+    memorySpan<T> first;  //!< The part of the range up to the end of the storage.
+    memorySpan<T> second; //!< The part of the range that continues at the start of the storage.
+
+    /**
+     * @brief   Get the total number of elements in both spans.
+     * @return  The number of elements in the range.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief      Get a part of the range, split at the same point as the whole range.
+     * @param[in]  offset
+     *             The zero-based index of the first element of the part, relative to the start of `first`.
+     * @param[in]  count
+     *             The number of elements in the part.
+     * @return     The part of the range, clamped to the elements available after `offset`.
+     */
+    memorySpanPair subRange(std::size_t offset, std::size_t count) const;
+  };
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+namespace MEM
+{
+  template <typename T>
+  std::size_t memorySpanPair<T>::size() const
+  {
+    return first.size + second.size;
+  }
+
+  template <typename T>
+  memorySpanPair<T> memorySpanPair<T>::subRange(std::size_t offset, std::size_t count) const
+  {
+    const std::size_t totalSize = size();
+    offset                      = (offset < totalSize) ? offset : totalSize;
+    count                       = (count < (totalSize - offset)) ? count : (totalSize - offset);
+
+    memorySpanPair<T> part;
+    if (offset < first.size)
+    {
+      const std::size_t firstCount = ((first.size - offset) < count) ? (first.size - offset) : count;
+      part.first.data              = first.data + offset;
+      part.first.size              = firstCount;
+      part.second.data             = (count > firstCount) ? second.data : nullptr;
+      part.second.size             = count - firstCount;
+    }
+    else
+    {
+      // The part lies entirely in the second span, which then becomes the first one
+      part.first.data  = (count > 0) ? second.data + (offset - first.size) : nullptr;
+      part.first.size  = count;
+      part.second.data = nullptr;
+      part.second.size = 0;
+    }
+    if (part.first.size == 0)
+    {
+      part.first.data = nullptr;
+    }
+    return part;
+  }
+
+} // namespace MEM
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
@@ -0,0 +1,602 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     mirrored_ring_buffer.hpp
+ * @version  0.1
+ * @brief    Definition of the mirroredRingBuffer class and the platformRingBuffer alias.
+ * @details  The `mirroredRingBuffer` class is a `ringBuffer`-compatible circular buffer for Linux hosts whose storage is mapped
+ *           twice, back to back, into the virtual address space (an anonymous `memfd` mapped with two `mmap` calls). Every
+ *           element written behind the end of the first mapping shows up at the start of it and vice versa, so any run of up
+ *           to `capacity()` elements is contiguous in memory, even when it crosses the wrap point. Parsers can therefore scan
+ *           the stored data in place, without wrap handling and without a staging copy.
+ *
+ *           The interface matches `MEM::ringBuffer`, including `emplace()`, the move overload of `write()` and the statistics
+ *           policy, except that `capacity()` is determined at run time: the storage is rounded up to whole pages, so the
+ *           capacity is at least the number of elements that fit into `bufferSize`.
+ *           `readAcquire()` and `writeReserve()` always hand out a single span, the `second` span is always empty.
+ *
+ *           `platformRingBuffer<T, bufferSize, statistics_t>` selects the mirrored backend on Linux and `ringBuffer` on all other platforms,
+ *           so code written against the common interface can switch backends at compile time.
+ *
+ *           To use the `mirroredRingBuffer` class, follow the same steps as for `ringBuffer`, and process the data returned
+ *           by `readAcquire()` as one block, like this: `auto data = myRingBuffer.readAcquire(); parse(data.first.data, data.first.size);`.
+ *
+ * @note     This backend is meant for host builds only: the storage is requested from the operating system at construction,
+ *           which throws `std::runtime_error` if the mapping cannot be created. `T` must be trivially copyable, since elements
+ *           live in raw mapped memory.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include "memory_span.hpp"
+#include "ring_buffer.hpp"
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+#if defined(__linux__)
+  /**
+   * @brief    Class template for a ring buffer whose storage is mapped twice in a row, so all stored data is contiguous.
+   * @details  The `bufferSize` specifies the minimum size of the buffer in bytes, which is rounded up to whole pages.
+   * @tparam   T
+   *           Data type of the elements in the ring buffer, must be trivially copyable.
+   * @tparam   bufferSize
+   *           The minimum size of the buffer in bytes.
+   * @tparam   statistics_t
+   *           Statistics policy, `ringBufferNoStatistics` (default) or `ringBufferStatisticsCollector`.
+   */
+  template <typename T, std::size_t bufferSize, typename statistics_t = MEM::ringBufferNoStatistics>
+  class mirroredRingBuffer : private statistics_t
+  {
+  public:
+    /**
+     * @brief      Constructor that creates the mirrored mapping and initializes an empty ring buffer.
+     * @param[in]  overwrite
+     *             Specifies whether to overwrite the oldest element in the buffer when it is full.
+     *             Default is `RINGBUFFER_NO_OVERWRITE`.
+     * @throws     std::runtime_error if the mirrored mapping cannot be created.
+     */
+    explicit mirroredRingBuffer(MEM::ringBufferOverwrite_e overwrite = MEM::RINGBUFFER_NO_OVERWRITE);
+
+    /**
+     * @brief  Destructor that releases the mirrored mapping.
+     */
+    ~mirroredRingBuffer();
+
+    // Rule of Five
+    mirroredRingBuffer(const mirroredRingBuffer&)            = delete;
+    mirroredRingBuffer& operator=(const mirroredRingBuffer&) = delete;
+    mirroredRingBuffer(mirroredRingBuffer&&)                 = delete;
+    mirroredRingBuffer& operator=(mirroredRingBuffer&&)      = delete;
+
+    /**
+     * @brief  Reset the ring buffer to its initial, empty state.
+     */
+    void reset();
+
+    /**
+     * @brief      Set the overwrite behavior of the buffer when it is full.
+     * @param[in]  overwrite
+     *             The overwrite behavior to set.
+     */
+    void setOverwriteBehavior(MEM::ringBufferOverwrite_e overwrite);
+
+    /**
+     * @brief   Get the current overwrite behavior of the buffer.
+     * @return  The current overwrite behavior.
+     */
+    MEM::ringBufferOverwrite_e getOverwriteBehavior() const;
+
+    /**
+     * @brief   Check if the ring buffer is empty.
+     * @return  `true` if the buffer is empty, `false` otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief   Check if the ring buffer is full.
+     * @return  `true` if the buffer is full, `false` otherwise.
+     */
+    bool isFull() const;
+
+    /**
+     * @brief   Get the number of elements currently stored in the ring buffer.
+     * @return  The number of elements currently stored.
+     */
+    std::size_t count() const;
+
+    /**
+     * @brief   Get the maximum number of elements that can be stored in the ring buffer.
+     * @return  The capacity of the ring buffer, at least the number of elements that fit into `bufferSize`.
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief      Write a single element to the ring buffer.
+     * @param[in]  data
+     *             The element to be written to the buffer.
+     * @return     `true` if the data was written successfully, `false` if the buffer is full
+     *             and overwriting is not allowed.
+     */
+    bool write(const T& data);
+
+    /**
+     * @brief      Write a single element to the ring buffer by moving it.
+     * @param[in]  data
+     *             The element to be moved into the buffer.
+     * @return     `true` if the data was written successfully, `false` if the buffer is full
+     *             and overwriting is not allowed.
+     */
+    bool write(T&& data);
+
+    /**
+     * @brief      Construct a single element at the end of the ring buffer.
+     * @details    If the buffer is full and the overwrite behavior allows overwriting, the oldest element is dropped.
+     * @param[in]  args
+     *             The arguments forwarded to the constructor of `T`.
+     * @return     `true` if the element was constructed, `false` if the buffer is full and overwriting is not allowed.
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args);
+
+    /**
+     * @brief      Write multiple elements to the ring buffer with a single copy.
+     * @param[in]  data
+     *             The array of elements to write.
+     * @param[in]  dataCount
+     *             The number of elements to write.
+     * @return     The number of elements actually written to the buffer.
+     */
+    std::size_t write(const T data[], std::size_t dataCount);
+
+    /**
+     * @brief       Read a single element from the ring buffer.
+     * @param[out]  data
+     *              The variable to store the read element.
+     * @return      `true` if an element was read successfully, `false` if the buffer is empty.
+     */
+    bool read(T& data);
+
+    /**
+     * @brief       Read multiple elements from the ring buffer with a single copy.
+     * @param[out]  data
+     *              The array to store the read elements.
+     * @param[in]   dataCount
+     *              The maximum number of elements to read.
+     * @return      The number of elements actually read from the buffer.
+     */
+    std::size_t read(T data[], std::size_t dataCount);
+
+    /**
+     * @brief       Peek at an element in the ring buffer without removing it.
+     * @param[out]  data
+     *              The variable to store the peeked element.
+     * @param[in]   index
+     *              The zero-based index of the element to peek at, relative to the oldest element.
+     * @return      `true` if the element was peeked successfully, `false` if the index is out of range.
+     */
+    bool peek(T& data, std::size_t index) const;
+
+    /**
+     * @brief      Access an element in the ring buffer by index.
+     * @param[in]  index
+     *             The zero-based index of the element to access, relative to the oldest element.
+     * @return     A const reference to the element at the specified index.
+     * @throws     std::out_of_range if the index is out of range.
+     */
+    const T& operator[](std::size_t index) const;
+
+    /**
+     * @brief      Reserve free storage for writing without copying.
+     * @param[in]  dataCount
+     *             The maximum number of elements to reserve.
+     * @return     The reserved storage as a single span in `first`, limited to the free space of the buffer.
+     */
+    MEM::memorySpanPair<T> writeReserve(std::size_t dataCount);
+
+    /**
+     * @brief      Publish elements that were written into storage obtained with `writeReserve()`.
+     * @param[in]  dataCount
+     *             The number of elements that were written, counted from the start of the reserved storage.
+     * @return     The number of elements actually published, limited to the free space of the buffer.
+     */
+    std::size_t writeCommit(std::size_t dataCount);
+
+    /**
+     * @brief   Acquire the stored elements for reading without copying.
+     * @return  All stored elements, oldest first, as a single span in `first`.
+     */
+    MEM::memorySpanPair<const T> readAcquire() const;
+
+    /**
+     * @brief      Free the oldest elements after they were processed through `readAcquire()`.
+     * @param[in]  dataCount
+     *             The number of elements to free.
+     * @return     The number of elements actually freed, limited to the number of stored elements.
+     */
+    std::size_t readRelease(std::size_t dataCount);
+
+    /**
+     * @brief   Get a snapshot of the statistics collected by the statistics policy.
+     * @return  The statistics, all zero when the buffer uses `ringBufferNoStatistics`.
+     */
+    MEM::ringBufferStatistics_t getStatistics() const;
+
+    /**
+     * @brief  Reset the statistics collected by the statistics policy, `reset()` leaves them untouched.
+     */
+    void resetStatistics();
+
+  private:
+    static_assert(std::is_trivially_copyable<T>::value, "Type T must be trivially copyable.");
+    static_assert(bufferSize / sizeof(T) > 0, "Buffer size is too small to hold even one element of type T.");
+
+    T*                         m_dataArray;        //!< Start of the first of both mappings of the storage.
+    std::size_t                m_mappingSize;      //!< Size of a single mapping in bytes.
+    std::size_t                m_elementCount;     //!< Number of elements that fit in a single mapping.
+    MEM::ringBufferOverwrite_e m_overwriteSetting; //!< Overwrite behavior when the buffer is full.
+    std::size_t                m_readIndex;        //!< Index of the current read position.
+    std::size_t                m_elementsStored;   //!< Number of elements currently stored in the buffer.
+
+    /**
+     * @brief   Get the array position at which the next element is written.
+     * @return  The position in the first mapping.
+     */
+    std::size_t writeIndex() const;
+
+    /**
+     * @brief      Advance the read position, removing elements from the ring buffer.
+     * @param[in]  steps
+     *             The number of elements to remove, at most the number of stored elements.
+     */
+    void advanceRead(std::size_t steps);
+  };
+
+  /**
+   * @brief  Ring buffer backend for the current platform: mirrored on Linux hosts.
+   */
+  template <typename T, std::size_t bufferSize, typename statistics_t = MEM::ringBufferNoStatistics>
+  using platformRingBuffer = mirroredRingBuffer<T, bufferSize, statistics_t>;
+#else
+  /**
+   * @brief  Ring buffer backend for the current platform: the statically allocated `ringBuffer`.
+   */
+  template <typename T, std::size_t bufferSize, typename statistics_t = MEM::ringBufferNoStatistics>
+  using platformRingBuffer = ringBuffer<T, bufferSize, statistics_t>;
+#endif
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+#if defined(__linux__)
+namespace MEM
+{
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  mirroredRingBuffer<T, bufferSize, statistics_t>::mirroredRingBuffer(MEM::ringBufferOverwrite_e overwrite) :
+    m_dataArray(nullptr),
+    m_mappingSize(0),
+    m_elementCount(0),
+    m_overwriteSetting(overwrite),
+    m_readIndex(0),
+    m_elementsStored(0)
+  {
+    // Round up to whole pages, such that the wrap point also falls on an element boundary
+    const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    std::size_t       pages    = (bufferSize + pageSize - 1) / pageSize;
+    while (((pages * pageSize) % sizeof(T)) != 0)
+    {
+      ++pages;
+    }
+    m_mappingSize  = pages * pageSize;
+    m_elementCount = m_mappingSize / sizeof(T);
+
+    const int fileDescriptor = memfd_create("mirroredRingBuffer", MFD_CLOEXEC);
+    if (fileDescriptor < 0)
+    {
+      throw std::runtime_error("Unable to create the ring buffer storage");
+    }
+    if (ftruncate(fileDescriptor, static_cast<off_t>(m_mappingSize)) != 0)
+    {
+      close(fileDescriptor);
+      throw std::runtime_error("Unable to size the ring buffer storage");
+    }
+
+    // Reserve an address range for both mappings, then map the storage twice into it
+    void* addressRange = mmap(nullptr, 2 * m_mappingSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addressRange == MAP_FAILED)
+    {
+      close(fileDescriptor);
+      throw std::runtime_error("Unable to reserve address space for the ring buffer");
+    }
+
+    uint8_t* base         = static_cast<uint8_t*>(addressRange);
+    void*    firstMapping = mmap(base, m_mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fileDescriptor, 0);
+    void*    mirror       = mmap(base + m_mappingSize, m_mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fileDescriptor, 0);
+    close(fileDescriptor);
+
+    if ((firstMapping == MAP_FAILED) || (mirror == MAP_FAILED))
+    {
+      munmap(addressRange, 2 * m_mappingSize);
+      throw std::runtime_error("Unable to map the ring buffer storage");
+    }
+
+    m_dataArray = reinterpret_cast<T*>(base);
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  mirroredRingBuffer<T, bufferSize, statistics_t>::~mirroredRingBuffer()
+  {
+    munmap(m_dataArray, 2 * m_mappingSize);
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  void mirroredRingBuffer<T, bufferSize, statistics_t>::reset()
+  {
+    m_readIndex      = 0;
+    m_elementsStored = 0;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  void mirroredRingBuffer<T, bufferSize, statistics_t>::setOverwriteBehavior(MEM::ringBufferOverwrite_e overwrite)
+  {
+    m_overwriteSetting = overwrite;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  MEM::ringBufferOverwrite_e mirroredRingBuffer<T, bufferSize, statistics_t>::getOverwriteBehavior() const
+  {
+    return m_overwriteSetting;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  bool mirroredRingBuffer<T, bufferSize, statistics_t>::isEmpty() const
+  {
+    return m_elementsStored == 0;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  bool mirroredRingBuffer<T, bufferSize, statistics_t>::isFull() const
+  {
+    return m_elementsStored == m_elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  std::size_t mirroredRingBuffer<T, bufferSize, statistics_t>::count() const
+  {
+    return m_elementsStored;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  std::size_t mirroredRingBuffer<T, bufferSize, statistics_t>::capacity() const
+  {
+    return m_elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  bool mirroredRingBuffer<T, bufferSize, statistics_t>::write(const T& data)
+  {
+    return emplace(data);
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  bool mirroredRingBuffer<T, bufferSize, statistics_t>::write(T&& data)
+  {
+    return emplace(std::move(data));
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  template <typename... Args>
+  bool mirroredRingBuffer<T, bufferSize, statistics_t>::emplace(Args&&... args)
+  {
+    if (isFull())
+    {
+      if (m_overwriteSetting == MEM::RINGBUFFER_ALLOW_OVERWRITE)
+      {
+        // The arguments may refer to the oldest element, so build the new one before dropping it to make room
+        T item(std::forward<Args>(args)...);
+        advanceRead(1);
+        statistics_t::recordDropped(1);
+
+        new (&m_dataArray[writeIndex()]) T(std::move(item));
+        ++m_elementsStored;
+        statistics_t::recordWrite(m_elementsStored);
+        return true;
+      }
+      else
+      {
+        // Cannot write, buffer is full
+        statistics_t::recordRejected(1);
+        return false;
+      }
+    }
+
+    new (&m_dataArray[writeIndex()]) T(std::forward<Args>(args)...);
+    ++m_elementsStored;
+    statistics_t::recordWrite(m_elementsStored);
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  std::size_t mirroredRingBuffer<T, bufferSize, statistics_t>::write(const T data[], std::size_t dataCount)
+  {
+    std::size_t copyCount = dataCount;
+    std::size_t freeSpace = m_elementCount - m_elementsStored;
+
+    if (copyCount > freeSpace)
+    {
+      if (m_overwriteSetting == MEM::RINGBUFFER_ALLOW_OVERWRITE)
+      {
+        // Every element beyond the free space costs one element, stored or from this write
+        statistics_t::recordDropped(copyCount - freeSpace);
+
+        // Only the newest elements survive, skip the ones that would be overwritten by this write itself
+        if (copyCount > m_elementCount)
+        {
+          data += copyCount - m_elementCount;
+          copyCount = m_elementCount;
+        }
+        // Drop the oldest stored elements to make room in one step
+        advanceRead(copyCount - freeSpace);
+      }
+      else
+      {
+        // Buffer becomes full and overwriting is not allowed
+        statistics_t::recordRejected(copyCount - freeSpace);
+        copyCount = freeSpace;
+        dataCount = freeSpace;
+      }
+    }
+
+    if (copyCount > 0)
+    {
+      std::memcpy(&m_dataArray[writeIndex()], data, copyCount * sizeof(T));
+      m_elementsStored += copyCount;
+      statistics_t::recordWrite(m_elementsStored);
+    }
+    return dataCount;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  bool mirroredRingBuffer<T, bufferSize, statistics_t>::read(T& data)
+  {
+    return read(&data, 1) == 1;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  std::size_t mirroredRingBuffer<T, bufferSize, statistics_t>::read(T data[], std::size_t dataCount)
+  {
+    const std::size_t itemsRead = (dataCount < m_elementsStored) ? dataCount : m_elementsStored;
+
+    if (itemsRead > 0)
+    {
+      std::memcpy(data, &m_dataArray[m_readIndex], itemsRead * sizeof(T));
+      advanceRead(itemsRead);
+    }
+    return itemsRead;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  bool mirroredRingBuffer<T, bufferSize, statistics_t>::peek(T& data, std::size_t index) const
+  {
+    if (index >= m_elementsStored)
+    {
+      // Index is out of range
+      return false;
+    }
+    else
+    {
+      // The mirror makes the position behind the end valid
+      data = m_dataArray[m_readIndex + index];
+      return true;
+    }
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  const T& mirroredRingBuffer<T, bufferSize, statistics_t>::operator[](std::size_t index) const
+  {
+    if (index >= m_elementsStored)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    else
+    {
+      return m_dataArray[m_readIndex + index];
+    }
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  MEM::memorySpanPair<T> mirroredRingBuffer<T, bufferSize, statistics_t>::writeReserve(std::size_t dataCount)
+  {
+    const std::size_t freeSpace     = m_elementCount - m_elementsStored;
+    const std::size_t reservedCount = (dataCount < freeSpace) ? dataCount : freeSpace;
+
+    MEM::memorySpanPair<T> spans;
+    spans.first.data  = (reservedCount > 0) ? &m_dataArray[writeIndex()] : nullptr;
+    spans.first.size  = reservedCount;
+    spans.second.data = nullptr;
+    spans.second.size = 0;
+    return spans;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  std::size_t mirroredRingBuffer<T, bufferSize, statistics_t>::writeCommit(std::size_t dataCount)
+  {
+    const std::size_t freeSpace      = m_elementCount - m_elementsStored;
+    const std::size_t committedCount = (dataCount < freeSpace) ? dataCount : freeSpace;
+
+    m_elementsStored += committedCount;
+    if (committedCount > 0)
+    {
+      statistics_t::recordWrite(m_elementsStored);
+    }
+    return committedCount;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  MEM::memorySpanPair<const T> mirroredRingBuffer<T, bufferSize, statistics_t>::readAcquire() const
+  {
+    MEM::memorySpanPair<const T> spans;
+    spans.first.data  = (m_elementsStored > 0) ? &m_dataArray[m_readIndex] : nullptr;
+    spans.first.size  = m_elementsStored;
+    spans.second.data = nullptr;
+    spans.second.size = 0;
+    return spans;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  std::size_t mirroredRingBuffer<T, bufferSize, statistics_t>::readRelease(std::size_t dataCount)
+  {
+    const std::size_t releasedCount = (dataCount < m_elementsStored) ? dataCount : m_elementsStored;
+
+    advanceRead(releasedCount);
+    return releasedCount;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  MEM::ringBufferStatistics_t mirroredRingBuffer<T, bufferSize, statistics_t>::getStatistics() const
+  {
+    return statistics_t::snapshot();
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  void mirroredRingBuffer<T, bufferSize, statistics_t>::resetStatistics()
+  {
+    statistics_t::clear();
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  std::size_t mirroredRingBuffer<T, bufferSize, statistics_t>::writeIndex() const
+  {
+    const std::size_t index = m_readIndex + m_elementsStored;
+    return (index >= m_elementCount) ? index - m_elementCount : index;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  void mirroredRingBuffer<T, bufferSize, statistics_t>::advanceRead(std::size_t steps)
+  {
+    m_readIndex += steps;
+    m_readIndex = (m_readIndex >= m_elementCount) ? m_readIndex - m_elementCount : m_readIndex;
+    m_elementsStored -= steps;
+  }
+
+} // namespace MEM
+#endif
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
@@ -0,0 +1,252 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../mirrored_ring_buffer.hpp"
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class testMirroredRingBuffer : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testMirroredRingBufferWriteRead();
+  void testMirroredRingBufferContiguousWrap();
+  void testMirroredRingBufferReserveCommit();
+  void testMirroredRingBufferOverwrite();
+  void testMirroredRingBufferOddElementSize();
+  void testMirroredRingBufferEmplaceStatistics();
+  void testPlatformRingBuffer();
+};
+#endif
+
+TEST_CASE(testMirroredRingBuffer, testMirroredRingBufferWriteRead)
+{
+#if defined(__linux__)
+  MEM::mirroredRingBuffer<int, 5 * sizeof(int)> myRingBuffer;
+
+  // The storage is rounded up to whole pages
+  QVERIFY(myRingBuffer.capacity() >= 5);
+  QVERIFY(myRingBuffer.isEmpty());
+
+  QVERIFY(myRingBuffer.write(1));
+  QVERIFY(myRingBuffer.write(2));
+  QCOMPARE(static_cast<int>(myRingBuffer.count()), 2);
+  QCOMPARE(myRingBuffer[1], 2);
+
+  int value;
+  QVERIFY(myRingBuffer.peek(value, 0));
+  QCOMPARE(value, 1);
+  QVERIFY(myRingBuffer.read(value));
+  QCOMPARE(value, 1);
+  QVERIFY(myRingBuffer.read(value));
+  QCOMPARE(value, 2);
+  QVERIFY(!myRingBuffer.read(value));
+  QVERIFY_EXCEPTION_THROWN(myRingBuffer[0], std::out_of_range);
+
+  myRingBuffer.write(3);
+  myRingBuffer.reset();
+  QVERIFY(myRingBuffer.isEmpty());
+#else
+  QSKIP("The mirrored ring buffer is only available on Linux");
+#endif
+}
+
+TEST_CASE(testMirroredRingBuffer, testMirroredRingBufferContiguousWrap)
+{
+#if defined(__linux__)
+  MEM::mirroredRingBuffer<uint8_t, 4096> myRingBuffer;
+  const std::size_t                      capacity = myRingBuffer.capacity();
+  uint8_t                                data[256];
+  uint8_t                                values[256];
+
+  for (std::size_t i = 0; i < sizeof(data); ++i)
+  {
+    data[i] = static_cast<uint8_t>(i);
+  }
+
+  // Move the read position close to the end of the storage
+  std::size_t remaining = capacity - 100;
+  while (remaining > 0)
+  {
+    std::size_t chunk = (remaining < sizeof(data)) ? remaining : sizeof(data);
+    QCOMPARE(myRingBuffer.write(data, chunk), chunk);
+    QCOMPARE(myRingBuffer.read(values, chunk), chunk);
+    remaining -= chunk;
+  }
+
+  // Data written across the wrap point is handed out as one contiguous block
+  QCOMPARE(static_cast<int>(myRingBuffer.write(data, 200)), 200);
+  MEM::memorySpanPair<const uint8_t> spans = myRingBuffer.readAcquire();
+  QCOMPARE(static_cast<int>(spans.first.size), 200);
+  QCOMPARE(static_cast<int>(spans.second.size), 0);
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    QCOMPARE(spans.first.data[i], static_cast<uint8_t>(i));
+  }
+
+  // Indexed access behind the end of the storage uses the mirror
+  QCOMPARE(myRingBuffer[150], static_cast<uint8_t>(150));
+  QCOMPARE(static_cast<int>(myRingBuffer.read(values, 256)), 200);
+  QCOMPARE(values[199], static_cast<uint8_t>(199));
+#else
+  QSKIP("The mirrored ring buffer is only available on Linux");
+#endif
+}
+
+TEST_CASE(testMirroredRingBuffer, testMirroredRingBufferReserveCommit)
+{
+#if defined(__linux__)
+  MEM::mirroredRingBuffer<uint8_t, 4096> myRingBuffer;
+  const std::size_t                      capacity = myRingBuffer.capacity();
+
+  // Move the write position close to the end of the storage
+  myRingBuffer.writeCommit(capacity - 10);
+  myRingBuffer.readRelease(capacity - 10);
+
+  // A reservation across the wrap point is a single span
+  MEM::memorySpanPair<uint8_t> spans = myRingBuffer.writeReserve(20);
+  QCOMPARE(static_cast<int>(spans.first.size), 20);
+  QCOMPARE(static_cast<int>(spans.second.size), 0);
+  for (uint8_t i = 0; i < 20; ++i)
+  {
+    spans.first.data[i] = i;
+  }
+  QCOMPARE(static_cast<int>(myRingBuffer.writeCommit(20)), 20);
+
+  uint8_t value;
+  for (uint8_t i = 0; i < 20; ++i)
+  {
+    QVERIFY(myRingBuffer.read(value));
+    QCOMPARE(value, i);
+  }
+
+  // Reservations and commits are limited to the free space
+  QCOMPARE(myRingBuffer.writeReserve(capacity + 1).size(), capacity);
+  QCOMPARE(myRingBuffer.writeCommit(capacity + 1), capacity);
+  QVERIFY(myRingBuffer.isFull());
+  QCOMPARE(myRingBuffer.readRelease(capacity + 1), capacity);
+#else
+  QSKIP("The mirrored ring buffer is only available on Linux");
+#endif
+}
+
+TEST_CASE(testMirroredRingBuffer, testMirroredRingBufferOverwrite)
+{
+#if defined(__linux__)
+  MEM::mirroredRingBuffer<uint32_t, 4096> myRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+  const std::size_t                       capacity = myRingBuffer.capacity();
+
+  // Fill the buffer, then overwrite the oldest elements
+  for (uint32_t i = 0; i < capacity + 3; ++i)
+  {
+    QVERIFY(myRingBuffer.write(i));
+  }
+  QVERIFY(myRingBuffer.isFull());
+  QCOMPARE(myRingBuffer[0], static_cast<uint32_t>(3));
+  QCOMPARE(myRingBuffer[capacity - 1], static_cast<uint32_t>(capacity + 2));
+
+  // Without overwriting, a full buffer rejects data
+  myRingBuffer.setOverwriteBehavior(MEM::RINGBUFFER_NO_OVERWRITE);
+  QCOMPARE(myRingBuffer.getOverwriteBehavior(), MEM::RINGBUFFER_NO_OVERWRITE);
+  QVERIFY(!myRingBuffer.write(0));
+#else
+  QSKIP("The mirrored ring buffer is only available on Linux");
+#endif
+}
+
+TEST_CASE(testMirroredRingBuffer, testMirroredRingBufferOddElementSize)
+{
+#if defined(__linux__)
+  struct sample_t
+  {
+    int32_t x;
+    int32_t y;
+    int32_t z;
+  };
+
+  // The storage is sized so that the wrap point falls on an element boundary
+  MEM::mirroredRingBuffer<sample_t, 100 * sizeof(sample_t)> myRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+  const std::size_t                                         capacity = myRingBuffer.capacity();
+  QVERIFY(capacity >= 100);
+
+  for (int32_t i = 0; i < static_cast<int32_t>(capacity) + 7; ++i)
+  {
+    sample_t sample = { i, -i, 2 * i };
+    QVERIFY(myRingBuffer.write(sample));
+  }
+
+  MEM::memorySpanPair<const sample_t> spans = myRingBuffer.readAcquire();
+  QCOMPARE(spans.first.size, capacity);
+  QCOMPARE(spans.first.data[0].x, 7);
+  QCOMPARE(spans.first.data[capacity - 1].z, 2 * (static_cast<int32_t>(capacity) + 6));
+#else
+  QSKIP("The mirrored ring buffer is only available on Linux");
+#endif
+}
+
+TEST_CASE(testMirroredRingBuffer, testMirroredRingBufferEmplaceStatistics)
+{
+#if defined(__linux__)
+  MEM::mirroredRingBuffer<uint32_t, 4096, MEM::ringBufferStatisticsCollector> myRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+  const std::size_t                                                          capacity = myRingBuffer.capacity();
+
+  // Copying, moving and constructing writes end up in the same storage
+  uint32_t value = 0;
+  QVERIFY(myRingBuffer.write(value));
+  QVERIFY(myRingBuffer.write(uint32_t{ 1 }));
+  for (uint32_t i = 2; i < capacity; ++i)
+  {
+    QVERIFY(myRingBuffer.emplace(i));
+  }
+  QVERIFY(myRingBuffer.isFull());
+
+  // The new element is built from the oldest one before that one is dropped
+  QVERIFY(myRingBuffer.emplace(myRingBuffer[0]));
+  QCOMPARE(myRingBuffer[0], static_cast<uint32_t>(1));
+  QCOMPARE(myRingBuffer[capacity - 1], static_cast<uint32_t>(0));
+
+  myRingBuffer.setOverwriteBehavior(MEM::RINGBUFFER_NO_OVERWRITE);
+  QVERIFY(!myRingBuffer.emplace(value));
+
+  MEM::ringBufferStatistics_t statistics = myRingBuffer.getStatistics();
+  QCOMPARE(statistics.droppedCount, static_cast<uint32_t>(1));
+  QCOMPARE(statistics.rejectedCount, static_cast<uint32_t>(1));
+  QCOMPARE(statistics.highWatermark, capacity);
+
+  // Resetting the statistics leaves the stored data untouched
+  myRingBuffer.resetStatistics();
+  statistics = myRingBuffer.getStatistics();
+  QCOMPARE(statistics.droppedCount, static_cast<uint32_t>(0));
+  QCOMPARE(statistics.highWatermark, static_cast<std::size_t>(0));
+  QVERIFY(myRingBuffer.isFull());
+#else
+  QSKIP("The mirrored ring buffer is only available on Linux");
+#endif
+}
+
+TEST_CASE(testMirroredRingBuffer, testPlatformRingBuffer)
+{
+  // The platform backend offers the common ring buffer interface
+  MEM::platformRingBuffer<int, 5 * sizeof(int), MEM::ringBufferStatisticsCollector> myRingBuffer;
+  int                                                                               data[3] = { 1, 2, 3 };
+  int                                                                               values[5];
+
+  QCOMPARE(static_cast<int>(myRingBuffer.write(data, 3)), 3);
+  QVERIFY(myRingBuffer.emplace(4));
+  QVERIFY(myRingBuffer.write(5));
+  QCOMPARE(static_cast<int>(myRingBuffer.readAcquire().size()), 5);
+  QCOMPARE(myRingBuffer.getStatistics().highWatermark, static_cast<std::size_t>(5));
+  QCOMPARE(static_cast<int>(myRingBuffer.read(values, 5)), 5);
+  QCOMPARE(values[4], 5);
+  QVERIFY(myRingBuffer.isEmpty());
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testMirroredRingBuffer)
+#include "mirrored_ring_buffer_test.moc"
+#endif
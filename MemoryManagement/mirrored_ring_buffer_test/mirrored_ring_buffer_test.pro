@@ -0,0 +1,20 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle release
+
+TEMPLATE = app
+
+SOURCES +=  \
+    mirrored_ring_buffer_test.cpp \
+
+HEADERS += \
+    ../mirrored_ring_buffer.hpp \
+    ../ring_buffer.hpp \
+    ../memory_span.hpp \
+    ../../CoreComponents/global.hpp \
+
+INCLUDEPATH += \
+    ../../CoreComponents \
+    ../MemoryManagement \
@@ -0,0 +1,309 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     mpmc_ring_buffer.hpp
+ * @version  0.1
+ * @brief    Definition of the mpmcRingBuffer class.
+ * @details  The `mpmcRingBuffer` class is a bounded, lock-free multi-producer/multi-consumer ring buffer with statically
+ *           allocated memory. Any number of threads may write and read at the same time without additional locking.
+ *
+ *           Every slot carries a sequence number next to the element. A producer claims the slot at the current write
+ *           position with a single compare-and-swap once the slot's sequence shows that it is free, stores the element and
+ *           then publishes it by advancing the sequence. A consumer does the same for the read position, and hands the slot
+ *           back to the producers one lap ahead. Producers and consumers therefore only contend on their own position
+ *           counter, which each live on a separate cache line, and never on a shared element counter or lock.
+ *
+ *           The template parameters are the data type (`T`) and the buffer size in bytes (`bufferSize`), as for `ringBuffer`.
+ *           The class calculates at compile time how many elements of type `T` fit into the specified buffer size; the
+ *           sequence numbers are stored in addition to that.
+ *
+ *           To use the `mpmcRingBuffer` class, follow these steps:
+ *           -# Instantiate an instance with the desired data type and buffer size in bytes as template parameters,
+ *              like this: `mpmcRingBuffer<int, 64> myMpmcRingBuffer;`.
+ *           -# Use the `write()` function from any thread to add elements, like this: `myMpmcRingBuffer.write(42);`.
+ *           -# Use the `read()` function from any thread to take elements, like this: `int myValue; myMpmcRingBuffer.read(myValue);`.
+ *           -# Check the return value of `write()` and `read()` to determine whether or not an operation was successful.
+ *
+ * @note     The number of elements that fit into `bufferSize` must be a power of two, so that slot positions can be derived
+ *           with a mask and stay consistent when the position counters wrap around. If it is not, a compile-time error will occur.
+ *           Overwriting the oldest element is not supported. `reset()` is not thread-safe.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include <atomic>
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+  /**
+   * @brief    Class template for a bounded lock-free multi-producer/multi-consumer ring buffer with statically allocated memory.
+   * @details  The `bufferSize` specifies the size of the element storage in bytes.
+   *           The class calculates how many elements of type `T` can fit into the buffer.
+   * @tparam   T
+   *           Data type of the elements in the ring buffer.
+   * @tparam   bufferSize
+   *           The size of the element storage in bytes.
+   */
+  template <typename T, std::size_t bufferSize>
+  class mpmcRingBuffer
+  {
+  public:
+    /**
+     * @brief  Constructor that initializes an empty ring buffer.
+     */
+    mpmcRingBuffer();
+
+    // Rule of Five
+    mpmcRingBuffer(const mpmcRingBuffer&)            = delete;
+    mpmcRingBuffer& operator=(const mpmcRingBuffer&) = delete;
+    mpmcRingBuffer(mpmcRingBuffer&&)                 = delete;
+    mpmcRingBuffer& operator=(mpmcRingBuffer&&)      = delete;
+    ~mpmcRingBuffer()                                = default;
+
+    /**
+     * @brief  Reset the ring buffer to its initial, empty state.
+     * @note   Not thread-safe, no other thread may access the buffer during the reset.
+     */
+    void reset();
+
+    /**
+     * @brief   Check if the ring buffer is empty.
+     * @return  `true` if the buffer was empty at the time of the call, `false` otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief   Check if the ring buffer is full.
+     * @return  `true` if the buffer was full at the time of the call, `false` otherwise.
+     */
+    bool isFull() const;
+
+    /**
+     * @brief   Get the number of elements currently stored in the ring buffer.
+     * @return  The number of claimed but not yet released elements, which is a snapshot under concurrent access.
+     */
+    std::size_t count() const;
+
+    /**
+     * @brief   Get the maximum number of elements that can be stored in the ring buffer.
+     * @return  The capacity of the ring buffer.
+     */
+    constexpr std::size_t capacity() const;
+
+    /**
+     * @brief      Write a single element to the ring buffer.
+     * @param[in]  data
+     *             The element to be written to the buffer.
+     * @return     `true` if the data was written successfully, `false` if the buffer is full.
+     */
+    bool write(const T& data);
+
+    /**
+     * @brief      Write a single element to the ring buffer (move semantics).
+     * @param[in]  data
+     *             The element to be moved into the buffer.
+     * @return     `true` if the data was written successfully, `false` if the buffer is full.
+     */
+    bool write(T&& data);
+
+    /**
+     * @brief       Read a single element from the ring buffer.
+     * @param[out]  data
+     *              The variable to store the read element.
+     * @return      `true` if an element was read successfully, `false` if the buffer is empty.
+     */
+    bool read(T& data);
+
+  private:
+    static constexpr std::size_t elementCount = bufferSize / sizeof(T); //!< Number of elements that can fit in the buffer.
+    static_assert(elementCount > 0, "Buffer size is too small to hold even one element of type T.");
+    static_assert(isPowerOfTwo(elementCount), "The number of elements that fit in the buffer must be a power of two.");
+    static constexpr std::size_t indexMask = elementCount - 1; //!< Mask to convert a position into a slot index.
+
+    /**
+     * @brief  A single storage slot, consisting of the element and its sequence number.
+     */
+    struct slot_t
+    {
+      std::atomic<std::size_t> sequence; //!< Position for which the slot is currently free or holds data.
+      T                        data;     //!< The stored element.
+    };
+
+    alignas(cacheLineSize) std::atomic<std::size_t> m_writePosition; //!< Next position to be claimed by a producer.
+    alignas(cacheLineSize) std::atomic<std::size_t> m_readPosition;  //!< Next position to be claimed by a consumer.
+    alignas(cacheLineSize) slot_t m_slotArray[elementCount];         //!< The statically allocated slots.
+
+    /**
+     * @brief       Claim the next free slot for a producer.
+     * @param[out]  position
+     *              The claimed position.
+     * @return      `true` if a slot was claimed, `false` if the buffer is full.
+     */
+    bool claimWrite(std::size_t& position);
+  };
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+namespace MEM
+{
+  template <typename T, std::size_t bufferSize>
+  mpmcRingBuffer<T, bufferSize>::mpmcRingBuffer()
+  {
+    static_assert(std::is_default_constructible<T>::value, "Type T must be default constructible.");
+    reset();
+  }
+
+  template <typename T, std::size_t bufferSize>
+  void mpmcRingBuffer<T, bufferSize>::reset()
+  {
+    for (std::size_t i = 0; i < elementCount; ++i)
+    {
+      m_slotArray[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_writePosition.store(0, std::memory_order_relaxed);
+    m_readPosition.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool mpmcRingBuffer<T, bufferSize>::isEmpty() const
+  {
+    return count() == 0;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool mpmcRingBuffer<T, bufferSize>::isFull() const
+  {
+    return count() >= elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t mpmcRingBuffer<T, bufferSize>::count() const
+  {
+    const std::size_t readPosition  = m_readPosition.load(std::memory_order_acquire);
+    const std::size_t writePosition = m_writePosition.load(std::memory_order_acquire);
+    const std::size_t difference    = writePosition - readPosition;
+
+    // The read position is loaded first, so the difference never goes negative. It can exceed the capacity when producers
+    // and consumers both move on between the two loads, but no more than the capacity is ever stored
+    return (difference > elementCount) ? elementCount : difference;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  constexpr std::size_t mpmcRingBuffer<T, bufferSize>::capacity() const
+  {
+    return elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool mpmcRingBuffer<T, bufferSize>::write(const T& data)
+  {
+    std::size_t position;
+    if (!claimWrite(position))
+    {
+      return false;
+    }
+
+    slot_t& slot = m_slotArray[position & indexMask];
+    slot.data    = data;
+    slot.sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool mpmcRingBuffer<T, bufferSize>::write(T&& data)
+  {
+    std::size_t position;
+    if (!claimWrite(position))
+    {
+      return false;
+    }
+
+    slot_t& slot = m_slotArray[position & indexMask];
+    slot.data    = std::move(data);
+    slot.sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool mpmcRingBuffer<T, bufferSize>::read(T& data)
+  {
+    std::size_t position = m_readPosition.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+      slot_t&           slot       = m_slotArray[position & indexMask];
+      const std::size_t sequence   = slot.sequence.load(std::memory_order_acquire);
+      const auto        difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+      if (difference == 0)
+      {
+        // The slot holds published data for this position, try to claim it
+        if (m_readPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        {
+          data = std::move(slot.data);
+          slot.sequence.store(position + elementCount, std::memory_order_release);
+          return true;
+        }
+        // On failure `position` holds the current read position
+      }
+      else if (difference < 0)
+      {
+        // The slot has not been published yet, the buffer is empty
+        return false;
+      }
+      else
+      {
+        // Another consumer claimed this position, retry with the current one
+        position = m_readPosition.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool mpmcRingBuffer<T, bufferSize>::claimWrite(std::size_t& position)
+  {
+    position = m_writePosition.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+      const std::size_t sequence   = m_slotArray[position & indexMask].sequence.load(std::memory_order_acquire);
+      const auto        difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+      if (difference == 0)
+      {
+        // The slot is free for this position, try to claim it
+        if (m_writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        {
+          return true;
+        }
+        // On failure `position` holds the current write position
+      }
+      else if (difference < 0)
+      {
+        // The slot still holds data from the previous lap, the buffer is full
+        return false;
+      }
+      else
+      {
+        // Another producer claimed this position, retry with the current one
+        position = m_writePosition.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+} // namespace MEM
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
@@ -0,0 +1,144 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../mpmc_ring_buffer.hpp"
+#include <thread>
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class testMpmcRingBuffer : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testMpmcRingBufferWriteRead();
+  void testMpmcRingBufferWrapAround();
+  void testMpmcRingBufferReset();
+  void testMpmcRingBufferConcurrentTransfer();
+};
+#endif
+
+TEST_CASE(testMpmcRingBuffer, testMpmcRingBufferWriteRead)
+{
+  MEM::mpmcRingBuffer<int, 4 * sizeof(int)> myMpmcRingBuffer;
+
+  QVERIFY(myMpmcRingBuffer.isEmpty());
+  QCOMPARE(static_cast<int>(myMpmcRingBuffer.capacity()), 4);
+
+  // Fill the buffer and verify that it rejects further writes
+  for (int i = 1; i <= 4; ++i)
+  {
+    QVERIFY(myMpmcRingBuffer.write(i));
+  }
+  QVERIFY(myMpmcRingBuffer.isFull());
+  QVERIFY(!myMpmcRingBuffer.write(5));
+  QCOMPARE(static_cast<int>(myMpmcRingBuffer.count()), 4);
+
+  // Drain the buffer in FIFO order
+  int value;
+  for (int i = 1; i <= 4; ++i)
+  {
+    QVERIFY(myMpmcRingBuffer.read(value));
+    QCOMPARE(value, i);
+  }
+  QVERIFY(!myMpmcRingBuffer.read(value));
+  QVERIFY(myMpmcRingBuffer.isEmpty());
+}
+
+TEST_CASE(testMpmcRingBuffer, testMpmcRingBufferWrapAround)
+{
+  MEM::mpmcRingBuffer<int, 2 * sizeof(int)> myMpmcRingBuffer;
+  int                                       value;
+
+  // Cycle through the slots several times so every sequence number is reused
+  for (int i = 0; i < 20; ++i)
+  {
+    QVERIFY(myMpmcRingBuffer.write(i));
+    QVERIFY(myMpmcRingBuffer.read(value));
+    QCOMPARE(value, i);
+  }
+  QVERIFY(myMpmcRingBuffer.isEmpty());
+}
+
+TEST_CASE(testMpmcRingBuffer, testMpmcRingBufferReset)
+{
+  MEM::mpmcRingBuffer<int, 4 * sizeof(int)> myMpmcRingBuffer;
+
+  myMpmcRingBuffer.write(1);
+  myMpmcRingBuffer.write(2);
+  QVERIFY(!myMpmcRingBuffer.isEmpty());
+
+  myMpmcRingBuffer.reset();
+  QVERIFY(myMpmcRingBuffer.isEmpty());
+
+  // The buffer must be fully usable after a reset
+  int value;
+  QVERIFY(myMpmcRingBuffer.write(3));
+  QVERIFY(myMpmcRingBuffer.read(value));
+  QCOMPARE(value, 3);
+}
+
+TEST_CASE(testMpmcRingBuffer, testMpmcRingBufferConcurrentTransfer)
+{
+  static MEM::mpmcRingBuffer<uint32_t, 64 * sizeof(uint32_t)> myMpmcRingBuffer;
+  const uint32_t                                               THREAD_COUNT        = 4;
+  const uint32_t                                               ELEMENTS_PER_THREAD = 20000;
+
+  std::atomic<uint64_t> consumedSum(0);
+  std::atomic<uint32_t> consumedCount(0);
+  std::thread           producers[THREAD_COUNT];
+  std::thread           consumers[THREAD_COUNT];
+
+  for (uint32_t t = 0; t < THREAD_COUNT; ++t)
+  {
+    producers[t] = std::thread(
+      [&, t]()
+      {
+        for (uint32_t i = 0; i < ELEMENTS_PER_THREAD; ++i)
+        {
+          while (!myMpmcRingBuffer.write(t * ELEMENTS_PER_THREAD + i))
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+    consumers[t] = std::thread(
+      [&]()
+      {
+        uint32_t value;
+        while (consumedCount.load() < THREAD_COUNT * ELEMENTS_PER_THREAD)
+        {
+          if (myMpmcRingBuffer.read(value))
+          {
+            consumedSum += value;
+            ++consumedCount;
+          }
+          else
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+
+  for (uint32_t t = 0; t < THREAD_COUNT; ++t)
+  {
+    producers[t].join();
+    consumers[t].join();
+  }
+
+  // Every element must have been consumed exactly once
+  const uint64_t totalCount = static_cast<uint64_t>(THREAD_COUNT) * ELEMENTS_PER_THREAD;
+  QCOMPARE(consumedCount.load(), static_cast<uint32_t>(totalCount));
+  QCOMPARE(consumedSum.load(), totalCount * (totalCount - 1) / 2);
+  QVERIFY(myMpmcRingBuffer.isEmpty());
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testMpmcRingBuffer)
+#include "mpmc_ring_buffer_test.moc"
+#endif
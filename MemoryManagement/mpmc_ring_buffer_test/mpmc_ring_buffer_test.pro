@@ -0,0 +1,18 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle release
+
+TEMPLATE = app
+
+SOURCES +=  \
+    mpmc_ring_buffer_test.cpp \
+
+HEADERS += \
+    ../mpmc_ring_buffer.hpp \
+    ../../CoreComponents/global.hpp \
+
+INCLUDEPATH += \
+    ../../CoreComponents \
+    ../MemoryManagement \
@@ -0,0 +1,589 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     persistent_ring_buffer.hpp
+ * @version  0.1
+ * @brief    Definition of the persistentRingBuffer class.
+ * @details  The `persistentRingBuffer` class is a ring buffer for Linux hosts whose storage lives in a memory-mapped file, so
+ *           the stored elements survive a crash or restart of the process, for example as a black-box recorder. Elements are
+ *           copied into the mapping as they are; there is no serialization and no system call on the write path.
+ *
+ *           Every element is stored in a slot together with its sequence number and an xxHash checksum over both, and the
+ *           sequence number is written last. The read and write positions are only stored in the file at checkpoints, in
+ *           two alternating records that are protected by a checksum as well, so a checkpoint torn by a crash falls back to
+ *           the previous one. When the file is opened again, the newest valid checkpoint is loaded and the write position is
+ *           rolled forward over the slots that continue its sequence with a valid checksum. Only the elements written since
+ *           the last checkpoint are visited, not the whole file.
+ *
+ *           To use the `persistentRingBuffer` class, follow these steps:
+ *           -# Instantiate an instance with the desired data type and buffer size in bytes as template parameters,
+ *              like this: `persistentRingBuffer<logEntry_t, 1048576> myRecorder(RINGBUFFER_ALLOW_OVERWRITE);`.
+ *           -# Use the `open()` function to create the file, or to recover the elements of an existing one,
+ *              like this: `myRecorder.open("/var/log/recorder.bin");`.
+ *           -# Use the `write()` and `read()` functions like those of `ringBuffer`.
+ *           -# Call `checkpoint()` from time to time to store the positions, and with `true` to also flush the file to disk.
+ *           -# Call `close()` or destroy the instance when done, which stores a final checkpoint.
+ *
+ * @note     After a crash, elements that were read after the last checkpoint are returned again, since the read position is
+ *           only persisted at checkpoints. Slots that fail their checksum, e.g. after a power loss, are skipped by `read()` and
+ *           counted in `getCorruptedCount()`. Without `checkpoint(true)`, the data survives a crash of the process but not
+ *           necessarily a power loss.
+ *           `T` must be trivially copyable and must not contain pointers.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include "ring_buffer.hpp"
+#include <atomic>
+#include <cstring>
+
+#if defined(__linux__)
+// Inline xxHash privately, without changing how the including translation unit sees xxhash.h
+#if !defined(XXH_INLINE_ALL)
+#define XXH_INLINE_ALL
+#define MEM_PERSISTENT_RING_BUFFER_XXH_INLINE_ALL
+#endif
+#include "ThirdParty/xxhash.h"
+#if defined(MEM_PERSISTENT_RING_BUFFER_XXH_INLINE_ALL)
+#undef XXH_INLINE_ALL
+#undef MEM_PERSISTENT_RING_BUFFER_XXH_INLINE_ALL
+#endif
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+#if defined(__linux__)
+  /**
+   * @brief  Layout version of the file, incremented whenever the header or slot layout changes.
+   */
+  constexpr uint32_t persistentRingBufferVersion = 1;
+
+  /**
+   * @brief  Positions of a `persistentRingBuffer` at a checkpoint.
+   */
+  struct persistentRingBufferCheckpoint_t
+  {
+    uint64_t counter;       //!< Number of the checkpoint, the valid record with the highest number is the newest.
+    uint64_t readSequence;  //!< Sequence number of the oldest stored element.
+    uint64_t writeSequence; //!< Sequence number of the next element to write.
+    uint64_t checksum;      //!< xxHash of the fields above.
+  };
+
+  /**
+   * @brief    Header at the start of the file of a `persistentRingBuffer`.
+   * @details  Only fixed-width fields are used, and its size is a multiple of the cache line size, which aligns the slots.
+   */
+  struct alignas(cacheLineSize) persistentRingBufferHeader_t
+  {
+    uint32_t                              magic;          //!< Identifies a file of a `persistentRingBuffer`.
+    uint32_t                              version;        //!< Layout version of the file.
+    uint32_t                              headerSize;     //!< Size of this header in bytes, the slots start directly after it.
+    uint32_t                              elementSize;    //!< Size of a single element in bytes.
+    uint64_t                              slotSize;       //!< Size of a single slot, including sequence and checksum, in bytes.
+    uint64_t                              elementCount;   //!< Number of slots in the file.
+    MEM::persistentRingBufferCheckpoint_t checkpoints[2]; //!< Alternating checkpoint records.
+  };
+
+  /**
+   * @brief    Class template for a ring buffer whose storage and positions persist in a memory-mapped file.
+   * @details  The `bufferSize` specifies the size of the element storage in bytes, sequence numbers, checksums and the
+   *           header are stored in addition to it. The class calculates how many elements of type `T` can fit into the buffer.
+   * @tparam   T
+   *           Data type of the elements in the ring buffer, must be trivially copyable.
+   * @tparam   bufferSize
+   *           The size of the element storage in bytes.
+   */
+  template <typename T, std::size_t bufferSize>
+  class persistentRingBuffer
+  {
+  public:
+    /**
+     * @brief      Constructor that initializes an instance without a file.
+     * @param[in]  overwrite
+     *             Specifies whether to overwrite the oldest element in the buffer when it is full.
+     *             Default is `RINGBUFFER_NO_OVERWRITE`.
+     */
+    explicit persistentRingBuffer(MEM::ringBufferOverwrite_e overwrite = MEM::RINGBUFFER_NO_OVERWRITE);
+
+    /**
+     * @brief  Destructor that closes the file.
+     */
+    ~persistentRingBuffer();
+
+    // Rule of Five
+    persistentRingBuffer(const persistentRingBuffer&)            = delete;
+    persistentRingBuffer& operator=(const persistentRingBuffer&) = delete;
+    persistentRingBuffer(persistentRingBuffer&&)                 = delete;
+    persistentRingBuffer& operator=(persistentRingBuffer&&)      = delete;
+
+    /**
+     * @brief      Open a file and recover its elements, or create it if it does not exist.
+     * @param[in]  path
+     *             The path of the file.
+     * @return     `true` if the file is open, `false` if this instance already has an open file, the file cannot be created
+     *             or mapped, or an existing file has a different layout. A file with a different layout is left unchanged.
+     */
+    bool open(const char* path);
+
+    /**
+     * @brief  Store a final checkpoint, flush the file to disk and close it. Does nothing if no file is open.
+     */
+    void close();
+
+    /**
+     * @brief   Check if this instance has an open file.
+     * @return  `true` if a file is open, `false` otherwise.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief      Store the current positions in the file.
+     * @param[in]  synchronize
+     *             `true` to also wait until the file, including all elements, is written to disk. Default is `false`.
+     * @return     `true` if the checkpoint was stored (and flushed), `false` if no file is open or flushing failed.
+     */
+    bool checkpoint(bool synchronize = false);
+
+    /**
+     * @brief  Remove all elements from the ring buffer and store a checkpoint.
+     */
+    void reset();
+
+    /**
+     * @brief   Get the overwrite behavior of the ring buffer.
+     * @return  The overwrite behavior as `ringBufferOverwrite_e`.
+     */
+    MEM::ringBufferOverwrite_e getOverwriteBehavior() const;
+
+    /**
+     * @brief   Check if the ring buffer is empty.
+     * @return  `true` if the buffer is empty, `false` otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief   Check if the ring buffer is full.
+     * @return  `true` if the buffer is full, `false` otherwise.
+     */
+    bool isFull() const;
+
+    /**
+     * @brief   Get the number of elements currently stored in the ring buffer.
+     * @return  The number of elements currently stored.
+     */
+    std::size_t count() const;
+
+    /**
+     * @brief   Get the maximum number of elements that can be stored in the ring buffer.
+     * @return  The capacity of the ring buffer.
+     */
+    constexpr std::size_t capacity() const;
+
+    /**
+     * @brief   Get the number of elements that were skipped by `read()` because their checksum did not match.
+     * @return  The number of corrupted elements since the file was opened.
+     */
+    std::size_t getCorruptedCount() const;
+
+    /**
+     * @brief      Write a single element to the ring buffer.
+     * @param[in]  data
+     *             The element to be written to the buffer.
+     * @return     `true` if the data was written successfully, `false` if no file is open, or if the buffer is full and
+     *             overwriting is not allowed.
+     */
+    bool write(const T& data);
+
+    /**
+     * @brief       Read the oldest valid element from the ring buffer, skipping corrupted ones.
+     * @param[out]  data
+     *              The variable to store the read element.
+     * @return      `true` if an element was read successfully, `false` if the buffer contains no valid element.
+     */
+    bool read(T& data);
+
+    /**
+     * @brief       Peek at an element in the ring buffer without removing it.
+     * @param[out]  data
+     *              The variable to store the peeked element.
+     * @param[in]   index
+     *              The zero-based index of the element to peek at, relative to the oldest element.
+     * @return      `true` if the element was peeked successfully, `false` if the index is out of range or the element is
+     *              corrupted.
+     */
+    bool peek(T& data, std::size_t index) const;
+
+  private:
+    /**
+     * @brief  An element in the file, with the sequence number and checksum that validate it.
+     */
+    struct slot_t
+    {
+      uint64_t sequence; //!< Sequence number of the element, written last.
+      uint64_t checksum; //!< xxHash of the element, seeded with the sequence number.
+      T        data;     //!< The element.
+    };
+
+    static constexpr uint32_t    fileMagic    = 0x52505444;             //!< Marks a file of a `persistentRingBuffer` ("DTPR").
+    static constexpr std::size_t elementCount = bufferSize / sizeof(T); //!< Number of elements that can fit in the buffer.
+    static constexpr std::size_t fileSize     = sizeof(MEM::persistentRingBufferHeader_t) + elementCount * sizeof(slot_t);
+    static_assert(elementCount > 0, "Buffer size is too small to hold even one element of type T.");
+    static_assert(std::is_trivially_copyable<T>::value, "Type T must be trivially copyable.");
+    static_assert(alignof(slot_t) <= cacheLineSize, "Type T must not require a larger alignment than a cache line.");
+
+    MEM::persistentRingBufferHeader_t* m_header;           //!< Header at the start of the mapped file.
+    slot_t*                            m_slots;            //!< Slots in the mapped file, directly after the header.
+    MEM::ringBufferOverwrite_e         m_overwriteSetting; //!< Overwrite behavior when the buffer is full.
+    uint64_t                           m_readSequence;     //!< Sequence number of the oldest stored element.
+    uint64_t                           m_writeSequence;    //!< Sequence number of the next element to write.
+    uint64_t                           m_checkpointCount;  //!< Number of the newest checkpoint.
+    std::size_t                        m_corruptedCount;   //!< Number of elements skipped because of a checksum mismatch.
+
+    /**
+     * @brief  Initialize the header of a newly created file.
+     */
+    void initialize();
+
+    /**
+     * @brief   Check if the header of an existing file matches the layout of this instance.
+     * @return  `true` if the layout matches, `false` otherwise.
+     */
+    bool layoutMatches() const;
+
+    /**
+     * @brief  Load the newest valid checkpoint and roll the write position forward over the elements written after it.
+     */
+    void recover();
+
+    /**
+     * @brief      Check if a slot holds the element with a given sequence number, with a matching checksum.
+     * @param[in]  sequence
+     *             The sequence number of the element.
+     * @return     `true` if the slot of the sequence number holds a valid copy of the element, `false` otherwise.
+     */
+    bool slotValid(uint64_t sequence) const;
+
+    /**
+     * @brief      Calculate the checksum of a checkpoint record.
+     * @param[in]  record
+     *             The checkpoint record.
+     * @return     The checksum over all fields except the checksum itself.
+     */
+    static uint64_t checkpointChecksum(const MEM::persistentRingBufferCheckpoint_t& record);
+  };
+#endif
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+#if defined(__linux__)
+namespace MEM
+{
+  template <typename T, std::size_t bufferSize>
+  persistentRingBuffer<T, bufferSize>::persistentRingBuffer(MEM::ringBufferOverwrite_e overwrite) :
+    m_header(nullptr),
+    m_slots(nullptr),
+    m_overwriteSetting(overwrite),
+    m_readSequence(0),
+    m_writeSequence(0),
+    m_checkpointCount(0),
+    m_corruptedCount(0)
+  {
+  }
+
+  template <typename T, std::size_t bufferSize>
+  persistentRingBuffer<T, bufferSize>::~persistentRingBuffer()
+  {
+    close();
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool persistentRingBuffer<T, bufferSize>::open(const char* path)
+  {
+    if (isOpen())
+    {
+      return false;
+    }
+
+    const int fileDescriptor = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP);
+    if (fileDescriptor < 0)
+    {
+      return false;
+    }
+
+    struct stat status;
+    if (fstat(fileDescriptor, &status) != 0)
+    {
+      ::close(fileDescriptor);
+      return false;
+    }
+
+    const bool created   = (status.st_size == 0);
+    const bool sizeValid = created ? (ftruncate(fileDescriptor, static_cast<off_t>(fileSize)) == 0)
+                                   : (static_cast<std::size_t>(status.st_size) == fileSize);
+
+    void* mapping = sizeValid ? mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0) : MAP_FAILED;
+    ::close(fileDescriptor);
+    if (mapping == MAP_FAILED)
+    {
+      return false;
+    }
+
+    m_header = static_cast<MEM::persistentRingBufferHeader_t*>(mapping);
+    m_slots  = reinterpret_cast<slot_t*>(static_cast<uint8_t*>(mapping) + sizeof(MEM::persistentRingBufferHeader_t));
+    if (created)
+    {
+      initialize();
+    }
+    else if (layoutMatches())
+    {
+      recover();
+    }
+    else
+    {
+      munmap(mapping, fileSize);
+      m_header = nullptr;
+      m_slots  = nullptr;
+      return false;
+    }
+
+    m_corruptedCount = 0;
+    return checkpoint(created);
+  }
+
+  template <typename T, std::size_t bufferSize>
+  void persistentRingBuffer<T, bufferSize>::close()
+  {
+    if (!isOpen())
+    {
+      return;
+    }
+
+    checkpoint(true);
+    munmap(m_header, fileSize);
+    m_header = nullptr;
+    m_slots  = nullptr;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool persistentRingBuffer<T, bufferSize>::isOpen() const
+  {
+    return m_header != nullptr;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool persistentRingBuffer<T, bufferSize>::checkpoint(bool synchronize)
+  {
+    if (!isOpen())
+    {
+      return false;
+    }
+
+    // Overwrite the older record, so the newer one stays valid if this one is torn
+    ++m_checkpointCount;
+    MEM::persistentRingBufferCheckpoint_t& record = m_header->checkpoints[m_checkpointCount % 2];
+    record.counter                                = m_checkpointCount;
+    record.readSequence                           = m_readSequence;
+    record.writeSequence                          = m_writeSequence;
+    record.checksum                               = checkpointChecksum(record);
+
+    if (synchronize)
+    {
+      return msync(m_header, fileSize, MS_SYNC) == 0;
+    }
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  void persistentRingBuffer<T, bufferSize>::reset()
+  {
+    // The sequence numbers keep increasing, so the slots of the dropped elements can never be taken for new ones
+    m_readSequence = m_writeSequence;
+    checkpoint();
+  }
+
+  template <typename T, std::size_t bufferSize>
+  MEM::ringBufferOverwrite_e persistentRingBuffer<T, bufferSize>::getOverwriteBehavior() const
+  {
+    return m_overwriteSetting;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool persistentRingBuffer<T, bufferSize>::isEmpty() const
+  {
+    return m_readSequence == m_writeSequence;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool persistentRingBuffer<T, bufferSize>::isFull() const
+  {
+    return count() == elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t persistentRingBuffer<T, bufferSize>::count() const
+  {
+    return static_cast<std::size_t>(m_writeSequence - m_readSequence);
+  }
+
+  template <typename T, std::size_t bufferSize>
+  constexpr std::size_t persistentRingBuffer<T, bufferSize>::capacity() const
+  {
+    return elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t persistentRingBuffer<T, bufferSize>::getCorruptedCount() const
+  {
+    return m_corruptedCount;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool persistentRingBuffer<T, bufferSize>::write(const T& data)
+  {
+    if (!isOpen())
+    {
+      return false;
+    }
+    if (isFull())
+    {
+      if (m_overwriteSetting != MEM::RINGBUFFER_ALLOW_OVERWRITE)
+      {
+        return false;
+      }
+      ++m_readSequence;
+    }
+
+    slot_t& slot  = m_slots[m_writeSequence % elementCount];
+    slot.data     = data;
+    slot.checksum = XXH64(&slot.data, sizeof(T), m_writeSequence);
+    // The slot only becomes part of the sequence once the element and checksum are in place
+    std::atomic_signal_fence(std::memory_order_release);
+    slot.sequence = m_writeSequence;
+    ++m_writeSequence;
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool persistentRingBuffer<T, bufferSize>::read(T& data)
+  {
+    while (!isEmpty())
+    {
+      const bool valid = slotValid(m_readSequence);
+      if (valid)
+      {
+        data = m_slots[m_readSequence % elementCount].data;
+      }
+      else
+      {
+        ++m_corruptedCount;
+      }
+      ++m_readSequence;
+
+      if (valid)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool persistentRingBuffer<T, bufferSize>::peek(T& data, std::size_t index) const
+  {
+    if (index >= count() || !slotValid(m_readSequence + index))
+    {
+      return false;
+    }
+    data = m_slots[(m_readSequence + index) % elementCount].data;
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  void persistentRingBuffer<T, bufferSize>::initialize()
+  {
+    m_header->version      = MEM::persistentRingBufferVersion;
+    m_header->headerSize   = static_cast<uint32_t>(sizeof(MEM::persistentRingBufferHeader_t));
+    m_header->elementSize  = static_cast<uint32_t>(sizeof(T));
+    m_header->slotSize     = sizeof(slot_t);
+    m_header->elementCount = elementCount;
+    m_header->magic        = fileMagic;
+
+    m_readSequence    = 0;
+    m_writeSequence   = 0;
+    m_checkpointCount = 0;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool persistentRingBuffer<T, bufferSize>::layoutMatches() const
+  {
+    return (m_header->magic == fileMagic) && (m_header->version == MEM::persistentRingBufferVersion) &&
+           (m_header->headerSize == sizeof(MEM::persistentRingBufferHeader_t)) && (m_header->elementSize == sizeof(T)) &&
+           (m_header->slotSize == sizeof(slot_t)) && (m_header->elementCount == elementCount);
+  }
+
+  template <typename T, std::size_t bufferSize>
+  void persistentRingBuffer<T, bufferSize>::recover()
+  {
+    m_readSequence    = 0;
+    m_writeSequence   = 0;
+    m_checkpointCount = 0;
+    for (const MEM::persistentRingBufferCheckpoint_t& record : m_header->checkpoints)
+    {
+      if ((record.checksum == checkpointChecksum(record)) && (record.counter >= m_checkpointCount))
+      {
+        m_readSequence    = record.readSequence;
+        m_writeSequence   = record.writeSequence;
+        m_checkpointCount = record.counter;
+      }
+    }
+
+    // Only the elements written after the checkpoint are visited. A slot that holds a later sequence number than expected
+    // was written again on a later lap, and continuing from it skips the laps in between.
+    for (;;)
+    {
+      const uint64_t sequence = m_slots[m_writeSequence % elementCount].sequence;
+      if ((sequence < m_writeSequence) || !slotValid(sequence))
+      {
+        break;
+      }
+      m_writeSequence = sequence + 1;
+    }
+    if (count() > elementCount)
+    {
+      m_readSequence = m_writeSequence - elementCount;
+    }
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool persistentRingBuffer<T, bufferSize>::slotValid(uint64_t sequence) const
+  {
+    const slot_t& slot = m_slots[sequence % elementCount];
+    return (slot.sequence == sequence) && (slot.checksum == XXH64(&slot.data, sizeof(T), sequence));
+  }
+
+  template <typename T, std::size_t bufferSize>
+  uint64_t persistentRingBuffer<T, bufferSize>::checkpointChecksum(const MEM::persistentRingBufferCheckpoint_t& record)
+  {
+    return XXH64(&record, offsetof(MEM::persistentRingBufferCheckpoint_t, checksum), fileMagic);
+  }
+
+} // namespace MEM
+#endif
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
@@ -0,0 +1,272 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../persistent_ring_buffer.hpp"
+
+#if defined(__linux__)
+#include <sys/wait.h>
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class testPersistentRingBuffer : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testPersistentRingBufferWriteRead();
+  void testPersistentRingBufferReopen();
+  void testPersistentRingBufferCrashRecovery();
+  void testPersistentRingBufferCorruptedElement();
+  void testPersistentRingBufferLayoutMismatch();
+};
+#endif
+
+#if defined(__linux__)
+namespace
+{
+  /**
+   * @brief  A log entry as recorded by a flight recorder.
+   */
+  struct logEntry_t
+  {
+    uint32_t timestamp; //!< Time of the entry.
+    uint32_t value;     //!< Recorded value.
+  };
+
+  /**
+   * @brief      Build a file path that is unique for the test process and remove any file left at it.
+   * @param[in]  suffix
+   *             Distinguishes the files of the test cases.
+   * @return     The file path.
+   */
+  std::string filePath(const char* suffix)
+  {
+    const std::string path = "/tmp/device_t_test_" + std::to_string(getpid()) + "_" + suffix + ".bin";
+    unlink(path.c_str());
+    return path;
+  }
+
+  /**
+   * @brief      Write entries in a child process that terminates without closing the file, like a crash.
+   * @param[in]  path
+   *             The path of the file.
+   * @param[in]  first
+   *             The value of the first entry to write.
+   * @param[in]  count
+   *             The number of entries to write.
+   * @return     `true` if the child process wrote all entries, `false` otherwise.
+   */
+  template <typename buffer_t>
+  bool writeAndCrash(const std::string& path, uint32_t first, uint32_t count)
+  {
+    const pid_t child = fork();
+    if (child == 0)
+    {
+      buffer_t* recorder = new buffer_t(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+      if (!recorder->open(path.c_str()))
+      {
+        _exit(2);
+      }
+      for (uint32_t i = first; i < first + count; ++i)
+      {
+        recorder->write(logEntry_t{i, i * 10});
+      }
+      // Neither close() nor the destructor run
+      _exit(0);
+    }
+
+    int status = -1;
+    return (child > 0) && (waitpid(child, &status, 0) == child) && WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+  }
+} // namespace
+#endif
+
+TEST_CASE(testPersistentRingBuffer, testPersistentRingBufferWriteRead)
+{
+#if defined(__linux__)
+  const std::string                                             PATH  = filePath("write_read");
+  MEM::persistentRingBuffer<logEntry_t, 4 * sizeof(logEntry_t)> recorder;
+  logEntry_t                                                    entry = {};
+
+  QVERIFY(!recorder.write(entry));
+  QVERIFY(recorder.open(PATH.c_str()));
+  QVERIFY(!recorder.open(PATH.c_str()));
+  QVERIFY(recorder.isEmpty());
+  QCOMPARE(static_cast<int>(recorder.capacity()), 4);
+
+  for (uint32_t i = 0; i < 4; ++i)
+  {
+    QVERIFY(recorder.write(logEntry_t{i, i * 10}));
+  }
+  QVERIFY(recorder.isFull());
+  QVERIFY(!recorder.write(entry));
+
+  QVERIFY(recorder.peek(entry, 3));
+  QCOMPARE(entry.value, 30u);
+  QVERIFY(!recorder.peek(entry, 4));
+  QVERIFY(recorder.read(entry));
+  QCOMPARE(entry.timestamp, 0u);
+  QCOMPARE(static_cast<int>(recorder.count()), 3);
+
+  recorder.reset();
+  QVERIFY(recorder.isEmpty());
+  QVERIFY(!recorder.read(entry));
+  recorder.close();
+  QVERIFY(!recorder.isOpen());
+  unlink(PATH.c_str());
+#endif
+}
+
+TEST_CASE(testPersistentRingBuffer, testPersistentRingBufferReopen)
+{
+#if defined(__linux__)
+  using recorder_t = MEM::persistentRingBuffer<logEntry_t, 8 * sizeof(logEntry_t)>;
+  const std::string PATH  = filePath("reopen");
+  logEntry_t        entry = {};
+
+  {
+    recorder_t recorder(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+    QVERIFY(recorder.open(PATH.c_str()));
+    for (uint32_t i = 0; i < 12; ++i)
+    {
+      QVERIFY(recorder.write(logEntry_t{i, i * 10}));
+    }
+    QVERIFY(recorder.read(entry));
+    QCOMPARE(entry.timestamp, 4u);
+  }
+
+  // The destructor stored the positions, so the read element stays consumed
+  recorder_t recorder;
+  QVERIFY(recorder.open(PATH.c_str()));
+  QCOMPARE(static_cast<int>(recorder.count()), 7);
+  for (uint32_t i = 5; i < 12; ++i)
+  {
+    QVERIFY(recorder.read(entry));
+    QCOMPARE(entry.timestamp, i);
+    QCOMPARE(entry.value, i * 10);
+  }
+  QVERIFY(recorder.isEmpty());
+
+  // New elements continue the sequence of the recovered ones
+  QVERIFY(recorder.write(logEntry_t{12, 120}));
+  QVERIFY(recorder.read(entry));
+  QCOMPARE(entry.timestamp, 12u);
+  recorder.close();
+  unlink(PATH.c_str());
+#endif
+}
+
+TEST_CASE(testPersistentRingBuffer, testPersistentRingBufferCrashRecovery)
+{
+#if defined(__linux__)
+  using recorder_t = MEM::persistentRingBuffer<logEntry_t, 16 * sizeof(logEntry_t)>;
+  const std::string PATH  = filePath("crash");
+  logEntry_t        entry = {};
+
+  // Only the checkpoint of open() exists, all elements are found by rolling forward
+  QVERIFY(writeAndCrash<recorder_t>(PATH, 0, 10));
+  {
+    recorder_t recorder;
+    QVERIFY(recorder.open(PATH.c_str()));
+    QCOMPARE(static_cast<int>(recorder.count()), 10);
+    QVERIFY(recorder.peek(entry, 9));
+    QCOMPARE(entry.timestamp, 9u);
+  }
+
+  // Wrapping around several times after the last checkpoint keeps the newest elements
+  QVERIFY(writeAndCrash<recorder_t>(PATH, 10, 40));
+  recorder_t recorder;
+  QVERIFY(recorder.open(PATH.c_str()));
+  QCOMPARE(static_cast<int>(recorder.count()), 16);
+  for (uint32_t i = 34; i < 50; ++i)
+  {
+    QVERIFY(recorder.read(entry));
+    QCOMPARE(entry.timestamp, i);
+  }
+  QCOMPARE(static_cast<int>(recorder.getCorruptedCount()), 0);
+  recorder.close();
+  unlink(PATH.c_str());
+#endif
+}
+
+TEST_CASE(testPersistentRingBuffer, testPersistentRingBufferCorruptedElement)
+{
+#if defined(__linux__)
+  using recorder_t = MEM::persistentRingBuffer<logEntry_t, 4 * sizeof(logEntry_t)>;
+  const std::string PATH  = filePath("corrupted");
+  logEntry_t        entry = {};
+
+  {
+    recorder_t recorder;
+    QVERIFY(recorder.open(PATH.c_str()));
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+      QVERIFY(recorder.write(logEntry_t{i, i * 10}));
+    }
+  }
+
+  // Flip a bit in the value of the last element, which is stored at the end of the file
+  const int fileDescriptor = open(PATH.c_str(), O_RDWR);
+  QVERIFY(fileDescriptor >= 0);
+  const off_t fileEnd = lseek(fileDescriptor, 0, SEEK_END);
+  uint8_t     value   = 0;
+  QVERIFY(pread(fileDescriptor, &value, 1, fileEnd - 1) == 1);
+  value ^= 0x01;
+  QVERIFY(pwrite(fileDescriptor, &value, 1, fileEnd - 1) == 1);
+  close(fileDescriptor);
+
+  recorder_t recorder;
+  QVERIFY(recorder.open(PATH.c_str()));
+  QCOMPARE(static_cast<int>(recorder.count()), 4);
+  QVERIFY(!recorder.peek(entry, 3));
+  for (uint32_t i = 0; i < 3; ++i)
+  {
+    QVERIFY(recorder.read(entry));
+    QCOMPARE(entry.timestamp, i);
+  }
+  QVERIFY(!recorder.read(entry));
+  QCOMPARE(static_cast<int>(recorder.getCorruptedCount()), 1);
+  recorder.close();
+  unlink(PATH.c_str());
+#endif
+}
+
+TEST_CASE(testPersistentRingBuffer, testPersistentRingBufferLayoutMismatch)
+{
+#if defined(__linux__)
+  const std::string PATH = filePath("layout");
+  {
+    MEM::persistentRingBuffer<uint64_t, 256> recorder;
+    QVERIFY(recorder.open(PATH.c_str()));
+    QVERIFY(recorder.write(42));
+  }
+
+  // Same file size, different element type
+  MEM::persistentRingBuffer<uint32_t, 128> otherType;
+  QVERIFY(!otherType.open(PATH.c_str()));
+  QVERIFY(!otherType.isOpen());
+
+  // Different file size
+  MEM::persistentRingBuffer<uint64_t, 128> otherSize;
+  QVERIFY(!otherSize.open(PATH.c_str()));
+
+  // The file was left unchanged
+  MEM::persistentRingBuffer<uint64_t, 256> recorder;
+  uint64_t                                 value = 0;
+  QVERIFY(recorder.open(PATH.c_str()));
+  QVERIFY(recorder.read(value));
+  QCOMPARE(value, static_cast<uint64_t>(42));
+  recorder.close();
+  unlink(PATH.c_str());
+#endif
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testPersistentRingBuffer)
+#include "persistent_ring_buffer_test.moc"
+#endif
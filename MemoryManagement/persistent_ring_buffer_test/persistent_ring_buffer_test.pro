@@ -0,0 +1,21 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle release
+
+TEMPLATE = app
+
+SOURCES +=  \
+    persistent_ring_buffer_test.cpp \
+
+HEADERS += \
+    ../persistent_ring_buffer.hpp \
+    ../ring_buffer.hpp \
+    ../memory_span.hpp \
+    ../ThirdParty/xxhash.h \
+    ../../CoreComponents/global.hpp \
+
+INCLUDEPATH += \
+    ../../CoreComponents \
+    ../MemoryManagement \
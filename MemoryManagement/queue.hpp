@@ -4,8 +4,8 @@
 \*************************************************************************/
 /**
  * @file     queue.hpp
- * @version  0.1
- * @brief    Definition of FIFO and LIFO queue classes with iterator support.
+ * @version  0.11
+ * @brief    Definition of FIFO, LIFO, double-ended and priority queue classes with iterator support.
  * @details  This file provides template implementations for statically allocated
  *           FIFO (First-In-First-Out) and LIFO (Last-In-First-Out) queues with
  *           support for iterators to enable range-based for loops.
@@ -15,24 +15,60 @@
  * @note     **Thread Safety Note:**
  *           Iterating over the queue is **not thread-safe**. If the queue can be modified
  *           by other threads during iteration, external synchronization is required.
+ *           To inspect a queue that other threads keep modifying, take a snapshot instead: `snapshot()` copies the queued
+ *           elements into a caller buffer, and `queueSnapshot::capture()` into a view that can be iterated like the queue.
+ *           The queue is only locked while the elements are copied, so producers and consumers are never held up by a slow
+ *           inspector walking the copy.
  *
  *           **Usage Instructions:**
  *           - Instantiate a queue with the desired data type and size:
  *             - `fifoQueue<int, 64> myFifoQueue;`
  *             - `lifoQueue<float, 128> myLifoQueue;`
  *           - Use `push()` to add elements and `pop()` to remove elements.
+ *           - Use `emplace()` to construct an element directly inside the queue from its constructor arguments.
  *           - Use range-based for loops to iterate over elements:
  *             - `for (const auto& item : myFifoQueue) { // process item }`
  *             - Or simply:
  *               `for (const auto& item : myFifoQueue) { ... }`
  *           - Check the return value of `push()` and `pop()` to determine success or failure.
+ *           - Use `pushN()`, `popN()` and `drainTo()` to move many elements at once. They lock the queue only once, and
+ *             trivially copyable elements are copied with `memcpy`.
+ *           - Use `dequeQueue<T, N>` to add and remove elements at both ends with `pushFront()`, `pushBack()`, `popFront()`
+ *             and `popBack()`, and to access them by position. `spans()` exposes the elements as at most two contiguous runs
+ *             for bulk copies, after which `releaseFront()` removes them.
+ *           - Use `priorityQueue<T, N, compare_t>` to always pop the element with the highest priority, like the earliest
+ *             deadline. Keep the handle from `push(item, handle)` to raise the priority of a queued element with
+ *             `decreaseKey()`, and use `heapify()` to add many elements at once.
+ *           - Use `popWait()` on a `fifoQueue` to sleep until an element arrives instead of polling `pop()`.
+ *             With `setWakeupThreshold()` the sleeping consumer is only woken once a batch of elements is queued.
+ *           - Construct a `fifoQueue` with `QUEUE_REJECT` to reject new elements when it is full instead of
+ *             overwriting the oldest one. `pushWait()` then sleeps until there is space, which gives the producers backpressure.
+ *           - Call `close()` on a `fifoQueue` to shut it down: new elements are rejected, all waiting threads are woken, and
+ *             the consumers drain the remaining elements before `popWait()` fails.
  *
  *           **Template Parameters:**
  *           - `T`: The type of elements stored in the queue.
  *           - `queueSize`: The fixed size of the queue.
+ *           - `lock_t`: The lock policy from `lock_policy.hpp`, `mutexLock` by default. Use `noLock` for a queue that is only
+ *             accessed by a single thread, which removes all locking, or `spinLock` for short critical sections on multi-core
+ *             systems.
+ *
+ *           **Lock-free FIFO:**
+ *           A `fifoQueue` with `lockFreeSpsc` or `lockFreeMpsc` as lock policy is built on `spscRingBuffer` or
+ *           `mpmcRingBuffer` instead, so pushing and popping never blocks. It provides `push()`, `emplace()`, `pop()`,
+ *           `isEmpty()`, `isFull()` and `size()`. Unlike the locking variants it rejects new elements when it is full instead
+ *           of overwriting the oldest one, and it cannot be iterated. `T` must be default constructible and copy assignable.
+ *           With `lockFreeMpsc` the queue size must be a power of two.
+ *
+ *           `push()` and `pop()` are not virtual: `queueBase` calls the FIFO or LIFO implementation through its template
+ *           parameter (CRTP), so they can be inlined into the calling loop. Code that handles any FIFO or LIFO queue therefore
+ *           is a template itself, taking the queue or its `queueBase` with the derived queue as template argument.
  *
  *           The queue size (`queueSize`) must be greater than zero.
  *           If it is zero, a compile-time error will occur.
+ *           When the queue size is a power of two, indices wrap with a mask instead of a modulo.
+ *           The storage is left uninitialized: elements are constructed in place when pushed and destroyed when popped,
+ *           overwritten or when the queue is destroyed. `T` therefore does not need a default constructor and may be move-only.
  */
 
 /*************************************************************************\
@@ -40,55 +76,75 @@
 \*************************************************************************/
 #pragma once
 #include "global.hpp"
+#include "lock_policy.hpp"
+#include "memory_span.hpp"
+#include "mpmc_ring_buffer.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "wait_point.hpp"
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <utility>
 
 namespace MEM
 {
   /**
-   * @brief    Abstract base class for a statically allocated queue.
-   * @details  Provides a common interface and shared logic for FIFO and LIFO queues.
+   * @brief  Enumeration type for specifying the behavior of a `fifoQueue` when an element is added while it is full.
+   */
+  enum queueOverflow_e
+  {
+    QUEUE_DROP_OLDEST, //!< Remove the oldest element in the queue to make room for the new one.
+    QUEUE_REJECT       //!< Reject the new element, which lets `pushWait()` block until there is space.
+  };
+
+  template <typename T, size_t queueSize>
+  class queueSnapshot;
+
+  /**
+   * @brief    Base class for a statically allocated queue, using static polymorphism.
+   * @details  Provides a common interface and shared logic for FIFO and LIFO queues. The derived queue is passed as template
+   *           parameter (CRTP), so `push()` and `pop()` call the FIFO or LIFO implementation directly instead of through
+   *           virtual functions, which allows them to be inlined. Like the ring buffers, the queues do not derive from
+   *           `baseClass`, so they have no virtual functions and no vtable pointer at all.
+   * @tparam   derived_t  The derived queue class, which provides `emplace()` and `popElement()`.
    * @tparam   T          The type of elements stored in the queue.
    * @tparam   queueSize  The fixed size of the queue.
+   * @tparam   lock_t     The lock policy that protects the queue.
    */
-  template <typename T, size_t queueSize>
-  class queueBase : public baseClass
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  class queueBase
   {
   public:
     static_assert(queueSize > 0, "queueSize must be greater than zero");
 
-    /**
-     * @brief  Constructor to initialize the queue.
-     */
-    queueBase();
-
     // Rule of Five
     queueBase(const queueBase&) = delete;
     queueBase& operator=(const queueBase&) = delete;
     queueBase(queueBase&&) = delete;
     queueBase& operator=(queueBase&&) = delete;
-    virtual ~queueBase() = default;
 
     /**
      * @brief      Adds an element to the queue.
      * @param[in]  item  The item to be added.
      * @return     `true` if the item was added successfully, `false` otherwise.
-     * @note       This function must be implemented by derived classes (FIFO/LIFO).
+     * @note       Requires a copy constructible `T`, use the move overload for move-only types.
      */
-    virtual bool push(const T& item) = 0;
+    bool push(const T& item);
 
     /**
      * @brief      Adds an element to the queue (move semantics).
      * @param[in]  item  The item to be added.
      * @return     `true` if the item was added successfully, `false` otherwise.
-     * @note       This function must be implemented by derived classes (FIFO/LIFO).
      */
-    virtual bool push(T&& item) = 0;
+    bool push(T&& item);
 
     /**
      * @brief       Removes an element from the queue.
      * @param[out]  item  A reference to store the popped item.
      * @return      `true` if the item was removed successfully, `false` if the queue is empty.
      */
-    virtual bool pop(T& item) = 0;
+    bool pop(T& item);
 
     /**
      * @brief   Checks if the queue is empty.
@@ -108,6 +164,16 @@ namespace MEM
      */
     size_t size() const;
 
+    /**
+     * @brief       Copies the queued elements into an array in iteration order, without removing them.
+     * @details     The copy is a consistent view of the queue at one point in time. The queue is only locked for the copy
+     *              itself, which takes at most two `memcpy` calls for trivially copyable `T`. `T` must be copy assignable.
+     * @param[out]  data   The array to store the copies.
+     * @param[in]   count  The maximum number of elements to copy.
+     * @return      The number of elements copied, which is less than the queue size if `count` is smaller.
+     */
+    size_t snapshot(T data[], size_t count) const;
+
     // Iterator support
     class iterator;
     iterator begin();
@@ -118,12 +184,44 @@ namespace MEM
     const_iterator end() const;
 
   protected:
-    T      m_data[queueSize]; //!< Statically allocated array for storage
-    size_t m_head;            //!< The index of the head (for FIFO dequeue)
-    size_t m_tail;            //!< The index of the tail (for FIFO enqueue or LIFO push)
-    size_t m_currentSize;     //!< Number of elements currently in the queue
+    /**
+     * @brief  Constructor to initialize the queue.
+     */
+    queueBase();
+
+    /**
+     * @brief  Destructor that destroys the elements still stored in the queue.
+     */
+    ~queueBase();
+
+    alignas(T) unsigned char m_data[queueSize * sizeof(T)]; //!< Uninitialized storage, elements are constructed in place
+    size_t                   m_head;                         //!< The index of the head (for FIFO dequeue)
+    size_t                   m_tail;                         //!< The index of the tail (for FIFO enqueue or LIFO push)
+    size_t                   m_currentSize;                  //!< Number of elements currently in the queue
+
+    mutable lock_t m_lock; //!< Lock policy for thread safety
+
+    /**
+     * @brief      Gets the element constructed at an index.
+     * @param[in]  index  The index, which must hold a constructed element.
+     * @return     Pointer to the element.
+     */
+    T*       element(size_t index);
+    const T* element(size_t index) const;
+
+    /**
+     * @brief      Constructs an element in place at an index that holds no element.
+     * @param[in]  index  The index to construct the element at.
+     * @param[in]  args   The arguments forwarded to the constructor of `T`.
+     */
+    template <typename... Args>
+    void construct(size_t index, Args&&... args);
 
-    mutable std::mutex m_mutex; //!< Mutex for thread safety
+    /**
+     * @brief      Destroys the element at an index.
+     * @param[in]  index  The index, which must hold a constructed element.
+     */
+    void destroy(size_t index);
 
     /**
      * @brief      Increments an index circularly.
@@ -138,11 +236,65 @@ namespace MEM
      * @return     The decremented index, wrapping around if necessary.
      */
     size_t decrementIndex(size_t index) const;
+
+    /**
+     * @brief      Advances an index circularly by several steps.
+     * @param[in]  index  The index to advance.
+     * @param[in]  steps  The number of steps, at most `queueSize`.
+     * @return     The advanced index, wrapping around if necessary.
+     */
+    size_t advanceIndex(size_t index, size_t steps) const;
+
+    /**
+     * @brief      Copy constructs elements at consecutive indices that hold no element, wrapping around if necessary.
+     * @details    For trivially copyable `T` the elements are copied with at most two `memcpy` calls.
+     * @param[in]  index  The index of the first element.
+     * @param[in]  data   The array of elements to copy.
+     * @param[in]  count  The number of elements, at most `queueSize`.
+     */
+    void constructRange(size_t index, const T data[], size_t count);
+
+    /**
+     * @brief       Copies the elements at consecutive indices into an array, wrapping around if necessary.
+     * @details     For trivially copyable `T` the elements are copied with at most two `memcpy` calls.
+     * @param[in]   index  The index of the first element.
+     * @param[out]  data   The array to store the copies.
+     * @param[in]   count  The number of elements, which must all be constructed.
+     */
+    void copyRange(size_t index, T data[], size_t count) const;
+
+    /**
+     * @brief       Moves the elements at consecutive indices into an array and destroys them, wrapping around if necessary.
+     * @details     For trivially copyable `T` the elements are copied with at most two `memcpy` calls.
+     * @param[in]   index  The index of the first element.
+     * @param[out]  data   The array to store the elements.
+     * @param[in]   count  The number of elements, which must all be constructed.
+     */
+    void takeRange(size_t index, T data[], size_t count);
+
+    /**
+     * @brief      Destroys the elements at consecutive indices, wrapping around if necessary.
+     * @param[in]  index  The index of the first element.
+     * @param[in]  count  The number of elements, which must all be constructed.
+     */
+    void destroyRange(size_t index, size_t count);
+
+  private:
+    friend class queueSnapshot<T, queueSize>;
+
+    /**
+     * @brief       Copy constructs the queued elements in iteration order into uninitialized storage, called by
+     *              `queueSnapshot::capture()`.
+     * @param[out]  storage  The storage to construct the copies in.
+     * @param[in]   count    The maximum number of elements to copy.
+     * @return      The number of elements copied.
+     */
+    size_t snapshotConstruct(T storage[], size_t count) const;
   };
 
   // Iterator Implementation
-  template <typename T, size_t queueSize>
-  class queueBase<T, queueSize>::iterator
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  class queueBase<derived_t, T, queueSize, lock_t>::iterator
   {
   public:
     using iterator_category = std::forward_iterator_tag;
@@ -151,19 +303,19 @@ namespace MEM
     using pointer           = T*;
     using reference         = T&;
 
-    iterator(queueBase<T, queueSize>* queue, size_t index, size_t count)
+    iterator(queueBase<derived_t, T, queueSize, lock_t>* queue, size_t index, size_t count)
       : m_queue(queue), m_index(index), m_count(count)
     {
     }
 
     reference operator*()
     {
-      return m_queue->m_data[m_index];
+      return *m_queue->element(m_index);
     }
 
     pointer operator->()
     {
-      return &(m_queue->m_data[m_index]);
+      return m_queue->element(m_index);
     }
 
     iterator& operator++()
@@ -191,26 +343,26 @@ namespace MEM
     }
 
   private:
-    queueBase<T, queueSize>* m_queue;
-    size_t                   m_index;
-    size_t                   m_count;
+    queueBase<derived_t, T, queueSize, lock_t>* m_queue;
+    size_t                                      m_index;
+    size_t                                      m_count;
   };
 
-  template <typename T, size_t queueSize>
-  typename queueBase<T, queueSize>::iterator queueBase<T, queueSize>::begin()
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  typename queueBase<derived_t, T, queueSize, lock_t>::iterator queueBase<derived_t, T, queueSize, lock_t>::begin()
   {
     return iterator(this, m_head, 0);
   }
 
-  template <typename T, size_t queueSize>
-  typename queueBase<T, queueSize>::iterator queueBase<T, queueSize>::end()
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  typename queueBase<derived_t, T, queueSize, lock_t>::iterator queueBase<derived_t, T, queueSize, lock_t>::end()
   {
     return iterator(this, m_tail, m_currentSize);
   }
 
   // Const Iterator Implementation
-  template <typename T, size_t queueSize>
-  class queueBase<T, queueSize>::const_iterator
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  class queueBase<derived_t, T, queueSize, lock_t>::const_iterator
   {
   public:
     using iterator_category = std::forward_iterator_tag;
@@ -219,19 +371,19 @@ namespace MEM
     using pointer           = const T*;
     using reference         = const T&;
 
-    const_iterator(const queueBase<T, queueSize>* queue, size_t index, size_t count)
+    const_iterator(const queueBase<derived_t, T, queueSize, lock_t>* queue, size_t index, size_t count)
       : m_queue(queue), m_index(index), m_count(count)
     {
     }
 
     reference operator*() const
     {
-      return m_queue->m_data[m_index];
+      return *m_queue->element(m_index);
     }
 
     pointer operator->() const
     {
-      return &(m_queue->m_data[m_index]);
+      return m_queue->element(m_index);
     }
 
     const_iterator& operator++()
@@ -259,227 +411,1836 @@ namespace MEM
     }
 
   private:
-    const queueBase<T, queueSize>* m_queue;
-    size_t                         m_index;
-    size_t                         m_count;
+    const queueBase<derived_t, T, queueSize, lock_t>* m_queue;
+    size_t                                            m_index;
+    size_t                                            m_count;
   };
 
-  template <typename T, size_t queueSize>
-  typename queueBase<T, queueSize>::const_iterator queueBase<T, queueSize>::begin() const
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  typename queueBase<derived_t, T, queueSize, lock_t>::const_iterator queueBase<derived_t, T, queueSize, lock_t>::begin() const
   {
     return const_iterator(this, m_head, 0);
   }
 
-  template <typename T, size_t queueSize>
-  typename queueBase<T, queueSize>::const_iterator queueBase<T, queueSize>::end() const
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  typename queueBase<derived_t, T, queueSize, lock_t>::const_iterator queueBase<derived_t, T, queueSize, lock_t>::end() const
   {
     return const_iterator(this, m_tail, m_currentSize);
   }
 
+  /**
+   * @brief    Fixed-capacity copy of the elements of a queue, taken at one point in time.
+   * @details  Lets a monitoring thread iterate over a queue that other threads keep modifying: `capture()` copies the
+   *           elements while the queue is locked, and the iteration afterwards only touches the copy. The snapshot can be
+   *           reused for every capture, so it does not allocate memory. Like the queues, the snapshot leaves its storage
+   *           uninitialized and only constructs the copies, so `T` must be copy constructible but not default constructible.
+   * @tparam   T          The type of elements stored in the queue.
+   * @tparam   queueSize  The fixed size of the queues that are captured.
+   */
+  template <typename T, size_t queueSize>
+  class queueSnapshot
+  {
+  public:
+    /**
+     * @brief  Constructor that initializes an empty snapshot.
+     */
+    queueSnapshot() : m_size(0) {}
+
+    // Rule of Five
+    queueSnapshot(const queueSnapshot&)            = delete;
+    queueSnapshot& operator=(const queueSnapshot&) = delete;
+    queueSnapshot(queueSnapshot&&)                 = delete;
+    queueSnapshot& operator=(queueSnapshot&&)      = delete;
+
+    /**
+     * @brief  Destructor that destroys the copies.
+     */
+    ~queueSnapshot()
+    {
+      clear();
+    }
+
+    /**
+     * @brief      Replaces the snapshot with a copy of the elements of a queue.
+     * @param[in]  queue  The `fifoQueue`, `lifoQueue`, `priorityQueue` or `dequeQueue` to copy, which may be modified by
+     *                    other threads.
+     * @return     The number of elements copied.
+     */
+    template <typename derived_t, typename lock_t>
+    size_t capture(const queueBase<derived_t, T, queueSize, lock_t>& queue)
+    {
+      clear();
+      m_size = queue.snapshotConstruct(reinterpret_cast<T*>(m_data), queueSize);
+      return m_size;
+    }
+
+    /**
+     * @brief   Retrieves the number of elements in the snapshot.
+     * @return  The number of elements that were queued at the time of the capture.
+     */
+    size_t size() const
+    {
+      return m_size;
+    }
+
+    /**
+     * @brief   Checks if the snapshot is empty.
+     * @return  `true` if the queue was empty at the time of the capture, `false` otherwise.
+     */
+    bool isEmpty() const
+    {
+      return m_size == 0;
+    }
+
+    /**
+     * @brief      Accesses a copied element by its position in the iteration order of the queue.
+     * @param[in]  index  The position, which must be less than `size()`.
+     * @return     A reference to the copy.
+     */
+    const T& operator[](size_t index) const
+    {
+      return elements()[index];
+    }
+
+    // Iterator support, in the iteration order of the queue
+    const T* begin() const
+    {
+      return elements();
+    }
+
+    const T* end() const
+    {
+      return elements() + m_size;
+    }
+
+  private:
+    /**
+     * @brief  Destroys the copies and empties the snapshot.
+     */
+    void clear()
+    {
+      if constexpr (!std::is_trivially_destructible<T>::value)
+      {
+        for (size_t i = 0; i < m_size; ++i)
+        {
+          elements()[i].~T();
+        }
+      }
+      m_size = 0;
+    }
+
+    /**
+     * @brief   Gets the copied elements.
+     * @return  Pointer to the first copy.
+     */
+    const T* elements() const
+    {
+      return std::launder(reinterpret_cast<const T*>(m_data));
+    }
+
+    T* elements()
+    {
+      return std::launder(reinterpret_cast<T*>(m_data));
+    }
+
+    alignas(T) unsigned char m_data[queueSize * sizeof(T)]; //!< Uninitialized storage, the copies are constructed in place
+    size_t                   m_size;                         //!< Number of valid copies
+  };
+
   /*************************************************************************\
    * Implementation of queueBase
   \*************************************************************************/
-  template <typename T, size_t queueSize>
-  queueBase<T, queueSize>::queueBase() : m_head(0), m_tail(0), m_currentSize(0)
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  queueBase<derived_t, T, queueSize, lock_t>::queueBase() : m_head(0), m_tail(0), m_currentSize(0)
   {
   }
 
-  template <typename T, size_t queueSize>
-  size_t queueBase<T, queueSize>::incrementIndex(size_t index) const
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  queueBase<derived_t, T, queueSize, lock_t>::~queueBase()
   {
-    return (index + 1) % queueSize;
+    size_t index = m_head;
+    for (size_t i = 0; i < m_currentSize; ++i)
+    {
+      destroy(index);
+      index = incrementIndex(index);
+    }
   }
 
-  template <typename T, size_t queueSize>
-  size_t queueBase<T, queueSize>::decrementIndex(size_t index) const
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  bool queueBase<derived_t, T, queueSize, lock_t>::push(const T& item)
   {
-    return (index == 0) ? queueSize - 1 : index - 1;
+    return static_cast<derived_t*>(this)->emplace(item);
   }
 
-  template <typename T, size_t queueSize>
-  bool queueBase<T, queueSize>::isEmpty() const
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  bool queueBase<derived_t, T, queueSize, lock_t>::push(T&& item)
   {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_currentSize == 0;
+    return static_cast<derived_t*>(this)->emplace(std::move(item));
   }
 
-  template <typename T, size_t queueSize>
-  bool queueBase<T, queueSize>::isFull() const
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  bool queueBase<derived_t, T, queueSize, lock_t>::pop(T& item)
   {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_currentSize == queueSize;
+    return static_cast<derived_t*>(this)->popElement(item);
   }
 
-  template <typename T, size_t queueSize>
-  size_t queueBase<T, queueSize>::size() const
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  T* queueBase<derived_t, T, queueSize, lock_t>::element(size_t index)
   {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_currentSize;
+    return std::launder(reinterpret_cast<T*>(m_data) + index);
   }
 
-  /*************************************************************************\
-   * fifoQueue Implementation
-  \*************************************************************************/
-  template <typename T, size_t queueSize>
-  class fifoQueue : public queueBase<T, queueSize>
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  const T* queueBase<derived_t, T, queueSize, lock_t>::element(size_t index) const
   {
-  public:
-    bool push(const T& item) override;
-    bool push(T&& item) override;
-    bool pop(T& item) override;
-    bool peek(T& item) const;
-  };
+    return std::launder(reinterpret_cast<const T*>(m_data) + index);
+  }
 
-  template <typename T, size_t queueSize>
-  bool fifoQueue<T, queueSize>::push(const T& item)
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  template <typename... Args>
+  void queueBase<derived_t, T, queueSize, lock_t>::construct(size_t index, Args&&... args)
+  {
+    new (reinterpret_cast<T*>(m_data) + index) T(std::forward<Args>(args)...);
+  }
+
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  void queueBase<derived_t, T, queueSize, lock_t>::destroy(size_t index)
   {
-    std::lock_guard<std::mutex> lock(this->m_mutex);
+    element(index)->~T();
+  }
 
-    if (this->m_currentSize == queueSize)
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  size_t queueBase<derived_t, T, queueSize, lock_t>::incrementIndex(size_t index) const
+  {
+    if constexpr (isPowerOfTwo(queueSize))
     {
-      // Overwrite oldest element
-      this->m_head = this->incrementIndex(this->m_head);
+      return (index + 1) & (queueSize - 1);
     }
     else
     {
-      this->m_currentSize++;
+      return (index + 1 == queueSize) ? 0 : index + 1;
     }
-
-    this->m_data[this->m_tail] = item;
-    this->m_tail               = this->incrementIndex(this->m_tail);
-
-    return true; // Always successful
   }
 
-  template <typename T, size_t queueSize>
-  bool fifoQueue<T, queueSize>::push(T&& item)
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  size_t queueBase<derived_t, T, queueSize, lock_t>::decrementIndex(size_t index) const
   {
-    std::lock_guard<std::mutex> lock(this->m_mutex);
-
-    if (this->m_currentSize == queueSize)
+    if constexpr (isPowerOfTwo(queueSize))
     {
-      // Overwrite oldest element
-      this->m_head = this->incrementIndex(this->m_head);
+      return (index - 1) & (queueSize - 1);
     }
     else
     {
-      this->m_currentSize++;
+      return (index == 0) ? queueSize - 1 : index - 1;
     }
-
-    this->m_data[this->m_tail] = std::move(item);
-    this->m_tail               = this->incrementIndex(this->m_tail);
-
-    return true; // Always successful
   }
 
-  template <typename T, size_t queueSize>
-  bool fifoQueue<T, queueSize>::pop(T& item)
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  size_t queueBase<derived_t, T, queueSize, lock_t>::advanceIndex(size_t index, size_t steps) const
   {
-    std::lock_guard<std::mutex> lock(this->m_mutex);
-
-    if (this->m_currentSize == 0)
+    if constexpr (isPowerOfTwo(queueSize))
     {
-      return false;
+      return (index + steps) & (queueSize - 1);
+    }
+    else
+    {
+      return (index + steps >= queueSize) ? index + steps - queueSize : index + steps;
     }
-
-    item = std::move(this->m_data[this->m_head]);
-    this->m_head = this->incrementIndex(this->m_head);
-    this->m_currentSize--;
-
-    return true;
   }
 
-  template <typename T, size_t queueSize>
-  bool fifoQueue<T, queueSize>::peek(T& item) const
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  void queueBase<derived_t, T, queueSize, lock_t>::constructRange(size_t index, const T data[], size_t count)
   {
-    std::lock_guard<std::mutex> lock(this->m_mutex);
-
-    if (this->m_currentSize == 0)
+    if constexpr (std::is_trivially_copyable<T>::value)
     {
-      return false;
+      const size_t firstCount = (count < queueSize - index) ? count : queueSize - index;
+      if (firstCount > 0)
+      {
+        std::memcpy(m_data + index * sizeof(T), data, firstCount * sizeof(T));
+      }
+      if (count > firstCount)
+      {
+        std::memcpy(m_data, data + firstCount, (count - firstCount) * sizeof(T));
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        construct(index, data[i]);
+        index = incrementIndex(index);
+      }
     }
-
-    item = this->m_data[this->m_head];
-    return true;
   }
 
-  /*************************************************************************\
-   * lifoQueue Implementation
-  \*************************************************************************/
-  template <typename T, size_t queueSize>
-  class lifoQueue : public queueBase<T, queueSize>
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  void queueBase<derived_t, T, queueSize, lock_t>::copyRange(size_t index, T data[], size_t count) const
   {
-  public:
-    bool push(const T& item) override;
-    bool push(T&& item) override;
-    bool pop(T& item) override;
-    bool peek(T& item) const;
-  };
+    if constexpr (std::is_trivially_copyable<T>::value)
+    {
+      const size_t firstCount = (count < queueSize - index) ? count : queueSize - index;
+      if (firstCount > 0)
+      {
+        std::memcpy(data, m_data + index * sizeof(T), firstCount * sizeof(T));
+      }
+      if (count > firstCount)
+      {
+        std::memcpy(data + firstCount, m_data, (count - firstCount) * sizeof(T));
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        data[i] = *element(index);
+        index   = incrementIndex(index);
+      }
+    }
+  }
 
-  template <typename T, size_t queueSize>
-  bool lifoQueue<T, queueSize>::push(const T& item)
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  void queueBase<derived_t, T, queueSize, lock_t>::takeRange(size_t index, T data[], size_t count)
   {
-    std::lock_guard<std::mutex> lock(this->m_mutex);
-
-    if (this->m_currentSize == queueSize)
+    if constexpr (std::is_trivially_copyable<T>::value)
     {
-      // Stack is full, cannot push
-      return false;
+      // Trivially copyable elements need no destruction, so taking them is copying them
+      copyRange(index, data, count);
+    }
+    else
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        data[i] = std::move(*element(index));
+        destroy(index);
+        index = incrementIndex(index);
+      }
     }
-
-    this->m_data[this->m_tail] = item;
-    this->m_tail               = this->incrementIndex(this->m_tail);
-    this->m_currentSize++;
-    return true;
   }
 
-  template <typename T, size_t queueSize>
-  bool lifoQueue<T, queueSize>::push(T&& item)
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  void queueBase<derived_t, T, queueSize, lock_t>::destroyRange(size_t index, size_t count)
   {
-    std::lock_guard<std::mutex> lock(this->m_mutex);
-
-    if (this->m_currentSize == queueSize)
+    if constexpr (!std::is_trivially_destructible<T>::value)
     {
-      // Stack is full, cannot push
-      return false;
+      for (size_t i = 0; i < count; ++i)
+      {
+        destroy(index);
+        index = incrementIndex(index);
+      }
     }
+  }
 
-    this->m_data[this->m_tail] = std::move(item);
-    this->m_tail               = this->incrementIndex(this->m_tail);
-    this->m_currentSize++;
-    return true;
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  bool queueBase<derived_t, T, queueSize, lock_t>::isEmpty() const
+  {
+    std::lock_guard<lock_t> lock(m_lock);
+    return m_currentSize == 0;
   }
 
-  template <typename T, size_t queueSize>
-  bool lifoQueue<T, queueSize>::pop(T& item)
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  bool queueBase<derived_t, T, queueSize, lock_t>::isFull() const
   {
-    std::lock_guard<std::mutex> lock(this->m_mutex);
+    std::lock_guard<lock_t> lock(m_lock);
+    return m_currentSize == queueSize;
+  }
 
-    if (this->m_currentSize == 0)
-    {
-      return false;
-    }
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  size_t queueBase<derived_t, T, queueSize, lock_t>::size() const
+  {
+    std::lock_guard<lock_t> lock(m_lock);
+    return m_currentSize;
+  }
 
-    this->m_tail = this->decrementIndex(this->m_tail);
-    item = std::move(this->m_data[this->m_tail]);
-    this->m_currentSize--;
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  size_t queueBase<derived_t, T, queueSize, lock_t>::snapshot(T data[], size_t count) const
+  {
+    std::lock_guard<lock_t> lock(m_lock);
 
-    return true;
+    const size_t copyCount = (count < m_currentSize) ? count : m_currentSize;
+    copyRange(m_head, data, copyCount);
+    return copyCount;
   }
 
-  template <typename T, size_t queueSize>
-  bool lifoQueue<T, queueSize>::peek(T& item) const
+  template <typename derived_t, typename T, size_t queueSize, typename lock_t>
+  size_t queueBase<derived_t, T, queueSize, lock_t>::snapshotConstruct(T storage[], size_t count) const
   {
-    std::lock_guard<std::mutex> lock(this->m_mutex);
+    std::lock_guard<lock_t> lock(m_lock);
 
-    if (this->m_currentSize == 0)
+    const size_t copyCount = (count < m_currentSize) ? count : m_currentSize;
+    if constexpr (std::is_trivially_copyable<T>::value)
     {
-      return false;
+      // Trivially copyable elements are created by copying their bytes
+      copyRange(m_head, storage, copyCount);
+    }
+    else
+    {
+      size_t index = m_head;
+      for (size_t i = 0; i < copyCount; ++i)
+      {
+        new (storage + i) T(*element(index));
+        index = incrementIndex(index);
+      }
     }
+    return copyCount;
+  }
 
-    size_t tempTail = this->decrementIndex(this->m_tail);
-    item = this->m_data[tempTail];
-    return true;
+  /*************************************************************************\
+   * fifoQueue Implementation
+  \*************************************************************************/
+  template <typename T, size_t queueSize, typename lock_t = MEM::mutexLock>
+  class fifoQueue final : public queueBase<fifoQueue<T, queueSize, lock_t>, T, queueSize, lock_t>
+  {
+  public:
+    /**
+     * @brief      Constructor that initializes an empty, open queue.
+     * @param[in]  overflow  Specifies whether to overwrite the oldest element when the queue is full, or to reject the new one.
+     *                       Default is `QUEUE_DROP_OLDEST`.
+     */
+    explicit fifoQueue(MEM::queueOverflow_e overflow = MEM::QUEUE_DROP_OLDEST);
+
+    bool peek(T& item) const;
+
+    /**
+     * @brief      Constructs an element in place at the tail of the queue.
+     * @details    If the queue is full, the oldest element is overwritten or the new one is rejected, depending on the overflow
+     *             behavior.
+     * @param[in]  args  The arguments forwarded to the constructor of `T`.
+     * @return     `true` if the element was constructed, `false` if the queue is closed, or full and does not overwrite.
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args);
+
+    /**
+     * @brief      Adds multiple elements to the queue, locking it only once.
+     * @details    Like `push()`, the oldest elements are overwritten if the queue is full. If more than `queueSize` elements
+     *             are added, only the last `queueSize` of them remain. If the queue does not overwrite, the elements that do not
+     *             fit are rejected instead. `T` must be copy constructible.
+     *             For trivially copyable `T` the elements are copied with at most two `memcpy` calls.
+     * @param[in]  data   The array of elements to add.
+     * @param[in]  count  The number of elements in the array.
+     * @return     The number of elements added: `count` if the queue overwrites, less if it does not and became full, and 0
+     *             if it is closed.
+     */
+    size_t pushN(const T data[], size_t count);
+
+    /**
+     * @brief       Removes multiple elements from the queue, oldest first, locking it only once.
+     * @details     For trivially copyable `T` the elements are copied with at most two `memcpy` calls.
+     * @param[out]  data   The array to store the removed elements.
+     * @param[in]   count  The size of the array.
+     * @return      The number of elements removed, less than `count` if the queue held fewer elements.
+     */
+    size_t popN(T data[], size_t count);
+
+    /**
+     * @brief      Removes all elements from the queue, oldest first, and passes each of them to a callback, locking it only once.
+     * @param[in]  callback  Callable that takes a `T&&`. It is called while the queue is locked and must not access the queue.
+     * @return     The number of elements removed.
+     */
+    template <typename callback_t>
+    size_t drainTo(callback_t callback);
+
+    /**
+     * @brief       Removes an element from the queue, sleeping until one is available if the queue is empty.
+     * @details     A sleeping consumer is woken once the queue holds at least the wakeup threshold of elements, or when the
+     *              queue is closed. When the timeout expires, an element is still removed if any is available.
+     * @param[out]  item     A reference to store the popped item.
+     * @param[in]   timeout  The maximum time to wait.
+     * @return      `true` if an item was removed, `false` if the queue stayed empty until the timeout expired, or is closed and
+     *              empty.
+     */
+    bool popWait(T& item, std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief      Adds an element to the queue, sleeping until there is space if the queue is full and does not overwrite.
+     * @details    A sleeping producer is woken whenever an element is removed, or when the queue is closed. If the queue
+     *             overwrites, this is the same as `push()`.
+     * @param[in]  item     The item to be added.
+     * @param[in]  timeout  The maximum time to wait.
+     * @return     `true` if the item was added, `false` if the queue stayed full until the timeout expired, or is closed.
+     */
+    bool pushWait(const T& item, std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief      Adds an element to the queue (move semantics), sleeping until there is space if the queue is full and does
+     *             not overwrite.
+     * @param[in]  item     The item to be added, which is only moved from if it was added.
+     * @param[in]  timeout  The maximum time to wait.
+     * @return     `true` if the item was added, `false` if the queue stayed full until the timeout expired, or is closed.
+     */
+    bool pushWait(T&& item, std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief    Closes the queue for shutdown.
+     * @details  From now on all new elements are rejected, while the queued elements can still be removed. All producers and
+     *           consumers sleeping in `pushWait()` or `popWait()` are woken: the producers fail, the consumers drain the queue
+     *           and fail once it is empty.
+     */
+    void close();
+
+    /**
+     * @brief   Checks if the queue is closed.
+     * @return  `true` if `close()` was called, `false` otherwise.
+     */
+    bool isClosed() const;
+
+    /**
+     * @brief      Sets the behavior when an element is added to a full queue.
+     * @param[in]  overflow  `QUEUE_DROP_OLDEST` to overwrite the oldest element, `QUEUE_REJECT` to reject the new one,
+     *                       which lets `pushWait()` block as backpressure for the producers.
+     */
+    void setOverflowBehavior(MEM::queueOverflow_e overflow);
+
+    /**
+     * @brief   Gets the behavior when an element is added to a full queue.
+     * @return  The overflow behavior.
+     */
+    MEM::queueOverflow_e getOverflowBehavior() const;
+
+    /**
+     * @brief      Sets the number of queued elements at which a consumer sleeping in `popWait()` is woken.
+     * @details    A larger threshold saves wakeups when elements are processed in batches. The default is 1.
+     * @param[in]  threshold  The number of elements, clamped to the range from 1 to `queueSize`.
+     */
+    void setWakeupThreshold(size_t threshold);
+
+  private:
+    friend class queueBase<fifoQueue<T, queueSize, lock_t>, T, queueSize, lock_t>;
+
+    /**
+     * @brief       Removes the oldest element from the queue, called by `pop()`.
+     * @param[out]  item  A reference to store the popped item.
+     * @return      `true` if the item was removed successfully, `false` if the queue is empty.
+     */
+    bool popElement(T& item);
+
+    /**
+     * @brief      Wakes the consumers sleeping in `popWait()` once enough elements are queued.
+     * @param[in]  batchReady  `true` if the queue holds at least the wakeup threshold of elements.
+     */
+    void notifyConsumers(bool batchReady);
+
+    /**
+     * @brief      Wakes the producers sleeping in `pushWait()` after elements were removed.
+     * @param[in]  spaceFreed  `true` if elements were removed from a queue that does not overwrite.
+     */
+    void notifyProducers(bool spaceFreed);
+
+    waitPoint            m_popWaitPoint;    //!< Consumers sleep here until enough elements are queued
+    waitPoint            m_pushWaitPoint;   //!< Producers sleep here until there is space in the queue
+    size_t               m_wakeupThreshold; //!< Number of queued elements that wakes the consumers
+    MEM::queueOverflow_e m_overflowSetting; //!< Behavior when an element is added to a full queue
+    bool                 m_closed;          //!< `true` once the queue is closed for new elements
+  };
+
+  template <typename T, size_t queueSize, typename lock_t>
+  fifoQueue<T, queueSize, lock_t>::fifoQueue(MEM::queueOverflow_e overflow)
+    : m_wakeupThreshold(1), m_overflowSetting(overflow), m_closed(false)
+  {
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  template <typename... Args>
+  bool fifoQueue<T, queueSize, lock_t>::emplace(Args&&... args)
+  {
+    bool batchReady;
+    {
+      std::lock_guard<lock_t> lock(this->m_lock);
+
+      if (m_closed)
+      {
+        return false;
+      }
+
+      if (this->m_currentSize == queueSize)
+      {
+        if (m_overflowSetting == MEM::QUEUE_REJECT)
+        {
+          return false;
+        }
+
+        // Overwrite oldest element. The arguments may refer to it, so build the new one before destroying it
+        T item(std::forward<Args>(args)...);
+        this->destroy(this->m_head);
+        this->m_head = this->incrementIndex(this->m_head);
+        this->construct(this->m_tail, std::move(item));
+      }
+      else
+      {
+        this->construct(this->m_tail, std::forward<Args>(args)...);
+        this->m_currentSize++;
+      }
+      this->m_tail = this->incrementIndex(this->m_tail);
+      batchReady   = this->m_currentSize >= m_wakeupThreshold;
+    }
+
+    notifyConsumers(batchReady);
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool fifoQueue<T, queueSize, lock_t>::popElement(T& item)
+  {
+    bool spaceFreed;
+    {
+      std::lock_guard<lock_t> lock(this->m_lock);
+
+      if (this->m_currentSize == 0)
+      {
+        return false;
+      }
+
+      item = std::move(*this->element(this->m_head));
+      this->destroy(this->m_head);
+      this->m_head = this->incrementIndex(this->m_head);
+      this->m_currentSize--;
+      spaceFreed = (m_overflowSetting == MEM::QUEUE_REJECT);
+    }
+
+    notifyProducers(spaceFreed);
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  size_t fifoQueue<T, queueSize, lock_t>::pushN(const T data[], size_t count)
+  {
+    bool   batchReady;
+    size_t addedCount;
+    {
+      std::lock_guard<lock_t> lock(this->m_lock);
+
+      if (m_closed)
+      {
+        return 0;
+      }
+
+      // Only the last queueSize elements would remain, so the others are not copied at all
+      const size_t freeSpace = queueSize - this->m_currentSize;
+      const bool   overwrite = (m_overflowSetting == MEM::QUEUE_DROP_OLDEST);
+      const size_t skipCount = (overwrite && count > queueSize) ? count - queueSize : 0;
+      const size_t copyCount = overwrite ? count - skipCount : (count < freeSpace) ? count : freeSpace;
+
+      if (copyCount > freeSpace)
+      {
+        // Overwrite oldest elements
+        const size_t overwriteCount = copyCount - freeSpace;
+        this->destroyRange(this->m_head, overwriteCount);
+        this->m_head = this->advanceIndex(this->m_head, overwriteCount);
+        this->m_currentSize -= overwriteCount;
+      }
+
+      this->constructRange(this->m_tail, data + skipCount, copyCount);
+      this->m_tail = this->advanceIndex(this->m_tail, copyCount);
+      this->m_currentSize += copyCount;
+      batchReady = (copyCount > 0) && (this->m_currentSize >= m_wakeupThreshold);
+      addedCount = skipCount + copyCount;
+    }
+
+    notifyConsumers(batchReady);
+    return addedCount;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  size_t fifoQueue<T, queueSize, lock_t>::popN(T data[], size_t count)
+  {
+    size_t takeCount;
+    bool   spaceFreed;
+    {
+      std::lock_guard<lock_t> lock(this->m_lock);
+
+      takeCount = (count < this->m_currentSize) ? count : this->m_currentSize;
+      this->takeRange(this->m_head, data, takeCount);
+      this->m_head = this->advanceIndex(this->m_head, takeCount);
+      this->m_currentSize -= takeCount;
+      spaceFreed = (takeCount > 0) && (m_overflowSetting == MEM::QUEUE_REJECT);
+    }
+
+    notifyProducers(spaceFreed);
+    return takeCount;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  template <typename callback_t>
+  size_t fifoQueue<T, queueSize, lock_t>::drainTo(callback_t callback)
+  {
+    size_t drainCount;
+    bool   spaceFreed;
+    {
+      std::lock_guard<lock_t> lock(this->m_lock);
+
+      drainCount = this->m_currentSize;
+      for (size_t i = 0; i < drainCount; ++i)
+      {
+        callback(std::move(*this->element(this->m_head)));
+        this->destroy(this->m_head);
+        this->m_head = this->incrementIndex(this->m_head);
+      }
+      this->m_currentSize = 0;
+      spaceFreed          = (drainCount > 0) && (m_overflowSetting == MEM::QUEUE_REJECT);
+    }
+
+    notifyProducers(spaceFreed);
+    return drainCount;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool fifoQueue<T, queueSize, lock_t>::peek(T& item) const
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (this->m_currentSize == 0)
+    {
+      return false;
+    }
+
+    item = *this->element(this->m_head);
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool fifoQueue<T, queueSize, lock_t>::popWait(T& item, std::chrono::nanoseconds timeout)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    auto       ready    = [this]() {
+      std::lock_guard<lock_t> lock(this->m_lock);
+      return m_closed || this->m_currentSize >= m_wakeupThreshold;
+    };
+
+    // Another consumer may take the element between the wakeup and the pop, then wait for the remaining time
+    do
+    {
+      m_popWaitPoint.waitUntil(ready, deadline - std::chrono::steady_clock::now());
+      if (this->pop(item))
+      {
+        return true;
+      }
+      if (isClosed())
+      {
+        // Closed and drained, no element will arrive anymore
+        return false;
+      }
+    } while (std::chrono::steady_clock::now() < deadline);
+
+    return false;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  void fifoQueue<T, queueSize, lock_t>::setWakeupThreshold(size_t threshold)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+    m_wakeupThreshold = (threshold == 0) ? 1 : (threshold > queueSize) ? queueSize : threshold;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool fifoQueue<T, queueSize, lock_t>::pushWait(const T& item, std::chrono::nanoseconds timeout)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    auto       ready    = [this]() {
+      std::lock_guard<lock_t> lock(this->m_lock);
+      return m_closed || this->m_currentSize < queueSize;
+    };
+
+    // Another producer may take the space between the wakeup and the push, then wait for the remaining time
+    for (;;)
+    {
+      if (emplace(item))
+      {
+        return true;
+      }
+      const std::chrono::nanoseconds remaining = deadline - std::chrono::steady_clock::now();
+      if (remaining.count() <= 0 || isClosed())
+      {
+        return false;
+      }
+      m_pushWaitPoint.waitUntil(ready, remaining);
+    }
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool fifoQueue<T, queueSize, lock_t>::pushWait(T&& item, std::chrono::nanoseconds timeout)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    auto       ready    = [this]() {
+      std::lock_guard<lock_t> lock(this->m_lock);
+      return m_closed || this->m_currentSize < queueSize;
+    };
+
+    for (;;)
+    {
+      // emplace() only moves from the item when it adds it, so it can be retried
+      if (emplace(std::move(item)))
+      {
+        return true;
+      }
+      const std::chrono::nanoseconds remaining = deadline - std::chrono::steady_clock::now();
+      if (remaining.count() <= 0 || isClosed())
+      {
+        return false;
+      }
+      m_pushWaitPoint.waitUntil(ready, remaining);
+    }
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  void fifoQueue<T, queueSize, lock_t>::close()
+  {
+    {
+      std::lock_guard<lock_t> lock(this->m_lock);
+      m_closed = true;
+    }
+    m_popWaitPoint.notify();
+    m_pushWaitPoint.notify();
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool fifoQueue<T, queueSize, lock_t>::isClosed() const
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+    return m_closed;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  void fifoQueue<T, queueSize, lock_t>::setOverflowBehavior(MEM::queueOverflow_e overflow)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+    m_overflowSetting = overflow;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  MEM::queueOverflow_e fifoQueue<T, queueSize, lock_t>::getOverflowBehavior() const
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+    return m_overflowSetting;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  void fifoQueue<T, queueSize, lock_t>::notifyConsumers(bool batchReady)
+  {
+    // Without locking there is no other thread that could sleep in popWait()
+    if (batchReady && !std::is_same<lock_t, MEM::noLock>::value)
+    {
+      m_popWaitPoint.notify();
+    }
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  void fifoQueue<T, queueSize, lock_t>::notifyProducers(bool spaceFreed)
+  {
+    // An overwriting queue never lets pushWait() sleep, so the wakeup fence is only paid for backpressure
+    if (spaceFreed && !std::is_same<lock_t, MEM::noLock>::value)
+    {
+      m_pushWaitPoint.notify();
+    }
+  }
+
+  /*************************************************************************\
+   * lifoQueue Implementation
+  \*************************************************************************/
+  template <typename T, size_t queueSize, typename lock_t = MEM::mutexLock>
+  class lifoQueue final : public queueBase<lifoQueue<T, queueSize, lock_t>, T, queueSize, lock_t>
+  {
+  public:
+    bool peek(T& item) const;
+
+    /**
+     * @brief      Constructs an element in place on top of the stack.
+     * @param[in]  args  The arguments forwarded to the constructor of `T`.
+     * @return     `true` if the element was constructed, `false` if the stack is full.
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args);
+
+    /**
+     * @brief      Adds multiple elements on top of the stack, locking it only once.
+     * @details    The last element of the array ends up on top. Elements that do not fit are not added. `T` must be copy
+     *             constructible. For trivially copyable `T` the elements are copied with at most two `memcpy` calls.
+     * @param[in]  data   The array of elements to add.
+     * @param[in]  count  The number of elements in the array.
+     * @return     The number of elements added, less than `count` if the stack became full.
+     */
+    size_t pushN(const T data[], size_t count);
+
+    /**
+     * @brief       Removes multiple elements from the stack, top first, locking it only once.
+     * @param[out]  data   The array to store the removed elements.
+     * @param[in]   count  The size of the array.
+     * @return      The number of elements removed, less than `count` if the stack held fewer elements.
+     */
+    size_t popN(T data[], size_t count);
+
+    /**
+     * @brief      Removes all elements from the stack, top first, and passes each of them to a callback, locking it only once.
+     * @param[in]  callback  Callable that takes a `T&&`. It is called while the stack is locked and must not access the stack.
+     * @return     The number of elements removed.
+     */
+    template <typename callback_t>
+    size_t drainTo(callback_t callback);
+
+  private:
+    friend class queueBase<lifoQueue<T, queueSize, lock_t>, T, queueSize, lock_t>;
+
+    /**
+     * @brief       Removes the newest element from the stack, called by `pop()`.
+     * @param[out]  item  A reference to store the popped item.
+     * @return      `true` if the item was removed successfully, `false` if the stack is empty.
+     */
+    bool popElement(T& item);
+  };
+
+  template <typename T, size_t queueSize, typename lock_t>
+  template <typename... Args>
+  bool lifoQueue<T, queueSize, lock_t>::emplace(Args&&... args)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (this->m_currentSize == queueSize)
+    {
+      // Stack is full, cannot push
+      return false;
+    }
+
+    this->construct(this->m_tail, std::forward<Args>(args)...);
+    this->m_tail = this->incrementIndex(this->m_tail);
+    this->m_currentSize++;
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool lifoQueue<T, queueSize, lock_t>::popElement(T& item)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (this->m_currentSize == 0)
+    {
+      return false;
+    }
+
+    this->m_tail = this->decrementIndex(this->m_tail);
+    item = std::move(*this->element(this->m_tail));
+    this->destroy(this->m_tail);
+    this->m_currentSize--;
+
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  size_t lifoQueue<T, queueSize, lock_t>::pushN(const T data[], size_t count)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    const size_t freeSpace = queueSize - this->m_currentSize;
+    const size_t copyCount = (count < freeSpace) ? count : freeSpace;
+    this->constructRange(this->m_tail, data, copyCount);
+    this->m_tail = this->advanceIndex(this->m_tail, copyCount);
+    this->m_currentSize += copyCount;
+
+    return copyCount;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  size_t lifoQueue<T, queueSize, lock_t>::popN(T data[], size_t count)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    // The top element comes first, so the elements are taken in reverse storage order
+    const size_t takeCount = (count < this->m_currentSize) ? count : this->m_currentSize;
+    for (size_t i = 0; i < takeCount; ++i)
+    {
+      this->m_tail = this->decrementIndex(this->m_tail);
+      data[i]      = std::move(*this->element(this->m_tail));
+      this->destroy(this->m_tail);
+    }
+    this->m_currentSize -= takeCount;
+
+    return takeCount;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  template <typename callback_t>
+  size_t lifoQueue<T, queueSize, lock_t>::drainTo(callback_t callback)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    const size_t drainCount = this->m_currentSize;
+    for (size_t i = 0; i < drainCount; ++i)
+    {
+      this->m_tail = this->decrementIndex(this->m_tail);
+      callback(std::move(*this->element(this->m_tail)));
+      this->destroy(this->m_tail);
+    }
+    this->m_currentSize = 0;
+
+    return drainCount;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool lifoQueue<T, queueSize, lock_t>::peek(T& item) const
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (this->m_currentSize == 0)
+    {
+      return false;
+    }
+
+    size_t tempTail = this->decrementIndex(this->m_tail);
+    item = *this->element(tempTail);
+    return true;
+  }
+
+  /*************************************************************************\
+   * priorityQueue Implementation
+  \*************************************************************************/
+  /**
+   * @brief    Statically allocated priority queue, implemented as a 4-ary heap.
+   * @details  `pop()` always removes the element with the highest priority. The heap stores four children per node, so it is
+   *           half as deep as a binary heap and the children of a node share a cache line for small `T`. `push()` and `pop()`
+   *           take O(log n) steps. `push()` hands out a handle for each element, with which `decreaseKey()` raises the
+   *           priority of a queued element in O(log n). A handle becomes invalid when its element is popped and may then be
+   *           reused for a new element. Like `lifoQueue`, the queue rejects new elements when it is full.
+   *           Iterating visits the elements in heap order, not in priority order.
+   * @tparam   T          The type of elements stored in the queue, which must be move constructible and move assignable.
+   * @tparam   queueSize  The fixed size of the queue.
+   * @tparam   compare_t  Comparison that returns `true` if its first argument has a higher priority than the second. The default
+   *                      `std::less<T>` pops the smallest element first (e.g. the earliest deadline), unlike `std::priority_queue`.
+   * @tparam   lock_t     The lock policy that protects the queue.
+   */
+  template <typename T, size_t queueSize, typename compare_t = std::less<T>, typename lock_t = MEM::mutexLock>
+  class priorityQueue final : public queueBase<priorityQueue<T, queueSize, compare_t, lock_t>, T, queueSize, lock_t>
+  {
+  public:
+    using queueBase<priorityQueue<T, queueSize, compare_t, lock_t>, T, queueSize, lock_t>::push;
+
+    /**
+     * @brief      Constructor that initializes an empty queue.
+     * @param[in]  compare  The comparison to order the elements with.
+     */
+    explicit priorityQueue(const compare_t& compare = compare_t());
+
+    /**
+     * @brief       Adds an element to the queue and provides its handle.
+     * @param[in]   item    The item to be added.
+     * @param[out]  handle  The handle of the added element, only valid if the element was added.
+     * @return      `true` if the item was added successfully, `false` if the queue is full.
+     */
+    bool push(const T& item, size_t& handle);
+
+    /**
+     * @brief       Adds an element to the queue (move semantics) and provides its handle.
+     * @param[in]   item    The item to be added.
+     * @param[out]  handle  The handle of the added element, only valid if the element was added.
+     * @return      `true` if the item was added successfully, `false` if the queue is full.
+     */
+    bool push(T&& item, size_t& handle);
+
+    /**
+     * @brief      Constructs an element in place in the queue.
+     * @param[in]  args  The arguments forwarded to the constructor of `T`.
+     * @return     `true` if the element was constructed, `false` if the queue is full.
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args);
+
+    /**
+     * @brief       Gets the element with the highest priority without removing it.
+     * @param[out]  item  A reference to store the element.
+     * @return      `true` if an element was available, `false` if the queue is empty.
+     */
+    bool peek(T& item) const;
+
+    /**
+     * @brief      Replaces a queued element by one with a higher or equal priority, moving it towards the top of the heap.
+     * @param[in]  handle  The handle of the element.
+     * @param[in]  item    The new value of the element.
+     * @return     `true` if the element was replaced, `false` if the handle is invalid or the new value has a lower priority.
+     */
+    bool decreaseKey(size_t handle, const T& item);
+
+    /**
+     * @brief      Checks whether a handle refers to an element that is still queued.
+     * @param[in]  handle  The handle to check.
+     * @return     `true` if the element is queued, `false` otherwise.
+     */
+    bool contains(size_t handle) const;
+
+    /**
+     * @brief       Adds multiple elements and restores the heap once, in O(n) instead of O(n log n) for single pushes.
+     * @details     Elements that do not fit are not added. `T` must be copy constructible.
+     * @param[in]   data     The array of elements to add.
+     * @param[in]   count    The number of elements in the array.
+     * @param[out]  handles  Optional array of at least `count` entries to store the handles of the added elements.
+     * @return      The number of elements added, less than `count` if the queue became full.
+     */
+    size_t heapify(const T data[], size_t count, size_t handles[] = nullptr);
+
+  private:
+    friend class queueBase<priorityQueue<T, queueSize, compare_t, lock_t>, T, queueSize, lock_t>;
+
+    static constexpr size_t heapArity       = 4;         //!< Number of children per node of the heap.
+    static constexpr size_t invalidPosition = queueSize; //!< Heap position of a handle without element.
+
+    /**
+     * @brief       Removes the element with the highest priority, called by `pop()`.
+     * @param[out]  item  A reference to store the popped item.
+     * @return      `true` if the item was removed successfully, `false` if the queue is empty.
+     */
+    bool popElement(T& item);
+
+    /**
+     * @brief       Constructs an element at the end of the heap and moves it up to its position, without locking.
+     * @param[out]  handle  The handle of the added element, only valid if the element was added.
+     * @param[in]   args    The arguments forwarded to the constructor of `T`.
+     * @return      `true` if the element was added, `false` if the queue is full.
+     */
+    template <typename... Args>
+    bool insert(size_t& handle, Args&&... args);
+
+    /**
+     * @brief      Assigns a free handle to the element at a heap position.
+     * @param[in]  position  The heap position.
+     * @return     The handle.
+     */
+    size_t acquireHandle(size_t position);
+
+    /**
+     * @brief      Moves the element from one heap position to another, together with its handle.
+     * @param[in]  from  The heap position of the element.
+     * @param[in]  to    The heap position to move the element to.
+     */
+    void moveElement(size_t from, size_t to);
+
+    /**
+     * @brief      Moves the element at a heap position up until its parent has a higher or equal priority.
+     * @param[in]  position  The heap position.
+     */
+    void siftUp(size_t position);
+
+    /**
+     * @brief      Moves the element at a heap position down until no child has a higher priority.
+     * @param[in]  position  The heap position.
+     */
+    void siftDown(size_t position);
+
+    compare_t m_compare;                 //!< Comparison that orders the elements
+    size_t    m_heapHandle[queueSize];   //!< Handle of the element at each heap position
+    size_t    m_heapPosition[queueSize]; //!< Heap position of the element of each handle, `invalidPosition` if unused
+    size_t    m_freeHandles[queueSize];  //!< Stack of the unused handles
+    size_t    m_freeHandleCount;         //!< Number of unused handles on the stack
+  };
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  priorityQueue<T, queueSize, compare_t, lock_t>::priorityQueue(const compare_t& compare)
+    : m_compare(compare), m_freeHandleCount(queueSize)
+  {
+    for (size_t i = 0; i < queueSize; ++i)
+    {
+      m_heapPosition[i] = invalidPosition;
+      m_freeHandles[i]  = queueSize - 1 - i;
+    }
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  bool priorityQueue<T, queueSize, compare_t, lock_t>::push(const T& item, size_t& handle)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+    return insert(handle, item);
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  bool priorityQueue<T, queueSize, compare_t, lock_t>::push(T&& item, size_t& handle)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+    return insert(handle, std::move(item));
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  template <typename... Args>
+  bool priorityQueue<T, queueSize, compare_t, lock_t>::emplace(Args&&... args)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+    size_t                  handle;
+    return insert(handle, std::forward<Args>(args)...);
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  bool priorityQueue<T, queueSize, compare_t, lock_t>::peek(T& item) const
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (this->m_currentSize == 0)
+    {
+      return false;
+    }
+
+    item = *this->element(0);
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  bool priorityQueue<T, queueSize, compare_t, lock_t>::decreaseKey(size_t handle, const T& item)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (handle >= queueSize || m_heapPosition[handle] == invalidPosition)
+    {
+      return false;
+    }
+
+    const size_t position = m_heapPosition[handle];
+    if (m_compare(*this->element(position), item))
+    {
+      // The new value has a lower priority
+      return false;
+    }
+
+    *this->element(position) = item;
+    siftUp(position);
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  bool priorityQueue<T, queueSize, compare_t, lock_t>::contains(size_t handle) const
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+    return (handle < queueSize) && (m_heapPosition[handle] != invalidPosition);
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  size_t priorityQueue<T, queueSize, compare_t, lock_t>::heapify(const T data[], size_t count, size_t handles[])
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    const size_t freeSpace = queueSize - this->m_currentSize;
+    const size_t copyCount = (count < freeSpace) ? count : freeSpace;
+    if (copyCount == 0)
+    {
+      return 0;
+    }
+
+    // The elements are appended behind the heap, which never wraps since the heap starts at index 0
+    this->constructRange(this->m_currentSize, data, copyCount);
+    for (size_t i = 0; i < copyCount; ++i)
+    {
+      const size_t handle = acquireHandle(this->m_currentSize + i);
+      if (handles != nullptr)
+      {
+        handles[i] = handle;
+      }
+    }
+    this->m_currentSize += copyCount;
+    this->m_tail = this->advanceIndex(this->m_tail, copyCount);
+
+    // Bottom-up construction: sift down every node that has children, starting with the last one
+    if (this->m_currentSize > 1)
+    {
+      for (size_t position = (this->m_currentSize - 2) / heapArity + 1; position > 0; --position)
+      {
+        siftDown(position - 1);
+      }
+    }
+    return copyCount;
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  bool priorityQueue<T, queueSize, compare_t, lock_t>::popElement(T& item)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (this->m_currentSize == 0)
+    {
+      return false;
+    }
+
+    item = std::move(*this->element(0));
+    m_heapPosition[m_heapHandle[0]]    = invalidPosition;
+    m_freeHandles[m_freeHandleCount++] = m_heapHandle[0];
+
+    // The gap at the top moves down along the children with the highest priority to a leaf, where the last element fills it
+    // and moves up again. The last element usually belongs near the bottom, so it is not compared on every level on the way.
+    const size_t last = this->m_currentSize - 1;
+    size_t       hole = 0;
+    for (;;)
+    {
+      const size_t firstChild = hole * heapArity + 1;
+      if (firstChild >= last)
+      {
+        break;
+      }
+      const size_t lastChild = (firstChild + heapArity < last) ? firstChild + heapArity : last;
+      size_t       bestChild = firstChild;
+      for (size_t child = firstChild + 1; child < lastChild; ++child)
+      {
+        bestChild = m_compare(*this->element(child), *this->element(bestChild)) ? child : bestChild;
+      }
+      moveElement(bestChild, hole);
+      hole = bestChild;
+    }
+
+    if (hole != last)
+    {
+      moveElement(last, hole);
+    }
+    this->destroy(last);
+    this->m_currentSize--;
+    this->m_tail = this->decrementIndex(this->m_tail);
+
+    if (hole != last)
+    {
+      siftUp(hole);
+    }
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  template <typename... Args>
+  bool priorityQueue<T, queueSize, compare_t, lock_t>::insert(size_t& handle, Args&&... args)
+  {
+    if (this->m_currentSize == queueSize)
+    {
+      return false;
+    }
+
+    const size_t position = this->m_currentSize;
+    this->construct(position, std::forward<Args>(args)...);
+    handle = acquireHandle(position);
+    this->m_currentSize++;
+    this->m_tail = this->incrementIndex(this->m_tail);
+
+    siftUp(position);
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  size_t priorityQueue<T, queueSize, compare_t, lock_t>::acquireHandle(size_t position)
+  {
+    const size_t handle    = m_freeHandles[--m_freeHandleCount];
+    m_heapHandle[position] = handle;
+    m_heapPosition[handle] = position;
+    return handle;
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  void priorityQueue<T, queueSize, compare_t, lock_t>::moveElement(size_t from, size_t to)
+  {
+    *this->element(to)               = std::move(*this->element(from));
+    m_heapHandle[to]                 = m_heapHandle[from];
+    m_heapPosition[m_heapHandle[to]] = to;
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  void priorityQueue<T, queueSize, compare_t, lock_t>::siftUp(size_t position)
+  {
+    // The element is lifted out and the parents are moved down into the hole, instead of swapping at every level
+    T            item   = std::move(*this->element(position));
+    const size_t handle = m_heapHandle[position];
+
+    while (position > 0)
+    {
+      const size_t parent = (position - 1) / heapArity;
+      if (!m_compare(item, *this->element(parent)))
+      {
+        break;
+      }
+      moveElement(parent, position);
+      position = parent;
+    }
+
+    *this->element(position) = std::move(item);
+    m_heapHandle[position]   = handle;
+    m_heapPosition[handle]   = position;
+  }
+
+  template <typename T, size_t queueSize, typename compare_t, typename lock_t>
+  void priorityQueue<T, queueSize, compare_t, lock_t>::siftDown(size_t position)
+  {
+    T            item   = std::move(*this->element(position));
+    const size_t handle = m_heapHandle[position];
+    const size_t count  = this->m_currentSize;
+
+    for (;;)
+    {
+      const size_t firstChild = position * heapArity + 1;
+      if (firstChild >= count)
+      {
+        break;
+      }
+
+      // Find the child with the highest priority
+      const size_t lastChild = (firstChild + heapArity < count) ? firstChild + heapArity : count;
+      size_t       bestChild = firstChild;
+      for (size_t child = firstChild + 1; child < lastChild; ++child)
+      {
+        bestChild = m_compare(*this->element(child), *this->element(bestChild)) ? child : bestChild;
+      }
+
+      if (!m_compare(*this->element(bestChild), item))
+      {
+        break;
+      }
+      moveElement(bestChild, position);
+      position = bestChild;
+    }
+
+    *this->element(position) = std::move(item);
+    m_heapHandle[position]   = handle;
+    m_heapPosition[handle]   = position;
+  }
+
+  /*************************************************************************\
+   * dequeQueue Implementation
+  \*************************************************************************/
+  /**
+   * @brief    Statically allocated double-ended queue.
+   * @details  Elements are added and removed at both ends in O(1) and can be accessed by position, where position 0 is the
+   *           front. `push()` and `pop()` work like a `fifoQueue`: they add at the back and remove from the front. Like
+   *           `lifoQueue`, the deque rejects new elements when it is full. `spans()` exposes the queued elements as at most
+   *           two contiguous runs, so trivially copyable elements can be copied out with `memcpy`, and `releaseFront()`
+   *           then removes them.
+   *           Like iterating, `operator[]` and `spans()` are not thread-safe: they access the storage without locking, and the
+   *           references and spans are only valid until the deque is modified.
+   * @tparam   T          The type of elements stored in the deque.
+   * @tparam   queueSize  The fixed size of the deque.
+   * @tparam   lock_t     The lock policy that protects the deque.
+   */
+  template <typename T, size_t queueSize, typename lock_t = MEM::mutexLock>
+  class dequeQueue final : public queueBase<dequeQueue<T, queueSize, lock_t>, T, queueSize, lock_t>
+  {
+  public:
+    /**
+     * @brief      Constructs an element in place at the back of the deque, called by `push()`.
+     * @param[in]  args  The arguments forwarded to the constructor of `T`.
+     * @return     `true` if the element was constructed, `false` if the deque is full.
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args);
+
+    /**
+     * @brief      Constructs an element in place at the back of the deque.
+     * @param[in]  args  The arguments forwarded to the constructor of `T`.
+     * @return     `true` if the element was constructed, `false` if the deque is full.
+     */
+    template <typename... Args>
+    bool emplaceBack(Args&&... args);
+
+    /**
+     * @brief      Constructs an element in place at the front of the deque.
+     * @param[in]  args  The arguments forwarded to the constructor of `T`.
+     * @return     `true` if the element was constructed, `false` if the deque is full.
+     */
+    template <typename... Args>
+    bool emplaceFront(Args&&... args);
+
+    /**
+     * @brief      Adds an element at the back of the deque.
+     * @param[in]  item  The item to be added.
+     * @return     `true` if the item was added, `false` if the deque is full.
+     */
+    bool pushBack(const T& item);
+    bool pushBack(T&& item);
+
+    /**
+     * @brief      Adds an element at the front of the deque, e.g. to put back an element that was taken too early.
+     * @param[in]  item  The item to be added.
+     * @return     `true` if the item was added, `false` if the deque is full.
+     */
+    bool pushFront(const T& item);
+    bool pushFront(T&& item);
+
+    /**
+     * @brief       Removes the element at the front of the deque.
+     * @param[out]  item  A reference to store the removed item.
+     * @return      `true` if an item was removed, `false` if the deque is empty.
+     */
+    bool popFront(T& item);
+
+    /**
+     * @brief       Removes the element at the back of the deque.
+     * @param[out]  item  A reference to store the removed item.
+     * @return      `true` if an item was removed, `false` if the deque is empty.
+     */
+    bool popBack(T& item);
+
+    /**
+     * @brief       Copies the element at the front of the deque without removing it.
+     * @param[out]  item  A reference to store the copy.
+     * @return      `true` if the deque holds an element, `false` if it is empty.
+     */
+    bool peekFront(T& item) const;
+
+    /**
+     * @brief       Copies the element at the back of the deque without removing it.
+     * @param[out]  item  A reference to store the copy.
+     * @return      `true` if the deque holds an element, `false` if it is empty.
+     */
+    bool peekBack(T& item) const;
+
+    /**
+     * @brief       Copies the element at a position without removing it.
+     * @param[in]   position  The position of the element, 0 is the front.
+     * @param[out]  item      A reference to store the copy.
+     * @return      `true` if the position holds an element, `false` if it is beyond the back of the deque.
+     */
+    bool peekAt(size_t position, T& item) const;
+
+    /**
+     * @brief      Accesses the element at a position without locking and without bounds check.
+     * @param[in]  position  The position of the element, 0 is the front. It must be less than `size()`.
+     * @return     Reference to the element.
+     */
+    T&       operator[](size_t position);
+    const T& operator[](size_t position) const;
+
+    /**
+     * @brief   Gets the queued elements, front first, as contiguous spans inside the storage, without locking.
+     * @return  The queued elements, `second` is empty if they do not wrap around the end of the storage.
+     */
+    MEM::memorySpanPair<T>       spans();
+    MEM::memorySpanPair<const T> spans() const;
+
+    /**
+     * @brief      Removes and destroys elements at the front of the deque, e.g. after they were copied out through `spans()`.
+     * @param[in]  count  The number of elements to remove.
+     * @return     The number of elements removed, limited to the number of queued elements.
+     */
+    size_t releaseFront(size_t count);
+
+  private:
+    friend class queueBase<dequeQueue<T, queueSize, lock_t>, T, queueSize, lock_t>;
+
+    /**
+     * @brief       Removes the element at the front of the deque, called by `pop()`.
+     * @param[out]  item  A reference to store the removed item.
+     * @return      `true` if an item was removed, `false` if the deque is empty.
+     */
+    bool popElement(T& item);
+
+    /**
+     * @brief      Converts a position relative to the front into an index of the storage.
+     * @param[in]  position  The position, which must be less than `queueSize`.
+     * @return     The index of the storage.
+     */
+    size_t indexOf(size_t position) const;
+  };
+
+  template <typename T, size_t queueSize, typename lock_t>
+  template <typename... Args>
+  bool dequeQueue<T, queueSize, lock_t>::emplace(Args&&... args)
+  {
+    return emplaceBack(std::forward<Args>(args)...);
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  template <typename... Args>
+  bool dequeQueue<T, queueSize, lock_t>::emplaceBack(Args&&... args)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (this->m_currentSize == queueSize)
+    {
+      return false;
+    }
+
+    this->construct(this->m_tail, std::forward<Args>(args)...);
+    this->m_tail = this->incrementIndex(this->m_tail);
+    this->m_currentSize++;
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  template <typename... Args>
+  bool dequeQueue<T, queueSize, lock_t>::emplaceFront(Args&&... args)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (this->m_currentSize == queueSize)
+    {
+      return false;
+    }
+
+    const size_t head = this->decrementIndex(this->m_head);
+    this->construct(head, std::forward<Args>(args)...);
+    this->m_head = head;
+    this->m_currentSize++;
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool dequeQueue<T, queueSize, lock_t>::pushBack(const T& item)
+  {
+    return emplaceBack(item);
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool dequeQueue<T, queueSize, lock_t>::pushBack(T&& item)
+  {
+    return emplaceBack(std::move(item));
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool dequeQueue<T, queueSize, lock_t>::pushFront(const T& item)
+  {
+    return emplaceFront(item);
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool dequeQueue<T, queueSize, lock_t>::pushFront(T&& item)
+  {
+    return emplaceFront(std::move(item));
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool dequeQueue<T, queueSize, lock_t>::popElement(T& item)
+  {
+    return popFront(item);
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool dequeQueue<T, queueSize, lock_t>::popFront(T& item)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (this->m_currentSize == 0)
+    {
+      return false;
+    }
+
+    item = std::move(*this->element(this->m_head));
+    this->destroy(this->m_head);
+    this->m_head = this->incrementIndex(this->m_head);
+    this->m_currentSize--;
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool dequeQueue<T, queueSize, lock_t>::popBack(T& item)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (this->m_currentSize == 0)
+    {
+      return false;
+    }
+
+    this->m_tail = this->decrementIndex(this->m_tail);
+    item         = std::move(*this->element(this->m_tail));
+    this->destroy(this->m_tail);
+    this->m_currentSize--;
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool dequeQueue<T, queueSize, lock_t>::peekFront(T& item) const
+  {
+    return peekAt(0, item);
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool dequeQueue<T, queueSize, lock_t>::peekBack(T& item) const
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (this->m_currentSize == 0)
+    {
+      return false;
+    }
+
+    item = *this->element(this->decrementIndex(this->m_tail));
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  bool dequeQueue<T, queueSize, lock_t>::peekAt(size_t position, T& item) const
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    if (position >= this->m_currentSize)
+    {
+      return false;
+    }
+
+    item = *this->element(indexOf(position));
+    return true;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  T& dequeQueue<T, queueSize, lock_t>::operator[](size_t position)
+  {
+    return *this->element(indexOf(position));
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  const T& dequeQueue<T, queueSize, lock_t>::operator[](size_t position) const
+  {
+    return *this->element(indexOf(position));
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  MEM::memorySpanPair<T> dequeQueue<T, queueSize, lock_t>::spans()
+  {
+    const size_t firstCount = (this->m_currentSize < queueSize - this->m_head) ? this->m_currentSize : queueSize - this->m_head;
+
+    MEM::memorySpanPair<T> spans;
+    spans.first.data  = (firstCount > 0) ? this->element(this->m_head) : nullptr;
+    spans.first.size  = firstCount;
+    spans.second.data = (this->m_currentSize > firstCount) ? this->element(0) : nullptr;
+    spans.second.size = this->m_currentSize - firstCount;
+    return spans;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  MEM::memorySpanPair<const T> dequeQueue<T, queueSize, lock_t>::spans() const
+  {
+    const size_t firstCount = (this->m_currentSize < queueSize - this->m_head) ? this->m_currentSize : queueSize - this->m_head;
+
+    MEM::memorySpanPair<const T> spans;
+    spans.first.data  = (firstCount > 0) ? this->element(this->m_head) : nullptr;
+    spans.first.size  = firstCount;
+    spans.second.data = (this->m_currentSize > firstCount) ? this->element(0) : nullptr;
+    spans.second.size = this->m_currentSize - firstCount;
+    return spans;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  size_t dequeQueue<T, queueSize, lock_t>::releaseFront(size_t count)
+  {
+    std::lock_guard<lock_t> lock(this->m_lock);
+
+    const size_t releaseCount = (count < this->m_currentSize) ? count : this->m_currentSize;
+    this->destroyRange(this->m_head, releaseCount);
+    this->m_head = this->advanceIndex(this->m_head, releaseCount);
+    this->m_currentSize -= releaseCount;
+    return releaseCount;
+  }
+
+  template <typename T, size_t queueSize, typename lock_t>
+  size_t dequeQueue<T, queueSize, lock_t>::indexOf(size_t position) const
+  {
+    return this->advanceIndex(this->m_head, position);
+  }
+
+  /*************************************************************************\
+   * Lock-free fifoQueue Implementation
+  \*************************************************************************/
+  /**
+   * @brief    Common implementation of the lock-free `fifoQueue` variants on top of a lock-free ring buffer.
+   * @tparam   T          The type of elements stored in the queue.
+   * @tparam   queueSize  The fixed size of the queue.
+   * @tparam   ring_t     The lock-free ring buffer that holds the elements.
+   */
+  template <typename T, size_t queueSize, typename ring_t>
+  class lockFreeFifoQueue
+  {
+  public:
+    /**
+     * @brief      Adds an element to the queue.
+     * @param[in]  item  The item to be added.
+     * @return     `true` if the item was added successfully, `false` if the queue is full.
+     */
+    bool push(const T& item);
+
+    /**
+     * @brief      Adds an element to the queue (move semantics).
+     * @param[in]  item  The item to be added.
+     * @return     `true` if the item was added successfully, `false` if the queue is full.
+     */
+    bool push(T&& item);
+
+    /**
+     * @brief      Constructs an element from its constructor arguments and adds it to the queue.
+     * @param[in]  args  The arguments forwarded to the constructor of `T`.
+     * @return     `true` if the element was added successfully, `false` if the queue is full.
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args);
+
+    /**
+     * @brief       Removes an element from the queue.
+     * @param[out]  item  A reference to store the popped item.
+     * @return      `true` if the item was removed successfully, `false` if the queue is empty.
+     */
+    bool pop(T& item);
+
+    /**
+     * @brief   Checks if the queue is empty.
+     * @return  `true` if empty, `false` otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief   Checks if the queue is full.
+     * @return  `true` if full, `false` otherwise.
+     */
+    bool isFull() const;
+
+    /**
+     * @brief   Retrieves the current number of elements in the queue.
+     * @return  The number of elements in the queue, which may already be outdated under concurrent access.
+     */
+    size_t size() const;
+
+  private:
+    ring_t m_ring; //!< Lock-free ring buffer that holds the elements
+  };
+
+  /**
+   * @brief  Lock-free FIFO queue for a single producer and a single consumer, built on `spscRingBuffer`.
+   */
+  template <typename T, size_t queueSize>
+  class fifoQueue<T, queueSize, MEM::lockFreeSpsc> final
+    : public lockFreeFifoQueue<T, queueSize, MEM::spscRingBuffer<T, queueSize * sizeof(T)>>
+  {
+  };
+
+  /**
+   * @brief  Lock-free FIFO queue for multiple producers and a single consumer, built on `mpmcRingBuffer`.
+   */
+  template <typename T, size_t queueSize>
+  class fifoQueue<T, queueSize, MEM::lockFreeMpsc> final
+    : public lockFreeFifoQueue<T, queueSize, MEM::mpmcRingBuffer<T, queueSize * sizeof(T)>>
+  {
+  };
+
+  template <typename T, size_t queueSize, typename ring_t>
+  bool lockFreeFifoQueue<T, queueSize, ring_t>::push(const T& item)
+  {
+    return m_ring.write(item);
+  }
+
+  template <typename T, size_t queueSize, typename ring_t>
+  bool lockFreeFifoQueue<T, queueSize, ring_t>::push(T&& item)
+  {
+    return m_ring.write(std::move(item));
+  }
+
+  template <typename T, size_t queueSize, typename ring_t>
+  template <typename... Args>
+  bool lockFreeFifoQueue<T, queueSize, ring_t>::emplace(Args&&... args)
+  {
+    return push(T(std::forward<Args>(args)...));
+  }
+
+  template <typename T, size_t queueSize, typename ring_t>
+  bool lockFreeFifoQueue<T, queueSize, ring_t>::pop(T& item)
+  {
+    return m_ring.read(item);
+  }
+
+  template <typename T, size_t queueSize, typename ring_t>
+  bool lockFreeFifoQueue<T, queueSize, ring_t>::isEmpty() const
+  {
+    return m_ring.isEmpty();
+  }
+
+  template <typename T, size_t queueSize, typename ring_t>
+  bool lockFreeFifoQueue<T, queueSize, ring_t>::isFull() const
+  {
+    return m_ring.isFull();
+  }
+
+  template <typename T, size_t queueSize, typename ring_t>
+  size_t lockFreeFifoQueue<T, queueSize, ring_t>::size() const
+  {
+    return m_ring.count();
   }
 
 } // namespace MEM
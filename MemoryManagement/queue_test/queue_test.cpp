@@ -1,5 +1,12 @@
 #include "../../Tools/Testing/test_helper.hpp"
 #include "../queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 
 #if defined(QT_TESTLIB_LIB)
@@ -9,6 +16,50 @@
 #include "gtest/gtest.h"
 #endif
 
+namespace
+{
+  /**
+   * @brief          Push a sequence of values into any queue and pop one element back through the common base class.
+   * @param[in,out]  queue
+   *                 The queue to use, must be able to hold at least `count` elements.
+   * @param[in]      count
+   *                 The number of values 0 to `count - 1` to push.
+   * @return         The popped element, or -1 if the queue was empty.
+   */
+  template <typename derived_t, size_t queueSize, typename lock_t>
+  int pushSequenceAndPop(MEM::queueBase<derived_t, int, queueSize, lock_t>& queue, int count)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      queue.push(i);
+    }
+    int value = -1;
+    queue.pop(value);
+    return value;
+  }
+
+  /**
+   * @brief  Device command that is scheduled by deadline, and by urgency for equal deadlines.
+   */
+  struct scheduledCommand_t
+  {
+    uint32_t deadline; //!< Time at which the command is due.
+    uint8_t  urgency;  //!< Higher values are executed first for the same deadline.
+    int      command;  //!< Identifier of the command.
+  };
+
+  /**
+   * @brief  Orders the commands by deadline and urgency, so the earliest and most urgent command is popped first.
+   */
+  struct commandBefore_t
+  {
+    bool operator()(const scheduledCommand_t& first, const scheduledCommand_t& second) const
+    {
+      return (first.deadline != second.deadline) ? first.deadline < second.deadline : first.urgency > second.urgency;
+    }
+  };
+} // namespace
+
 #if defined(QT_TESTLIB_LIB)
 class testQueue : public QObject
 {
@@ -21,6 +72,29 @@ private slots:
   void testLifoOverflow();
   void testConcurrentFifoOperations();
   void testConcurrentLifoOperations();
+  void testFifoPowerOfTwoWrapAround();
+  void testLifoPowerOfTwoWrapAround();
+  void testFifoPopWait();
+  void testFifoPopWaitThreshold();
+  void testFifoPushWaitBackpressure();
+  void testFifoClose();
+  void testQueueMoveOnlyType();
+  void testQueueElementLifetime();
+  void testFifoOverwriteFromOldest();
+  void testQueueLockPolicies();
+  void testFifoLockFreeSpsc();
+  void testFifoLockFreeMpsc();
+  void testQueueStaticDispatch();
+  void testFifoBatchOperations();
+  void testLifoBatchOperations();
+  void testQueueBatchNonTrivialType();
+  void testPriorityQueueOrder();
+  void testPriorityQueueDecreaseKey();
+  void testPriorityQueueHeapify();
+  void testQueueSnapshot();
+  void testQueueSnapshotConcurrent();
+  void testDequeQueueBothEnds();
+  void testDequeQueueSpans();
 };
 #endif
 
@@ -201,6 +275,837 @@ TEST_CASE(testQueue, testConcurrentLifoOperations)
   QVERIFY(!lifoQueue.isEmpty());
 }
 
+TEST_CASE(testQueue, testFifoPowerOfTwoWrapAround)
+{
+  const uint16_t                  QUEUE_SIZE = 4;
+  MEM::fifoQueue<int, QUEUE_SIZE> fifoQueue;
+  int                             value;
+
+  // Cycle through the storage several times so the masked indices wrap around
+  for (int i = 0; i < 10; ++i)
+  {
+    fifoQueue.push(i);
+    fifoQueue.push(i + 100);
+    QCOMPARE(fifoQueue.pop(value), true);
+    QCOMPARE(value, i);
+    QCOMPARE(fifoQueue.pop(value), true);
+    QCOMPARE(value, i + 100);
+  }
+
+  // Overwriting the oldest element also wraps with the mask
+  for (int i = 0; i < QUEUE_SIZE + 2; ++i)
+  {
+    fifoQueue.push(i);
+  }
+  for (int i = 2; i < QUEUE_SIZE + 2; ++i)
+  {
+    QCOMPARE(fifoQueue.pop(value), true);
+    QCOMPARE(value, i);
+  }
+  QVERIFY(fifoQueue.isEmpty());
+}
+
+TEST_CASE(testQueue, testLifoPowerOfTwoWrapAround)
+{
+  const uint16_t                  QUEUE_SIZE = 4;
+  MEM::lifoQueue<int, QUEUE_SIZE> lifoQueue;
+  int                             value;
+
+  // Popping from index zero must wrap to the end of the storage with the mask
+  QCOMPARE(lifoQueue.push(1), true);
+  QCOMPARE(lifoQueue.pop(value), true);
+  QCOMPARE(value, 1);
+  QCOMPARE(lifoQueue.pop(value), false);
+
+  for (int i = 0; i < QUEUE_SIZE; ++i)
+  {
+    QCOMPARE(lifoQueue.push(i), true);
+  }
+  for (int i = QUEUE_SIZE - 1; i >= 0; --i)
+  {
+    QCOMPARE(lifoQueue.pop(value), true);
+    QCOMPARE(value, i);
+  }
+}
+
+TEST_CASE(testQueue, testFifoPopWait)
+{
+  MEM::fifoQueue<int, 8> fifoQueue;
+  int                    value = 0;
+
+  QCOMPARE(fifoQueue.popWait(value, std::chrono::milliseconds(10)), false);
+
+  std::thread producer(
+    [&]()
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      fifoQueue.push(42);
+    });
+
+  QCOMPARE(fifoQueue.popWait(value, std::chrono::seconds(5)), true);
+  QCOMPARE(value, 42);
+  producer.join();
+}
+
+TEST_CASE(testQueue, testFifoPopWaitThreshold)
+{
+  const int              BATCH_SIZE = 4;
+  MEM::fifoQueue<int, 8> fifoQueue;
+  std::atomic<int>       pushed(0);
+  int                    value = 0;
+  fifoQueue.setWakeupThreshold(BATCH_SIZE);
+
+  std::thread producer(
+    [&]()
+    {
+      for (int i = 0; i < BATCH_SIZE; ++i)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        pushed.store(i + 1);
+        fifoQueue.push(i);
+      }
+    });
+
+  // The consumer is only woken once the whole batch is queued
+  QCOMPARE(fifoQueue.popWait(value, std::chrono::seconds(5)), true);
+  QCOMPARE(pushed.load(), BATCH_SIZE);
+  QCOMPARE(value, 0);
+  QCOMPARE(static_cast<int>(fifoQueue.size()), BATCH_SIZE - 1);
+  producer.join();
+
+  // On timeout a partial batch is still delivered
+  QCOMPARE(fifoQueue.popWait(value, std::chrono::milliseconds(10)), true);
+  QCOMPARE(value, 1);
+}
+
+TEST_CASE(testQueue, testFifoPushWaitBackpressure)
+{
+  MEM::fifoQueue<int, 4> fifoQueue(MEM::QUEUE_REJECT);
+  const int              VALUES[] = {0, 1, 2, 3, 4, 5};
+  int                    value    = 0;
+
+  // A full queue rejects new elements instead of overwriting the oldest one
+  QCOMPARE(static_cast<int>(fifoQueue.pushN(VALUES, 6)), 4);
+  QCOMPARE(fifoQueue.push(4), false);
+  QCOMPARE(fifoQueue.pushWait(4, std::chrono::milliseconds(10)), false);
+
+  std::thread consumer(
+    [&]()
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      int item = 0;
+      fifoQueue.pop(item);
+    });
+
+  // The producer sleeps until the consumer frees a slot
+  QCOMPARE(fifoQueue.pushWait(4, std::chrono::seconds(5)), true);
+  consumer.join();
+  for (int i = 1; i <= 4; ++i)
+  {
+    QCOMPARE(fifoQueue.pop(value), true);
+    QCOMPARE(value, i);
+  }
+
+  // An overwriting queue never blocks the producer
+  fifoQueue.setOverflowBehavior(MEM::QUEUE_DROP_OLDEST);
+  QCOMPARE(static_cast<int>(fifoQueue.pushN(VALUES, 6)), 6);
+  QCOMPARE(fifoQueue.pushWait(6, std::chrono::milliseconds(0)), true);
+  QCOMPARE(fifoQueue.pop(value), true);
+  QCOMPARE(value, 3);
+}
+
+TEST_CASE(testQueue, testFifoClose)
+{
+  MEM::fifoQueue<int, 4> fifoQueue(MEM::QUEUE_REJECT);
+  std::atomic<int>       consumed(0);
+  std::atomic<int>       failedProducers(0);
+
+  // Sleeping consumers drain the queue after close() and then fail
+  std::vector<std::thread> consumers;
+  for (int i = 0; i < 2; ++i)
+  {
+    consumers.emplace_back(
+      [&]()
+      {
+        int item = 0;
+        while (fifoQueue.popWait(item, std::chrono::seconds(5)))
+        {
+          consumed++;
+        }
+      });
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    QCOMPARE(fifoQueue.pushWait(i, std::chrono::seconds(5)), true);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  // A producer keeps the queue full until it is closed
+  const auto start = std::chrono::steady_clock::now();
+  fifoQueue.setWakeupThreshold(4);
+  const int VALUES[] = {3, 4, 5, 6};
+  QCOMPARE(static_cast<int>(fifoQueue.pushN(VALUES, 3)), 3);
+  std::thread producer(
+    [&]()
+    {
+      while (fifoQueue.pushWait(7, std::chrono::seconds(5)))
+      {
+      }
+      failedProducers++;
+    });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  fifoQueue.close();
+  producer.join();
+  for (std::thread& consumer : consumers)
+  {
+    consumer.join();
+  }
+
+  QVERIFY(fifoQueue.isClosed());
+  QVERIFY(fifoQueue.isEmpty());
+  QCOMPARE(failedProducers.load(), 1);
+  QVERIFY(consumed.load() >= 6);
+  QVERIFY(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+
+  // A closed queue rejects all new elements
+  int value = 0;
+  QCOMPARE(fifoQueue.push(1), false);
+  QCOMPARE(static_cast<int>(fifoQueue.pushN(VALUES, 4)), 0);
+  QCOMPARE(fifoQueue.popWait(value, std::chrono::seconds(5)), false);
+}
+
+TEST_CASE(testQueue, testQueueMoveOnlyType)
+{
+  MEM::fifoQueue<std::unique_ptr<int>, 2> fifoQueue;
+  MEM::lifoQueue<std::unique_ptr<int>, 2> lifoQueue;
+  std::unique_ptr<int>                    value;
+
+  QCOMPARE(fifoQueue.push(std::unique_ptr<int>(new int(1))), true);
+  QCOMPARE(fifoQueue.emplace(new int(2)), true);
+  QCOMPARE(fifoQueue.emplace(new int(3)), true);
+  QCOMPARE(fifoQueue.pop(value), true);
+  QCOMPARE(*value, 2);
+  QCOMPARE(fifoQueue.pop(value), true);
+  QCOMPARE(*value, 3);
+
+  QCOMPARE(lifoQueue.push(std::unique_ptr<int>(new int(1))), true);
+  QCOMPARE(lifoQueue.emplace(new int(2)), true);
+  QCOMPARE(lifoQueue.push(std::unique_ptr<int>(new int(3))), false);
+  QCOMPARE(lifoQueue.pop(value), true);
+  QCOMPARE(*value, 2);
+  QCOMPARE(*(*lifoQueue.begin()), 1);
+}
+
+TEST_CASE(testQueue, testQueueElementLifetime)
+{
+  // Element type without default constructor that counts its live instances
+  struct trackedElement
+  {
+    int  value;
+    int* liveCount;
+
+    trackedElement(int initialValue, int* counter) : value(initialValue), liveCount(counter)
+    {
+      ++(*liveCount);
+    }
+    trackedElement(const trackedElement& other) : value(other.value), liveCount(other.liveCount)
+    {
+      ++(*liveCount);
+    }
+    trackedElement& operator=(const trackedElement& other) = default;
+    ~trackedElement()
+    {
+      --(*liveCount);
+    }
+  };
+
+  int liveCount = 0;
+  {
+    MEM::fifoQueue<trackedElement, 4>     fifoQueue;
+    MEM::lifoQueue<trackedElement, 4>     lifoQueue;
+    MEM::queueSnapshot<trackedElement, 4> snapshot;
+
+    // No element is constructed up front
+    QCOMPARE(liveCount, 0);
+
+    for (int i = 0; i < 6; ++i)
+    {
+      QCOMPARE(fifoQueue.emplace(i, &liveCount), true);
+      lifoQueue.emplace(i, &liveCount);
+    }
+    QCOMPARE(liveCount, 8);
+
+    trackedElement value(0, &liveCount);
+    QCOMPARE(fifoQueue.pop(value), true);
+    QCOMPARE(value.value, 2);
+    QCOMPARE(lifoQueue.pop(value), true);
+    QCOMPARE(value.value, 3);
+    QCOMPARE(liveCount, 7);
+
+    QCOMPARE(fifoQueue.push(value), true);
+    QCOMPARE(liveCount, 8);
+
+    // A snapshot only constructs the copies, and a new capture destroys the previous ones
+    QCOMPARE(static_cast<int>(snapshot.capture(fifoQueue)), 4);
+    QCOMPARE(liveCount, 12);
+    QCOMPARE(static_cast<int>(snapshot.capture(lifoQueue)), 3);
+    QCOMPARE(liveCount, 11);
+    QCOMPARE(snapshot[0].value, 0);
+  }
+
+  // The destructors destroy the remaining elements
+  QCOMPARE(liveCount, 0);
+}
+
+TEST_CASE(testQueue, testFifoOverwriteFromOldest)
+{
+  MEM::fifoQueue<std::string, 3> fifoQueue;
+  const std::string              FIRST(64, 'a');
+  std::string                    value;
+
+  fifoQueue.push(FIRST);
+  fifoQueue.push(std::string(64, 'b'));
+  fifoQueue.push(std::string(64, 'c'));
+
+  // Pushing the oldest element into a full queue copies it before it is overwritten
+  QVERIFY(fifoQueue.emplace(*fifoQueue.begin()));
+  QVERIFY(fifoQueue.push(*fifoQueue.begin()));
+  QVERIFY(fifoQueue.pop(value));
+  QCOMPARE(value, std::string(64, 'c'));
+  QVERIFY(fifoQueue.pop(value));
+  QCOMPARE(value, FIRST);
+  QVERIFY(fifoQueue.pop(value));
+  QCOMPARE(value, std::string(64, 'b'));
+}
+
+TEST_CASE(testQueue, testQueueLockPolicies)
+{
+  // Without locking the queues behave exactly like the default ones
+  MEM::fifoQueue<int, 4, MEM::noLock> fifoQueue;
+  MEM::lifoQueue<int, 4, MEM::noLock> lifoQueue;
+  for (int i = 0; i < 6; ++i)
+  {
+    fifoQueue.push(i);
+    lifoQueue.push(i);
+  }
+  int value;
+  QCOMPARE(fifoQueue.pop(value), true);
+  QCOMPARE(value, 2);
+  QCOMPARE(lifoQueue.pop(value), true);
+  QCOMPARE(value, 3);
+  QCOMPARE(static_cast<int>(fifoQueue.size()), 3);
+
+  // The spin lock protects concurrent producers, so no element is lost
+  const int                                THREAD_COUNT = 4;
+  const int                                PUSH_COUNT   = 1000;
+  MEM::fifoQueue<int, 4096, MEM::spinLock> spinQueue;
+  std::vector<std::thread>                 producers;
+  for (int threadIndex = 0; threadIndex < THREAD_COUNT; ++threadIndex)
+  {
+    producers.emplace_back([&spinQueue, threadIndex, PUSH_COUNT]() {
+      for (int i = 0; i < PUSH_COUNT; ++i)
+      {
+        spinQueue.push(threadIndex * PUSH_COUNT + i);
+      }
+    });
+  }
+  for (auto& producer : producers)
+  {
+    producer.join();
+  }
+  QCOMPARE(static_cast<int>(spinQueue.size()), THREAD_COUNT * PUSH_COUNT);
+
+  long long sum = 0;
+  while (spinQueue.pop(value))
+  {
+    sum += value;
+  }
+  QCOMPARE(sum, static_cast<long long>(THREAD_COUNT * PUSH_COUNT) * (THREAD_COUNT * PUSH_COUNT - 1) / 2);
+}
+
+TEST_CASE(testQueue, testFifoLockFreeSpsc)
+{
+  const int                                  TRANSFER_COUNT = 100000;
+  MEM::fifoQueue<int, 64, MEM::lockFreeSpsc> fifoQueue;
+
+  // Rejects instead of overwriting when full
+  for (int i = 0; i < 64; ++i)
+  {
+    QCOMPARE(fifoQueue.push(i), true);
+  }
+  QVERIFY(fifoQueue.isFull());
+  QCOMPARE(fifoQueue.emplace(64), false);
+  int value;
+  for (int i = 0; i < 64; ++i)
+  {
+    QCOMPARE(fifoQueue.pop(value), true);
+    QCOMPARE(value, i);
+  }
+  QVERIFY(fifoQueue.isEmpty());
+
+  std::thread producer([&fifoQueue, TRANSFER_COUNT]() {
+    for (int i = 0; i < TRANSFER_COUNT;)
+    {
+      if (fifoQueue.push(i))
+      {
+        ++i;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  bool inOrder = true;
+  for (int expected = 0; expected < TRANSFER_COUNT;)
+  {
+    if (fifoQueue.pop(value))
+    {
+      inOrder = inOrder && (value == expected);
+      ++expected;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  QVERIFY(inOrder);
+  QVERIFY(fifoQueue.isEmpty());
+}
+
+TEST_CASE(testQueue, testFifoLockFreeMpsc)
+{
+  const int                                   THREAD_COUNT = 4;
+  const int                                   PUSH_COUNT   = 20000;
+  MEM::fifoQueue<int, 256, MEM::lockFreeMpsc> fifoQueue;
+  std::vector<std::thread>                    producers;
+
+  for (int threadIndex = 0; threadIndex < THREAD_COUNT; ++threadIndex)
+  {
+    producers.emplace_back([&fifoQueue, threadIndex, PUSH_COUNT]() {
+      for (int i = 0; i < PUSH_COUNT;)
+      {
+        if (fifoQueue.push(threadIndex * PUSH_COUNT + i))
+        {
+          ++i;
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // The elements of each producer arrive in the order they were pushed
+  std::vector<int> nextValue(THREAD_COUNT, 0);
+  bool             inOrder = true;
+  int              value;
+  for (int received = 0; received < THREAD_COUNT * PUSH_COUNT;)
+  {
+    if (fifoQueue.pop(value))
+    {
+      const int threadIndex = value / PUSH_COUNT;
+      inOrder               = inOrder && (value % PUSH_COUNT == nextValue[threadIndex]);
+      ++nextValue[threadIndex];
+      ++received;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+  for (auto& producer : producers)
+  {
+    producer.join();
+  }
+  QVERIFY(inOrder);
+  QVERIFY(fifoQueue.isEmpty());
+}
+
+TEST_CASE(testQueue, testQueueStaticDispatch)
+{
+  MEM::fifoQueue<int, 8> fifoQueue;
+  MEM::lifoQueue<int, 8> lifoQueue;
+
+  // Without virtual functions the queues carry no vtable pointer
+  static_assert(!std::is_polymorphic<MEM::fifoQueue<int, 8>>::value, "fifoQueue must not be polymorphic");
+  static_assert(!std::is_polymorphic<MEM::lifoQueue<int, 8>>::value, "lifoQueue must not be polymorphic");
+  static_assert(!std::is_polymorphic<MEM::fifoQueue<int, 8, MEM::lockFreeSpsc>>::value, "fifoQueue must not be polymorphic");
+
+  // The common base class dispatches to the FIFO and LIFO behavior at compile time
+  QCOMPARE(pushSequenceAndPop(fifoQueue, 4), 0);
+  QCOMPARE(pushSequenceAndPop(lifoQueue, 4), 3);
+  QCOMPARE(static_cast<int>(fifoQueue.size()), 3);
+  QCOMPARE(static_cast<int>(lifoQueue.size()), 3);
+}
+
+TEST_CASE(testQueue, testFifoBatchOperations)
+{
+  MEM::fifoQueue<int, 8> fifoQueue;
+  const int              VALUES[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  int                    values[12];
+
+  // A batch that wraps around the end of the storage
+  QCOMPARE(static_cast<int>(fifoQueue.pushN(VALUES, 6)), 6);
+  QCOMPARE(static_cast<int>(fifoQueue.popN(values, 4)), 4);
+  QCOMPARE(static_cast<int>(fifoQueue.pushN(VALUES + 6, 5)), 5);
+  QCOMPARE(static_cast<int>(fifoQueue.size()), 7);
+  QCOMPARE(static_cast<int>(fifoQueue.popN(values, 12)), 7);
+  for (int i = 0; i < 7; ++i)
+  {
+    QCOMPARE(values[i], i + 4);
+  }
+  QCOMPARE(static_cast<int>(fifoQueue.popN(values, 12)), 0);
+
+  // Overflowing batches overwrite the oldest elements, like push()
+  fifoQueue.pushN(VALUES, 5);
+  fifoQueue.pushN(VALUES + 5, 5);
+  QCOMPARE(static_cast<int>(fifoQueue.popN(values, 12)), 8);
+  QCOMPARE(values[0], 2);
+  QCOMPARE(values[7], 9);
+  QCOMPARE(static_cast<int>(fifoQueue.pushN(VALUES, 12)), 12);
+  QCOMPARE(static_cast<int>(fifoQueue.popN(values, 12)), 8);
+  QCOMPARE(values[0], 4);
+  QCOMPARE(values[7], 11);
+
+  // drainTo() hands over all elements in FIFO order
+  fifoQueue.pushN(VALUES, 3);
+  int expected = 0;
+  QCOMPARE(static_cast<int>(fifoQueue.drainTo([&expected](int&& value) { expected += (value == expected) ? 1 : 100; })), 3);
+  QCOMPARE(expected, 3);
+  QVERIFY(fifoQueue.isEmpty());
+}
+
+TEST_CASE(testQueue, testLifoBatchOperations)
+{
+  MEM::lifoQueue<int, 8> lifoQueue;
+  const int              VALUES[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  int                    values[10];
+
+  // Elements that do not fit are rejected
+  QCOMPARE(static_cast<int>(lifoQueue.pushN(VALUES, 6)), 6);
+  QCOMPARE(static_cast<int>(lifoQueue.pushN(VALUES + 6, 4)), 2);
+  QVERIFY(lifoQueue.isFull());
+
+  // The top element comes first
+  QCOMPARE(static_cast<int>(lifoQueue.popN(values, 3)), 3);
+  QCOMPARE(values[0], 7);
+  QCOMPARE(values[2], 5);
+
+  // drainTo() hands over the remaining elements top first
+  int expected = 4;
+  QCOMPARE(static_cast<int>(lifoQueue.drainTo([&expected](int&& value) { expected -= (value == expected) ? 1 : 100; })), 5);
+  QCOMPARE(expected, -1);
+  QCOMPARE(static_cast<int>(lifoQueue.popN(values, 10)), 0);
+  QVERIFY(lifoQueue.isEmpty());
+}
+
+TEST_CASE(testQueue, testQueueBatchNonTrivialType)
+{
+  MEM::fifoQueue<std::string, 4> fifoQueue;
+  MEM::lifoQueue<std::string, 4> lifoQueue;
+  const std::string              VALUES[] = {"zero", "one", "two", "three", "four", "five"};
+  std::string                    values[6];
+
+  // Elements that are not trivially copyable are constructed and destroyed one by one
+  fifoQueue.pushN(VALUES, 3);
+  fifoQueue.pushN(VALUES + 3, 3);
+  QCOMPARE(static_cast<int>(fifoQueue.popN(values, 6)), 4);
+  QCOMPARE(values[0], std::string("two"));
+  QCOMPARE(values[3], std::string("five"));
+
+  QCOMPARE(static_cast<int>(lifoQueue.pushN(VALUES, 6)), 4);
+  QCOMPARE(static_cast<int>(lifoQueue.popN(values, 2)), 2);
+  QCOMPARE(values[0], std::string("three"));
+  QCOMPARE(values[1], std::string("two"));
+}
+
+TEST_CASE(testQueue, testPriorityQueueOrder)
+{
+  const uint16_t                      QUEUE_SIZE = 100;
+  MEM::priorityQueue<int, QUEUE_SIZE> priorityQueue;
+  std::vector<int>                    values;
+  int                                 value;
+
+  // Pseudo-random values, popped in ascending order
+  for (int i = 0; i < QUEUE_SIZE; ++i)
+  {
+    values.push_back((i * 37) % 101);
+    QCOMPARE(priorityQueue.push(values.back()), true);
+  }
+  QCOMPARE(priorityQueue.push(0), false); // Full
+  std::sort(values.begin(), values.end());
+
+  QCOMPARE(priorityQueue.peek(value), true);
+  QCOMPARE(value, values.front());
+  for (int i = 0; i < QUEUE_SIZE; ++i)
+  {
+    QCOMPARE(priorityQueue.pop(value), true);
+    QCOMPARE(value, values[i]);
+  }
+  QCOMPARE(priorityQueue.pop(value), false);
+
+  // A custom comparison orders by deadline first and urgency second
+  MEM::priorityQueue<scheduledCommand_t, 8, commandBefore_t> commandQueue;
+  scheduledCommand_t                                         command;
+  commandQueue.push({200, 1, 1});
+  commandQueue.push({100, 1, 2});
+  commandQueue.push({100, 5, 3});
+  commandQueue.emplace(scheduledCommand_t{300, 9, 4});
+  QCOMPARE(commandQueue.pop(command), true);
+  QCOMPARE(command.command, 3);
+  QCOMPARE(commandQueue.pop(command), true);
+  QCOMPARE(command.command, 2);
+  QCOMPARE(commandQueue.pop(command), true);
+  QCOMPARE(command.command, 1);
+}
+
+TEST_CASE(testQueue, testPriorityQueueDecreaseKey)
+{
+  MEM::priorityQueue<int, 16> priorityQueue;
+  size_t                      handles[16];
+  int                         value;
+
+  for (int i = 0; i < 16; ++i)
+  {
+    QCOMPARE(priorityQueue.push(100 + i, handles[i]), true);
+  }
+
+  // The last element moves to the top, a lower priority is rejected
+  QCOMPARE(priorityQueue.decreaseKey(handles[15], 5), true);
+  QCOMPARE(priorityQueue.decreaseKey(handles[3], 200), false);
+  QCOMPARE(priorityQueue.decreaseKey(handles[7], 50), true);
+  QCOMPARE(priorityQueue.pop(value), true);
+  QCOMPARE(value, 5);
+  QCOMPARE(priorityQueue.pop(value), true);
+  QCOMPARE(value, 50);
+
+  // Handles of popped elements become invalid and are reused for new elements
+  QCOMPARE(priorityQueue.contains(handles[15]), false);
+  QCOMPARE(priorityQueue.decreaseKey(handles[15], 1), false);
+  QCOMPARE(priorityQueue.contains(handles[0]), true);
+  size_t handle;
+  QCOMPARE(priorityQueue.push(99, handle), true);
+  QVERIFY(handle == handles[7]);
+  QCOMPARE(priorityQueue.decreaseKey(handle, 10), true);
+  QCOMPARE(priorityQueue.pop(value), true);
+  QCOMPARE(value, 10);
+  for (int expected = 100; expected < 115; ++expected)
+  {
+    if (expected != 107)
+    {
+      QCOMPARE(priorityQueue.pop(value), true);
+      QCOMPARE(value, expected);
+    }
+  }
+  QVERIFY(priorityQueue.isEmpty());
+}
+
+TEST_CASE(testQueue, testPriorityQueueHeapify)
+{
+  MEM::priorityQueue<int, 32, std::greater<int>> priorityQueue;
+  int                                            values[40];
+  size_t                                         handles[40];
+  int                                            value;
+
+  for (int i = 0; i < 40; ++i)
+  {
+    values[i] = (i * 13) % 40;
+  }
+
+  // Elements that do not fit are rejected, the others are ordered in one pass
+  QCOMPARE(priorityQueue.push(1000), true);
+  QCOMPARE(static_cast<int>(priorityQueue.heapify(values, 40, handles)), 31);
+  QVERIFY(priorityQueue.isFull());
+  QCOMPARE(priorityQueue.decreaseKey(handles[30], 2000), true);
+  QCOMPARE(priorityQueue.pop(value), true);
+  QCOMPARE(value, 2000);
+  QCOMPARE(priorityQueue.pop(value), true);
+  QCOMPARE(value, 1000);
+
+  std::sort(values, values + 30, std::greater<int>());
+  for (int i = 0; i < 30; ++i)
+  {
+    QCOMPARE(priorityQueue.pop(value), true);
+    QCOMPARE(value, values[i]);
+  }
+  QVERIFY(priorityQueue.isEmpty());
+}
+
+TEST_CASE(testQueue, testQueueSnapshot)
+{
+  MEM::fifoQueue<int, 5>             fifoQueue;
+  MEM::lifoQueue<std::string, 4>     lifoQueue;
+  MEM::queueSnapshot<int, 5>         fifoSnapshot;
+  MEM::queueSnapshot<std::string, 4> lifoSnapshot;
+  int                                values[5];
+
+  QVERIFY(fifoSnapshot.isEmpty());
+  QCOMPARE(static_cast<int>(fifoSnapshot.capture(fifoQueue)), 0);
+
+  // A snapshot of a wrapped queue is in FIFO order and leaves the queue untouched
+  for (int i = 0; i < 7; ++i)
+  {
+    fifoQueue.push(i);
+  }
+  QCOMPARE(static_cast<int>(fifoSnapshot.capture(fifoQueue)), 5);
+  int expected = 2;
+  for (int value : fifoSnapshot)
+  {
+    QCOMPARE(value, expected++);
+  }
+  QCOMPARE(static_cast<int>(fifoQueue.size()), 5);
+
+  // The caller buffer may be smaller than the queue
+  QCOMPARE(static_cast<int>(fifoQueue.snapshot(values, 3)), 3);
+  QCOMPARE(values[0], 2);
+  QCOMPARE(values[2], 4);
+
+  // Non-trivial elements are copied in the iteration order of the queue
+  lifoQueue.push("a");
+  lifoQueue.push("b");
+  lifoQueue.push("c");
+  QCOMPARE(static_cast<int>(lifoSnapshot.capture(lifoQueue)), 3);
+  QCOMPARE(lifoSnapshot[0], std::string("a"));
+  QCOMPARE(lifoSnapshot[2], std::string("c"));
+  std::string item;
+  lifoQueue.pop(item);
+  QCOMPARE(static_cast<int>(lifoSnapshot.size()), 3);
+  QCOMPARE(static_cast<int>(lifoSnapshot.capture(lifoQueue)), 2);
+}
+
+TEST_CASE(testQueue, testQueueSnapshotConcurrent)
+{
+  const int                          ITEM_COUNT = 100000;
+  static MEM::fifoQueue<int, 64>     fifoQueue(MEM::QUEUE_REJECT);
+  static MEM::queueSnapshot<int, 64> snapshot;
+  std::atomic<bool>                  done(false);
+  bool                               consistent = true;
+
+  std::thread producer(
+    [&]()
+    {
+      for (int i = 0; i < ITEM_COUNT; ++i)
+      {
+        fifoQueue.pushWait(i, std::chrono::seconds(5));
+      }
+    });
+  std::thread consumer(
+    [&]()
+    {
+      int value = 0;
+      for (int i = 0; i < ITEM_COUNT; ++i)
+      {
+        fifoQueue.popWait(value, std::chrono::seconds(5));
+      }
+      done.store(true);
+    });
+
+  // Every snapshot is a consecutive run of the pushed sequence, even though the queue keeps changing
+  while (!done.load())
+  {
+    snapshot.capture(fifoQueue);
+    for (size_t i = 1; i < snapshot.size(); ++i)
+    {
+      consistent = consistent && (snapshot[i] == snapshot[i - 1] + 1);
+    }
+    std::this_thread::yield();
+  }
+  producer.join();
+  consumer.join();
+
+  QVERIFY(consistent);
+  QVERIFY(fifoQueue.isEmpty());
+}
+
+TEST_CASE(testQueue, testDequeQueueBothEnds)
+{
+  MEM::dequeQueue<int, 4> dequeQueue;
+  int                     value = 0;
+
+  QVERIFY(!dequeQueue.popFront(value));
+  QVERIFY(!dequeQueue.popBack(value));
+  QVERIFY(!dequeQueue.peekBack(value));
+
+  // Elements added at the front end up before the ones added at the back
+  QVERIFY(dequeQueue.pushBack(2));
+  QVERIFY(dequeQueue.pushFront(1));
+  QVERIFY(dequeQueue.pushBack(3));
+  QVERIFY(dequeQueue.pushFront(0));
+  QVERIFY(!dequeQueue.pushFront(-1));
+  QVERIFY(!dequeQueue.pushBack(4));
+  for (int i = 0; i < 4; ++i)
+  {
+    QCOMPARE(dequeQueue[i], i);
+  }
+  QVERIFY(dequeQueue.peekAt(2, value));
+  QCOMPARE(value, 2);
+  QVERIFY(!dequeQueue.peekAt(4, value));
+
+  // Both ends can be taken, and push()/pop() behave like a FIFO queue
+  QVERIFY(dequeQueue.popBack(value));
+  QCOMPARE(value, 3);
+  QVERIFY(dequeQueue.popFront(value));
+  QCOMPARE(value, 0);
+  QVERIFY(dequeQueue.push(10));
+  QVERIFY(dequeQueue.peekFront(value));
+  QCOMPARE(value, 1);
+  QVERIFY(dequeQueue.peekBack(value));
+  QCOMPARE(value, 10);
+  QVERIFY(dequeQueue.pop(value));
+  QCOMPARE(value, 1);
+
+  // Move-only elements are supported at both ends
+  MEM::dequeQueue<std::unique_ptr<int>, 2> pointerQueue;
+  std::unique_ptr<int>                     pointer;
+  QVERIFY(pointerQueue.pushFront(std::unique_ptr<int>(new int(1))));
+  QVERIFY(pointerQueue.emplaceFront(new int(0)));
+  QVERIFY(pointerQueue.popBack(pointer));
+  QCOMPARE(*pointer, 1);
+}
+
+TEST_CASE(testQueue, testDequeQueueSpans)
+{
+  MEM::dequeQueue<uint8_t, 8, MEM::noLock>        dequeQueue;
+  const MEM::dequeQueue<uint8_t, 8, MEM::noLock>& constDequeQueue = dequeQueue;
+  uint8_t                                         frame[8];
+
+  QCOMPARE(static_cast<int>(dequeQueue.spans().size()), 0);
+  QVERIFY(dequeQueue.spans().first.data == nullptr);
+
+  // Elements pushed to the front wrap around to the end of the storage
+  for (uint8_t i = 3; i < 6; ++i)
+  {
+    dequeQueue.pushBack(i);
+  }
+  for (uint8_t i = 3; i > 0; --i)
+  {
+    dequeQueue.pushFront(static_cast<uint8_t>(i - 1));
+  }
+  MEM::memorySpanPair<const uint8_t> spans = constDequeQueue.spans();
+  QCOMPARE(static_cast<int>(spans.first.size), 3);
+  QCOMPARE(static_cast<int>(spans.second.size), 3);
+
+  // A bulk consumer copies both spans and releases the copied elements
+  std::memcpy(frame, spans.first.data, spans.first.size);
+  std::memcpy(frame + spans.first.size, spans.second.data, spans.second.size);
+  for (int i = 0; i < 6; ++i)
+  {
+    QCOMPARE(static_cast<int>(frame[i]), i);
+  }
+  QCOMPARE(static_cast<int>(dequeQueue.releaseFront(4)), 4);
+  QCOMPARE(static_cast<int>(dequeQueue.spans().first.size), 2);
+  QCOMPARE(static_cast<int>(dequeQueue.spans().second.size), 0);
+  dequeQueue.spans().first.data[0] = 40;
+  QCOMPARE(static_cast<int>(dequeQueue[0]), 40);
+  QCOMPARE(static_cast<int>(dequeQueue.releaseFront(10)), 2);
+  QVERIFY(dequeQueue.isEmpty());
+}
+
 #if defined(QT_TESTLIB_LIB)
 QTEST_GUILESS_MAIN(testQueue)
 #include "queue_test.moc"
@@ -0,0 +1,377 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     record_ring_buffer.hpp
+ * @version  0.1
+ * @brief    Definition of the recordRingBuffer class.
+ * @details  The `recordRingBuffer` class is a circular buffer with statically allocated memory for records of variable size,
+ *           such as NMEA sentences or protocol messages. Every record is stored as a length prefix followed by its bytes,
+ *           packed back to back, so a record only occupies its actual size plus the prefix instead of the size of the
+ *           largest possible record.
+ *
+ *           A record is always stored in one contiguous piece. When a record does not fit between the write position and
+ *           the end of the storage, the rest of the storage is marked as padding and the record starts at the beginning.
+ *           Therefore `frontRecord()` can hand out the oldest record as a single span inside the buffer, which can be parsed
+ *           without copying it first.
+ *
+ *           To use the `recordRingBuffer` class, follow these steps:
+ *           -# Instantiate an instance with the desired buffer size in bytes as template parameter,
+ *              like this: `recordRingBuffer<1024> myRecordRingBuffer;`.
+ *           -# Use the `pushRecord()` function to add a record, like this:
+ *              `myRecordRingBuffer.pushRecord(mySentence, mySentenceLength);`.
+ *           -# Use the `frontRecord()` function to access the oldest record, like this:
+ *              `memorySpan<const uint8_t> myRecord = myRecordRingBuffer.frontRecord();`.
+ *           -# Process the record and free it with `popRecord()`.
+ *
+ * @note     The largest record that can be stored is `maxRecordSize()` bytes. Padding at the end of the storage is unused
+ *           until the read position passes it, so the number of records that fit depends on their sizes and order.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include "memory_span.hpp"
+#include "ring_buffer.hpp"
+#include <cstring>
+#include <limits>
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+  /**
+   * @brief    Class template for a ring buffer of variable-size records with statically allocated memory.
+   * @details  The `bufferSize` specifies the size of the storage in bytes, including the length prefixes.
+   * @tparam   bufferSize
+   *           The size of the buffer in bytes.
+   * @tparam   length_t
+   *           Unsigned integer type of the length prefix, `uint16_t` by default. Limits the size of a single record.
+   */
+  template <std::size_t bufferSize, typename length_t = uint16_t>
+  class recordRingBuffer
+  {
+  public:
+    /**
+     * @brief      Constructor that initializes the ring buffer.
+     * @param[in]  overwrite
+     *             Specifies whether to drop the oldest records in the buffer when a new record does not fit.
+     *             Default is `RINGBUFFER_NO_OVERWRITE`.
+     */
+    explicit recordRingBuffer(MEM::ringBufferOverwrite_e overwrite = MEM::RINGBUFFER_NO_OVERWRITE);
+
+    // Rule of Five
+    recordRingBuffer(const recordRingBuffer&)            = delete;
+    recordRingBuffer& operator=(const recordRingBuffer&) = delete;
+    recordRingBuffer(recordRingBuffer&&)                 = delete;
+    recordRingBuffer& operator=(recordRingBuffer&&)      = delete;
+    ~recordRingBuffer()                                  = default;
+
+    /**
+     * @brief  Reset the ring buffer to its initial, empty state.
+     */
+    void reset();
+
+    /**
+     * @brief   Get the overwrite behavior of the ring buffer.
+     * @return  The overwrite behavior as `ringBufferOverwrite_e`.
+     */
+    MEM::ringBufferOverwrite_e getOverwriteBehavior() const;
+
+    /**
+     * @brief   Check if the ring buffer is empty.
+     * @return  `true` if the buffer contains no records, `false` otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief   Get the number of records currently stored in the ring buffer.
+     * @return  The number of records currently stored.
+     */
+    std::size_t recordCount() const;
+
+    /**
+     * @brief   Get the number of bytes currently in use, including the length prefixes and padding.
+     * @return  The number of bytes in use.
+     */
+    std::size_t bytesUsed() const;
+
+    /**
+     * @brief   Get the size of the storage in bytes.
+     * @return  The capacity of the ring buffer in bytes.
+     */
+    constexpr std::size_t capacity() const;
+
+    /**
+     * @brief   Get the size of the largest record that can be stored.
+     * @return  The maximum record size in bytes.
+     */
+    constexpr std::size_t maxRecordSize() const;
+
+    /**
+     * @brief      Check if a record of a given size can be stored without dropping other records.
+     * @param[in]  size
+     *             The size of the record in bytes.
+     * @return     `true` if the record fits into the free space, `false` otherwise.
+     */
+    bool fits(std::size_t size) const;
+
+    /**
+     * @brief      Write a record to the ring buffer.
+     * @details    If the record does not fit and the overwrite behavior allows overwriting, the oldest records are dropped
+     *             until it does.
+     * @param[in]  data
+     *             Pointer to the bytes of the record, may be `nullptr` if `size` is 0.
+     * @param[in]  size
+     *             The size of the record in bytes.
+     * @return     `true` if the record was written successfully, `false` if it is larger than `maxRecordSize()`, or if it
+     *             does not fit and overwriting is not allowed.
+     */
+    bool pushRecord(const uint8_t data[], std::size_t size);
+
+    /**
+     * @brief   Access the oldest record without copying or removing it.
+     * @return  The record as a span inside the buffer, empty if the buffer contains no records. Use `isEmpty()` to tell an
+     *          empty buffer from an empty record.
+     */
+    MEM::memorySpan<const uint8_t> frontRecord() const;
+
+    /**
+     * @brief   Remove the oldest record from the ring buffer.
+     * @return  `true` if a record was removed, `false` if the buffer is empty.
+     */
+    bool popRecord();
+
+    /**
+     * @brief       Read the oldest record into an array and remove it from the ring buffer.
+     * @param[out]  data
+     *              The array to store the record.
+     * @param[in]   dataCount
+     *              The size of the array.
+     * @return      The size of the record in bytes. If the buffer is empty or the record does not fit into the array, 0 is
+     *              returned and the buffer is left unchanged.
+     */
+    std::size_t popRecord(uint8_t data[], std::size_t dataCount);
+
+  private:
+    static constexpr std::size_t headerSize    = sizeof(length_t);                      //!< Size of the length prefix.
+    static constexpr length_t    paddingMarker = std::numeric_limits<length_t>::max(); //!< Length prefix of padding.
+    static_assert(std::is_unsigned<length_t>::value, "Type length_t must be an unsigned integer type.");
+    static_assert(bufferSize > headerSize, "Buffer size is too small to hold even one empty record.");
+
+    MEM::ringBufferIndex<bufferSize> m_index;                 //!< Read and write positions in bytes.
+    std::size_t                      m_recordCount;           //!< Number of records currently stored.
+    MEM::ringBufferOverwrite_e       m_overwriteSetting;      //!< Overwrite behavior when a record does not fit.
+    uint8_t                          m_dataArray[bufferSize]; //!< The records with their length prefixes, and padding.
+
+    /**
+     * @brief      Get the number of padding bytes in front of the record at a position.
+     * @param[in]  position
+     *             The position in the data array at which a record or padding starts.
+     * @return     The number of bytes to skip, 0 if a record starts at the position.
+     */
+    std::size_t paddingAt(std::size_t position) const;
+
+    /**
+     * @brief      Read the length prefix at a position.
+     * @param[in]  position
+     *             The position in the data array of the length prefix.
+     * @return     The value of the length prefix.
+     */
+    length_t lengthAt(std::size_t position) const;
+  };
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+namespace MEM
+{
+  template <std::size_t bufferSize, typename length_t>
+  recordRingBuffer<bufferSize, length_t>::recordRingBuffer(MEM::ringBufferOverwrite_e overwrite)
+    : m_index(), m_recordCount(0), m_overwriteSetting(overwrite)
+  {
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  void recordRingBuffer<bufferSize, length_t>::reset()
+  {
+    m_index.reset();
+    m_recordCount = 0;
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  MEM::ringBufferOverwrite_e recordRingBuffer<bufferSize, length_t>::getOverwriteBehavior() const
+  {
+    return m_overwriteSetting;
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  bool recordRingBuffer<bufferSize, length_t>::isEmpty() const
+  {
+    return m_recordCount == 0;
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  std::size_t recordRingBuffer<bufferSize, length_t>::recordCount() const
+  {
+    return m_recordCount;
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  std::size_t recordRingBuffer<bufferSize, length_t>::bytesUsed() const
+  {
+    return m_index.count();
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  constexpr std::size_t recordRingBuffer<bufferSize, length_t>::capacity() const
+  {
+    return bufferSize;
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  constexpr std::size_t recordRingBuffer<bufferSize, length_t>::maxRecordSize() const
+  {
+    // The largest length value is reserved to mark padding
+    return ((bufferSize - headerSize) < static_cast<std::size_t>(paddingMarker)) ? (bufferSize - headerSize)
+                                                                                  : (static_cast<std::size_t>(paddingMarker) - 1);
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  bool recordRingBuffer<bufferSize, length_t>::fits(std::size_t size) const
+  {
+    if (size > maxRecordSize())
+    {
+      return false;
+    }
+    if (m_recordCount == 0)
+    {
+      // pushRecord() restarts an empty buffer at the beginning of the storage
+      return true;
+    }
+
+    const std::size_t recordSize = headerSize + size;
+    const std::size_t tailSize   = bufferSize - m_index.writePosition();
+    const std::size_t required   = (recordSize > tailSize) ? (tailSize + recordSize) : recordSize;
+    return required <= (bufferSize - m_index.count());
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  bool recordRingBuffer<bufferSize, length_t>::pushRecord(const uint8_t data[], std::size_t size)
+  {
+    if (size > maxRecordSize())
+    {
+      return false;
+    }
+    while (!fits(size))
+    {
+      if (m_overwriteSetting != MEM::RINGBUFFER_ALLOW_OVERWRITE)
+      {
+        return false;
+      }
+      popRecord();
+    }
+    if (m_recordCount == 0)
+    {
+      // Drop any padding and start at the beginning, so the largest record always fits into an empty buffer
+      m_index.reset();
+    }
+
+    const std::size_t recordSize = headerSize + size;
+    const std::size_t tailSize   = bufferSize - m_index.writePosition();
+    if (recordSize > tailSize)
+    {
+      // A tail shorter than a length prefix is recognized as padding by its size alone
+      if (tailSize >= headerSize)
+      {
+        std::memcpy(&m_dataArray[m_index.writePosition()], &paddingMarker, headerSize);
+      }
+      m_index.advanceWrite(tailSize);
+    }
+
+    const length_t length = static_cast<length_t>(size);
+    std::memcpy(&m_dataArray[m_index.writePosition()], &length, headerSize);
+    if (size > 0)
+    {
+      std::memcpy(&m_dataArray[m_index.writePosition() + headerSize], data, size);
+    }
+    m_index.advanceWrite(recordSize);
+    ++m_recordCount;
+    return true;
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  MEM::memorySpan<const uint8_t> recordRingBuffer<bufferSize, length_t>::frontRecord() const
+  {
+    if (m_recordCount == 0)
+    {
+      return MEM::memorySpan<const uint8_t>{nullptr, 0};
+    }
+
+    const std::size_t position = m_index.readPosition(paddingAt(m_index.readPosition()));
+    const std::size_t length   = lengthAt(position);
+    return MEM::memorySpan<const uint8_t>{(length > 0) ? &m_dataArray[position + headerSize] : nullptr, length};
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  bool recordRingBuffer<bufferSize, length_t>::popRecord()
+  {
+    if (m_recordCount == 0)
+    {
+      return false;
+    }
+
+    const std::size_t padding = paddingAt(m_index.readPosition());
+    m_index.advanceRead(padding);
+    m_index.advanceRead(headerSize + lengthAt(m_index.readPosition()));
+    --m_recordCount;
+    return true;
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  std::size_t recordRingBuffer<bufferSize, length_t>::popRecord(uint8_t data[], std::size_t dataCount)
+  {
+    const MEM::memorySpan<const uint8_t> record = frontRecord();
+    if (m_recordCount == 0 || record.size > dataCount)
+    {
+      return 0;
+    }
+
+    if (record.size > 0)
+    {
+      std::memcpy(data, record.data, record.size);
+    }
+    popRecord();
+    return record.size;
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  std::size_t recordRingBuffer<bufferSize, length_t>::paddingAt(std::size_t position) const
+  {
+    const std::size_t tailSize = bufferSize - position;
+    if (tailSize < headerSize || lengthAt(position) == paddingMarker)
+    {
+      return tailSize;
+    }
+    return 0;
+  }
+
+  template <std::size_t bufferSize, typename length_t>
+  length_t recordRingBuffer<bufferSize, length_t>::lengthAt(std::size_t position) const
+  {
+    // The prefix is not aligned, since records are packed back to back
+    length_t length;
+    std::memcpy(&length, &m_dataArray[position], headerSize);
+    return length;
+  }
+
+} // namespace MEM
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
@@ -0,0 +1,205 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../record_ring_buffer.hpp"
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class testRecordRingBuffer : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testRecordRingBufferPushAndPop();
+  void testRecordRingBufferPaddingAtWrap();
+  void testRecordRingBufferRejectsWhenFull();
+  void testRecordRingBufferOverwrite();
+  void testRecordRingBufferPopIntoArray();
+  void testRecordRingBufferCapacity();
+};
+#endif
+
+namespace
+{
+  /**
+   * @brief          Write a string as one record, without the terminating zero.
+   * @param[in,out]  buffer
+   *                 The record ring buffer to write to.
+   * @param[in]      text
+   *                 The string to write.
+   * @return         `true` if the record was written, `false` otherwise.
+   */
+  template <typename buffer_t>
+  bool pushText(buffer_t& buffer, const char* text)
+  {
+    return buffer.pushRecord(reinterpret_cast<const uint8_t*>(text), std::strlen(text));
+  }
+
+  /**
+   * @brief      Get the oldest record of a record ring buffer as a string.
+   * @param[in]  buffer
+   *             The record ring buffer to read from.
+   * @return     The bytes of the oldest record.
+   */
+  template <typename buffer_t>
+  std::string frontText(const buffer_t& buffer)
+  {
+    const MEM::memorySpan<const uint8_t> record = buffer.frontRecord();
+    return std::string(reinterpret_cast<const char*>(record.data), record.size);
+  }
+} // namespace
+
+TEST_CASE(testRecordRingBuffer, testRecordRingBufferPushAndPop)
+{
+  MEM::recordRingBuffer<64> buffer;
+
+  QVERIFY(buffer.isEmpty());
+  QVERIFY(buffer.frontRecord().data == nullptr);
+  QVERIFY(!buffer.popRecord());
+  QCOMPARE(static_cast<int>(buffer.maxRecordSize()), 62);
+
+  QVERIFY(pushText(buffer, "first"));
+  QVERIFY(pushText(buffer, ""));
+  QVERIFY(pushText(buffer, "third record"));
+  QCOMPARE(static_cast<int>(buffer.recordCount()), 3);
+  QCOMPARE(static_cast<int>(buffer.bytesUsed()), 2 + 5 + 2 + 0 + 2 + 12);
+
+  QCOMPARE(frontText(buffer), std::string("first"));
+  QVERIFY(buffer.popRecord());
+  QCOMPARE(static_cast<int>(buffer.frontRecord().size), 0);
+  QVERIFY(!buffer.isEmpty());
+  QVERIFY(buffer.popRecord());
+  QCOMPARE(frontText(buffer), std::string("third record"));
+  QVERIFY(buffer.popRecord());
+  QVERIFY(buffer.isEmpty());
+  QCOMPARE(static_cast<int>(buffer.bytesUsed()), 0);
+}
+
+TEST_CASE(testRecordRingBuffer, testRecordRingBufferPaddingAtWrap)
+{
+  MEM::recordRingBuffer<32> buffer;
+
+  // Fill up to 3 bytes before the end, then free the start of the storage
+  QVERIFY(pushText(buffer, "0123456789"));
+  QVERIFY(pushText(buffer, "abcdefghijklmno"));
+  QVERIFY(buffer.popRecord());
+  QCOMPARE(static_cast<int>(buffer.bytesUsed()), 17);
+
+  // Does not fit into the 3 bytes at the end, so they become padding and the record starts at the beginning
+  QVERIFY(pushText(buffer, "wrapped"));
+  QCOMPARE(static_cast<int>(buffer.bytesUsed()), 17 + 3 + 9);
+  QCOMPARE(frontText(buffer), std::string("abcdefghijklmno"));
+  QVERIFY(buffer.popRecord());
+  QCOMPARE(frontText(buffer), std::string("wrapped"));
+  QVERIFY(buffer.popRecord());
+  QVERIFY(buffer.isEmpty());
+  QCOMPARE(static_cast<int>(buffer.bytesUsed()), 0);
+
+  // A tail shorter than the length prefix is skipped without a marker
+  QVERIFY(pushText(buffer, "a"));
+  QVERIFY(pushText(buffer, "0123456789abcdefghijklmnop"));
+  QVERIFY(buffer.popRecord());
+  QVERIFY(pushText(buffer, "x"));
+  QCOMPARE(static_cast<int>(buffer.bytesUsed()), 28 + 1 + 3);
+  QCOMPARE(frontText(buffer), std::string("0123456789abcdefghijklmnop"));
+  QVERIFY(buffer.popRecord());
+  QCOMPARE(frontText(buffer), std::string("x"));
+  QVERIFY(buffer.popRecord());
+  QVERIFY(buffer.isEmpty());
+}
+
+TEST_CASE(testRecordRingBuffer, testRecordRingBufferRejectsWhenFull)
+{
+  MEM::recordRingBuffer<32> buffer;
+
+  QVERIFY(!buffer.pushRecord(nullptr, 31));
+  QVERIFY(pushText(buffer, "0123456789"));
+  QVERIFY(pushText(buffer, "0123456789"));
+  QVERIFY(buffer.fits(6));
+  QVERIFY(!buffer.fits(7));
+  QVERIFY(!pushText(buffer, "0123456"));
+  QCOMPARE(static_cast<int>(buffer.recordCount()), 2);
+
+  // Freeing the first record makes room only at the start, which requires the 8 bytes at the end as padding
+  QVERIFY(buffer.popRecord());
+  QVERIFY(!buffer.fits(11));
+  QVERIFY(pushText(buffer, "012345678"));
+  QCOMPARE(static_cast<int>(buffer.recordCount()), 2);
+  QCOMPARE(static_cast<int>(buffer.bytesUsed()), 32 - 1);
+
+  // The largest record always fits into an empty buffer, regardless of the previous positions
+  buffer.popRecord();
+  buffer.popRecord();
+  uint8_t largest[30] = {};
+  QVERIFY(buffer.pushRecord(largest, sizeof(largest)));
+  QCOMPARE(static_cast<int>(buffer.frontRecord().size), 30);
+}
+
+TEST_CASE(testRecordRingBuffer, testRecordRingBufferOverwrite)
+{
+  MEM::recordRingBuffer<32> buffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+
+  QVERIFY(pushText(buffer, "first"));
+  QVERIFY(pushText(buffer, "second"));
+  QVERIFY(pushText(buffer, "third"));
+  QVERIFY(pushText(buffer, "fourth"));
+
+  // Drops as many of the oldest records as needed
+  QVERIFY(pushText(buffer, "a much longer fifth"));
+  QCOMPARE(static_cast<int>(buffer.recordCount()), 2);
+  QCOMPARE(frontText(buffer), std::string("fourth"));
+  QVERIFY(pushText(buffer, "sixth"));
+  QCOMPARE(static_cast<int>(buffer.recordCount()), 2);
+  QCOMPARE(frontText(buffer), std::string("a much longer fifth"));
+}
+
+TEST_CASE(testRecordRingBuffer, testRecordRingBufferPopIntoArray)
+{
+  MEM::recordRingBuffer<64> buffer;
+  uint8_t                   data[8] = {};
+
+  QCOMPARE(static_cast<int>(buffer.popRecord(data, sizeof(data))), 0);
+  QVERIFY(pushText(buffer, "$GPGSA"));
+  QVERIFY(pushText(buffer, "$GPRMC,too long"));
+
+  QCOMPARE(static_cast<int>(buffer.popRecord(data, sizeof(data))), 6);
+  QCOMPARE(std::string(reinterpret_cast<const char*>(data), 6), std::string("$GPGSA"));
+
+  // A record that does not fit into the array is left in the buffer
+  QCOMPARE(static_cast<int>(buffer.popRecord(data, sizeof(data))), 0);
+  QCOMPARE(static_cast<int>(buffer.recordCount()), 1);
+}
+
+TEST_CASE(testRecordRingBuffer, testRecordRingBufferCapacity)
+{
+  // Storing sentences in fixed slots of the maximum NMEA sentence length wastes the difference to the typical length
+  struct sentenceSlot_t
+  {
+    uint8_t length;
+    char    text[82];
+  };
+  const char*                           SENTENCE = "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39\r\n";
+  MEM::ringBuffer<sentenceSlot_t, 1024> slotBuffer;
+  MEM::recordRingBuffer<1024>           recordBuffer;
+  sentenceSlot_t                        slot = {};
+
+  while (slotBuffer.write(slot))
+  {
+  }
+  while (pushText(recordBuffer, SENTENCE))
+  {
+  }
+
+  QCOMPARE(static_cast<int>(slotBuffer.count()), 12);
+  QCOMPARE(static_cast<int>(recordBuffer.recordCount()), 20);
+  QVERIFY(recordBuffer.recordCount() >= slotBuffer.count() * 3 / 2);
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testRecordRingBuffer)
+#include "record_ring_buffer_test.moc"
+#endif
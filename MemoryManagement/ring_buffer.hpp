@@ -3,7 +3,7 @@
 \*************************************************************************/
 /**
  * @file     ring_buffer.hpp
- * @version  0.3
+ * @version  0.8
  * @brief    Definition of the ringBuffer class.
  * @details  The `ringBuffer` class is a circular buffer implementation with statically allocated memory.
  *           It is used to buffer data between processes, threads, or interrupts without dynamic memory allocation.
@@ -19,8 +19,29 @@
  *           -# Use the `read()` function to read elements from the buffer, like this: `int myValue; myRingBuffer.read(myValue);`.
  *           -# Check the return value of `write()` and `read()` to determine whether or not an operation was successful.
  *
+ *           The storage is left uninitialized until elements are written, so `T` does not need a default constructor and no
+ *           element is constructed up front. Elements are constructed in place when written and destroyed when read, released
+ *           or reset. Use `emplace()` to construct an element directly inside the buffer from its constructor arguments, and
+ *           the move overload of `write()` for move-only types, like this: `myRingBuffer.emplace(42, "message");`.
+ *
+ *           To size the buffer from real data, pass `ringBufferStatisticsCollector` as third template parameter, like this:
+ *           `ringBuffer<int, 64, ringBufferStatisticsCollector> myRingBuffer;`. The buffer then counts dropped and rejected
+ *           elements, tracks the highest number of stored elements and keeps a histogram of the occupancy, which can be read
+ *           with `getStatistics()` and cleared with `resetStatistics()`. The default `ringBufferNoStatistics` compiles the
+ *           instrumentation away and adds no memory.
+ *
+ *           Alternatively, the storage can be accessed without copying through the caller:
+ *           -# Call `writeReserve()` to obtain the free storage as (at most two) contiguous spans, fill them directly
+ *              (e.g. by DMA or `recv()`), and publish the filled elements with `writeCommit()`. This requires a trivially
+ *              copyable `T`, since the reserved storage does not contain constructed elements.
+ *           -# Call `readAcquire()` to obtain the stored elements as (at most two) contiguous spans, process them directly
+ *              (e.g. by a compression routine), and free the processed elements with `readRelease()`.
+ *
  * @note     The buffer size (`bufferSize`) must be large enough to hold at least one element of type `T`.
  *           If it is not, a compile-time error will occur.
+ *           When the number of elements that fit is a power of two, the read and write positions are kept as free-running
+ *           counters that are masked into the array, which avoids any modulo and the separate element counter.
+ *           Choose such a size on targets without a fast hardware divider.
  */
 
 #pragma once
@@ -28,6 +49,10 @@
  * Includes
 \*************************************************************************/
 #include "global.hpp"
+#include "memory_span.hpp"
+#include <cstring>
+#include <new>
+#include <utility>
 
 /*************************************************************************\
  * Prototypes
@@ -43,6 +68,246 @@ namespace MEM
     RINGBUFFER_ALLOW_OVERWRITE //!< Overwrite the oldest element in the buffer when it is full.
   };
 
+  constexpr std::size_t ringBufferHistogramBuckets = 32; //!< Number of occupancy histogram buckets, covers up to 2^32 elements.
+
+  /**
+   * @brief    Snapshot of the statistics collected by a ring buffer.
+   * @details  The high-watermark and the histogram are sampled once per write operation, i.e. once per call of `write()`,
+   *           `emplace()` or `writeCommit()` that stored at least one element, no matter how many elements it stored.
+   */
+  struct ringBufferStatistics_t
+  {
+    uint32_t    droppedCount;                                   //!< Number of stored elements discarded by overwriting.
+    uint32_t    rejectedCount;                                  //!< Number of elements not written because the buffer was full.
+    std::size_t highWatermark;                                  //!< Highest number of elements stored at the same time.
+    uint32_t    occupancyHistogram[ringBufferHistogramBuckets]; //!< Bucket `k` counts write operations that left `2^k` to `2^(k+1)-1` elements.
+  };
+
+  /**
+   * @brief    Statistics policy for a ring buffer that does not collect anything.
+   * @details  All functions are empty, so the calls are optimized away and, as an empty base class, the policy adds no memory.
+   */
+  class ringBufferNoStatistics
+  {
+  public:
+    /**
+     * @brief      Ignore a write operation.
+     * @param[in]  elementsStored
+     *             The number of elements stored after the write operation.
+     */
+    void recordWrite(std::size_t elementsStored);
+
+    /**
+     * @brief      Ignore elements that were discarded to make room for new ones.
+     * @param[in]  dataCount
+     *             The number of discarded elements.
+     */
+    void recordDropped(std::size_t dataCount);
+
+    /**
+     * @brief      Ignore elements that could not be written because the buffer was full.
+     * @param[in]  dataCount
+     *             The number of rejected elements.
+     */
+    void recordRejected(std::size_t dataCount);
+
+    /**
+     * @brief   Get empty statistics.
+     * @return  Statistics with all values zero.
+     */
+    ringBufferStatistics_t snapshot() const;
+
+    /**
+     * @brief  Does nothing, there are no statistics to reset.
+     */
+    void clear();
+  };
+
+  /**
+   * @brief    Statistics policy for a ring buffer that collects the data needed to size it.
+   * @details  Counts dropped and rejected elements, tracks the high-watermark and samples the occupancy into a histogram
+   *           with power-of-two buckets after every write operation.
+   */
+  class ringBufferStatisticsCollector
+  {
+  public:
+    /**
+     * @brief  Constructor that initializes all statistics to zero.
+     */
+    ringBufferStatisticsCollector();
+
+    /**
+     * @brief      Record a write operation that stored at least one element.
+     * @param[in]  elementsStored
+     *             The number of elements stored after the write operation.
+     */
+    void recordWrite(std::size_t elementsStored);
+
+    /**
+     * @brief      Record elements that were discarded to make room for new ones.
+     * @param[in]  dataCount
+     *             The number of discarded elements.
+     */
+    void recordDropped(std::size_t dataCount);
+
+    /**
+     * @brief      Record elements that could not be written because the buffer was full.
+     * @param[in]  dataCount
+     *             The number of rejected elements.
+     */
+    void recordRejected(std::size_t dataCount);
+
+    /**
+     * @brief   Get a copy of the statistics collected so far.
+     * @return  The statistics.
+     */
+    ringBufferStatistics_t snapshot() const;
+
+    /**
+     * @brief  Reset all statistics to zero.
+     */
+    void clear();
+
+  private:
+    ringBufferStatistics_t m_statistics; //!< The statistics collected so far.
+  };
+
+  /**
+   * @brief    Read and write position bookkeeping for a ring buffer with a capacity that is not a power of two.
+   * @details  Keeps wrapped positions and a separate element counter. Positions wrap with a comparison instead of a modulo.
+   * @tparam   elementCount
+   *           The number of elements the ring buffer can hold.
+   * @tparam   powerOfTwo
+   *           Selects the implementation, derived from `elementCount`.
+   */
+  template <std::size_t elementCount, bool powerOfTwo = isPowerOfTwo(elementCount)>
+  class ringBufferIndex
+  {
+  public:
+    /**
+     * @brief  Constructor that initializes the positions of an empty ring buffer.
+     */
+    ringBufferIndex();
+
+    /**
+     * @brief  Reset the positions to those of an empty ring buffer.
+     */
+    void reset();
+
+    /**
+     * @brief   Get the number of elements between the read and write position.
+     * @return  The number of elements stored.
+     */
+    std::size_t count() const;
+
+    /**
+     * @brief      Get the array position of a stored element.
+     * @param[in]  offset
+     *             The zero-based index of the element relative to the oldest element, smaller than the capacity.
+     * @return     The position in the data array.
+     */
+    std::size_t readPosition(std::size_t offset = 0) const;
+
+    /**
+     * @brief   Get the array position at which the next element is written.
+     * @return  The position in the data array.
+     */
+    std::size_t writePosition() const;
+
+    /**
+     * @brief      Advance the read position, removing elements from the ring buffer.
+     * @param[in]  steps
+     *             The number of elements to remove, at most the number of stored elements.
+     */
+    void advanceRead(std::size_t steps);
+
+    /**
+     * @brief      Advance the write position, adding elements to the ring buffer.
+     * @param[in]  steps
+     *             The number of elements to add, at most the free space.
+     */
+    void advanceWrite(std::size_t steps);
+
+  private:
+    std::size_t m_readIndex;      //!< Index of the current read position.
+    std::size_t m_writeIndex;     //!< Index of the current write position.
+    std::size_t m_elementsStored; //!< Number of elements currently stored in the buffer.
+
+    /**
+     * @brief      Advances an index by a number of positions, wrapping around if necessary.
+     * @param[in]  index
+     *             The current index.
+     * @param[in]  steps
+     *             The number of positions to advance, at most the capacity.
+     * @return     The advanced index position.
+     */
+    static std::size_t advanceIndex(std::size_t index, std::size_t steps);
+  };
+
+  /**
+   * @brief    Read and write position bookkeeping for a ring buffer with a capacity that is a power of two.
+   * @details  Keeps free-running read and write counters (32 or 64 bits wide, depending on `std::size_t` of the platform).
+   *           Array positions are derived by masking the counters and the number of stored elements is their difference,
+   *           which stays correct when the counters wrap around because the capacity divides the counter range.
+   *           Provides the same interface as the primary template.
+   * @tparam   elementCount
+   *           The number of elements the ring buffer can hold.
+   */
+  template <std::size_t elementCount>
+  class ringBufferIndex<elementCount, true>
+  {
+  public:
+    /**
+     * @brief  Constructor that initializes the counters of an empty ring buffer.
+     */
+    ringBufferIndex();
+
+    /**
+     * @brief  Reset the counters to those of an empty ring buffer.
+     */
+    void reset();
+
+    /**
+     * @brief   Get the number of elements between the read and write counter.
+     * @return  The number of elements stored.
+     */
+    std::size_t count() const;
+
+    /**
+     * @brief      Get the array position of a stored element.
+     * @param[in]  offset
+     *             The zero-based index of the element relative to the oldest element, smaller than the capacity.
+     * @return     The position in the data array.
+     */
+    std::size_t readPosition(std::size_t offset = 0) const;
+
+    /**
+     * @brief   Get the array position at which the next element is written.
+     * @return  The position in the data array.
+     */
+    std::size_t writePosition() const;
+
+    /**
+     * @brief      Advance the read counter, removing elements from the ring buffer.
+     * @param[in]  steps
+     *             The number of elements to remove, at most the number of stored elements.
+     */
+    void advanceRead(std::size_t steps);
+
+    /**
+     * @brief      Advance the write counter, adding elements to the ring buffer.
+     * @param[in]  steps
+     *             The number of elements to add, at most the free space.
+     */
+    void advanceWrite(std::size_t steps);
+
+  private:
+    static constexpr std::size_t indexMask = elementCount - 1; //!< Mask to convert a counter into an array position.
+
+    std::size_t m_readCounter;  //!< Total number of elements read, wrapping around at the counter width.
+    std::size_t m_writeCounter; //!< Total number of elements written, wrapping around at the counter width.
+  };
+
   /**
    * @brief    Class template for a ring buffer with statically allocated memory.
    * @details  This class implements the functionality of a ring buffer without dynamic memory allocation.
@@ -53,9 +318,11 @@ namespace MEM
    *           Data type of the elements in the ring buffer.
    * @tparam   bufferSize
    *           The size of the buffer in bytes.
+   * @tparam   statistics_t
+   *           Statistics policy, `ringBufferNoStatistics` (default) or `ringBufferStatisticsCollector`.
    */
-  template <typename T, std::size_t bufferSize>
-  class ringBuffer
+  template <typename T, std::size_t bufferSize, typename statistics_t = MEM::ringBufferNoStatistics>
+  class ringBuffer : private statistics_t
   {
   public:
     /**
@@ -66,10 +333,21 @@ namespace MEM
      */
     explicit ringBuffer(MEM::ringBufferOverwrite_e overwrite = MEM::RINGBUFFER_NO_OVERWRITE);
 
+    // Rule of Five
+    ringBuffer(const ringBuffer&)            = delete;
+    ringBuffer& operator=(const ringBuffer&) = delete;
+    ringBuffer(ringBuffer&&)                 = delete;
+    ringBuffer& operator=(ringBuffer&&)      = delete;
+
+    /**
+     * @brief  Destructor that destroys the elements still stored in the ring buffer.
+     */
+    ~ringBuffer();
+
     /**
      * @brief    Reset the ring buffer.
-     * @details  This function resets the ring buffer to its initial state, with the read and write indices set to zero
-     *           and the number of items in the buffer set to zero.
+     * @details  This function destroys all stored elements and resets the ring buffer to its initial state, with the read and
+     *           write indices set to zero and the number of items in the buffer set to zero.
      */
     void reset();
 
@@ -121,10 +399,32 @@ namespace MEM
      */
     bool write(const T& data);
 
+    /**
+     * @brief      Write a single element to the ring buffer by moving it.
+     * @details    Behaves like the copying `write()`, but moves `data` into the buffer, which also supports move-only types.
+     * @param[in]  data
+     *             The element to be moved into the buffer.
+     * @return     `true` if the data was written successfully, `false` if the buffer is full
+     *             and overwriting is not allowed.
+     */
+    bool write(T&& data);
+
+    /**
+     * @brief      Construct a single element in place at the end of the ring buffer.
+     * @details    If the buffer is full and the overwrite behavior allows overwriting, the oldest element is destroyed first.
+     * @param[in]  args
+     *             The arguments forwarded to the constructor of `T`.
+     * @return     `true` if the element was constructed, `false` if the buffer is full and overwriting is not allowed.
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args);
+
     /**
      * @brief      Write multiple elements to the ring buffer.
      * @details    Writes up to `dataCount` elements from the `data` array into the ring buffer.
      *             Stops if the buffer becomes full and overwriting is not allowed.
+     *             For trivially copyable `T` the elements are moved with at most two `memcpy` calls, and in overwrite mode
+     *             all discarded elements are dropped in one step.
      * @param[in]  data
      *             The array of elements to write.
      * @param[in]  dataCount
@@ -135,7 +435,7 @@ namespace MEM
 
     /**
      * @brief       Read a single element from the ring buffer.
-     * @details     Removes the oldest element from the buffer and stores it in `data`.
+     * @details     Moves the oldest element from the buffer into `data` and destroys it in the buffer.
      * @param[out]  data
      *              The variable to store the read element.
      * @return      `true` if an element was read successfully, `false` if the buffer is empty.
@@ -145,6 +445,7 @@ namespace MEM
     /**
      * @brief       Read multiple elements from the ring buffer.
      * @details     Reads up to `dataCount` elements from the buffer and stores them in `data`.
+     *              For trivially copyable `T` the elements are moved with at most two `memcpy` calls.
      * @param[out]  data
      *              The array to store the read elements.
      * @param[in]   dataCount
@@ -173,23 +474,89 @@ namespace MEM
      */
     const T& operator[](std::size_t index) const;
 
+    /**
+     * @brief      Reserve free storage for writing without copying.
+     * @details    Returns up to `dataCount` free elements, starting at the current write position, as contiguous spans inside
+     *             the buffer. The caller fills the spans in order (`first` before `second`) and publishes the filled elements
+     *             with `writeCommit()`. Reserving never overwrites stored elements, regardless of the overwrite behavior.
+     * @param[in]  dataCount
+     *             The maximum number of elements to reserve.
+     * @return     The reserved storage, whose total size is smaller than `dataCount` if the buffer has less free space.
+     * @note       Only available for trivially copyable `T`, since the reserved storage holds no constructed elements.
+     */
+    MEM::memorySpanPair<T> writeReserve(std::size_t dataCount);
+
+    /**
+     * @brief      Publish elements that were written into storage obtained with `writeReserve()`.
+     * @param[in]  dataCount
+     *             The number of elements that were written, counted from the start of the reserved storage.
+     * @return     The number of elements actually published, limited to the free space of the buffer.
+     * @note       Only available for trivially copyable `T`.
+     */
+    std::size_t writeCommit(std::size_t dataCount);
+
+    /**
+     * @brief    Acquire the stored elements for reading without copying.
+     * @details  Returns all stored elements, oldest first, as contiguous spans inside the buffer. The elements stay in the buffer
+     *           until they are freed with `readRelease()`.
+     * @return   The stored elements.
+     */
+    MEM::memorySpanPair<const T> readAcquire() const;
+
+    /**
+     * @brief      Free and destroy the oldest elements after they were processed through `readAcquire()`.
+     * @param[in]  dataCount
+     *             The number of elements to free.
+     * @return     The number of elements actually freed, limited to the number of stored elements.
+     */
+    std::size_t readRelease(std::size_t dataCount);
+
+    /**
+     * @brief   Get a snapshot of the statistics collected by the statistics policy.
+     * @return  The statistics, all zero when the buffer uses `ringBufferNoStatistics`.
+     */
+    MEM::ringBufferStatistics_t getStatistics() const;
+
+    /**
+     * @brief  Reset the statistics collected by the statistics policy, `reset()` leaves them untouched.
+     */
+    void resetStatistics();
+
   private:
     static constexpr std::size_t elementCount = bufferSize / sizeof(T); //!< Number of elements that can fit in the buffer.
     static_assert(elementCount > 0, "Buffer size is too small to hold even one element of type T.");
 
-    T                          m_dataArray[elementCount]; //!< The statically allocated array used as the ring buffer.
-    MEM::ringBufferOverwrite_e m_overwriteSetting;        //!< Overwrite behavior when the buffer is full.
-    std::size_t                m_readIndex;               //!< Index of the current read position.
-    std::size_t                m_writeIndex;              //!< Index of the current write position.
-    std::size_t                m_elementsStored;          //!< Number of elements currently stored in the buffer.
+    alignas(T) unsigned char m_dataArray[elementCount * sizeof(T)]; //!< Uninitialized storage, elements are constructed in place.
+    MEM::ringBufferOverwrite_e         m_overwriteSetting;           //!< Overwrite behavior when the buffer is full.
+    MEM::ringBufferIndex<elementCount> m_index;                      //!< Read and write positions.
 
     /**
-     * @brief      Advances the index by one position, wrapping around if necessary.
-     * @param[in]  index
-     *             The current index.
-     * @return     The next index position.
+     * @brief      Get the raw storage of an array position, regardless of whether it holds an element.
+     * @param[in]  position
+     *             The position in the data array.
+     * @return     Pointer to the storage of the position.
      */
-    std::size_t nextIndex(std::size_t index) const;
+    T*       storage(std::size_t position);
+    const T* storage(std::size_t position) const;
+
+    /**
+     * @brief      Get the element constructed at an array position.
+     * @param[in]  position
+     *             The position in the data array, which must hold a constructed element.
+     * @return     Pointer to the element.
+     */
+    T*       element(std::size_t position);
+    const T* element(std::size_t position) const;
+
+    /**
+     * @brief      Construct an element at the write position, without sampling the occupancy.
+     * @details    Drops the oldest element if the buffer is full and overwriting is allowed.
+     * @param[in]  args
+     *             The arguments forwarded to the constructor of `T`.
+     * @return     `true` if the element was added, `false` if the buffer is full and overwriting is not allowed.
+     */
+    template <typename... Args>
+    bool construct(Args&&... args);
   };
 
 } // namespace MEM
@@ -199,115 +566,353 @@ namespace MEM
 \*************************************************************************/
 namespace MEM
 {
-  template <typename T, std::size_t bufferSize>
-  ringBuffer<T, bufferSize>::ringBuffer(MEM::ringBufferOverwrite_e overwrite) :
-    m_overwriteSetting(overwrite),
-    m_readIndex(0),
-    m_writeIndex(0),
-    m_elementsStored(0)
+  /*************************************************************************\
+   * Statistics policy Implementation
+  \*************************************************************************/
+  inline void ringBufferNoStatistics::recordWrite(std::size_t)
   {
-    static_assert(std::is_default_constructible<T>::value, "Type T must be default constructible.");
-    // Initialize the buffer elements if necessary (e.g., for complex types)
-    // For POD types, this is optional.
   }
 
-  template <typename T, std::size_t bufferSize>
-  void ringBuffer<T, bufferSize>::reset()
+  inline void ringBufferNoStatistics::recordDropped(std::size_t)
+  {
+  }
+
+  inline void ringBufferNoStatistics::recordRejected(std::size_t)
+  {
+  }
+
+  inline ringBufferStatistics_t ringBufferNoStatistics::snapshot() const
+  {
+    return ringBufferStatistics_t{};
+  }
+
+  inline void ringBufferNoStatistics::clear()
+  {
+  }
+
+  inline ringBufferStatisticsCollector::ringBufferStatisticsCollector() : m_statistics{}
+  {
+  }
+
+  inline void ringBufferStatisticsCollector::recordWrite(std::size_t elementsStored)
+  {
+    if (elementsStored > m_statistics.highWatermark)
+    {
+      m_statistics.highWatermark = elementsStored;
+    }
+
+    // The bucket is the position of the highest set bit
+    std::size_t bucket = 0;
+    while ((elementsStored >>= 1) != 0 && bucket < ringBufferHistogramBuckets - 1)
+    {
+      ++bucket;
+    }
+    ++m_statistics.occupancyHistogram[bucket];
+  }
+
+  inline void ringBufferStatisticsCollector::recordDropped(std::size_t dataCount)
+  {
+    m_statistics.droppedCount += static_cast<uint32_t>(dataCount);
+  }
+
+  inline void ringBufferStatisticsCollector::recordRejected(std::size_t dataCount)
+  {
+    m_statistics.rejectedCount += static_cast<uint32_t>(dataCount);
+  }
+
+  inline ringBufferStatistics_t ringBufferStatisticsCollector::snapshot() const
+  {
+    return m_statistics;
+  }
+
+  inline void ringBufferStatisticsCollector::clear()
+  {
+    m_statistics = ringBufferStatistics_t{};
+  }
+
+  /*************************************************************************\
+   * ringBufferIndex Implementation
+  \*************************************************************************/
+  template <std::size_t elementCount, bool powerOfTwo>
+  ringBufferIndex<elementCount, powerOfTwo>::ringBufferIndex() : m_readIndex(0), m_writeIndex(0), m_elementsStored(0)
+  {
+  }
+
+  template <std::size_t elementCount, bool powerOfTwo>
+  void ringBufferIndex<elementCount, powerOfTwo>::reset()
   {
     m_readIndex      = 0;
     m_writeIndex     = 0;
     m_elementsStored = 0;
   }
 
-  template <typename T, std::size_t bufferSize>
-  void ringBuffer<T, bufferSize>::setOverwriteBehavior(MEM::ringBufferOverwrite_e overwrite)
+  template <std::size_t elementCount, bool powerOfTwo>
+  std::size_t ringBufferIndex<elementCount, powerOfTwo>::count() const
+  {
+    return m_elementsStored;
+  }
+
+  template <std::size_t elementCount, bool powerOfTwo>
+  std::size_t ringBufferIndex<elementCount, powerOfTwo>::readPosition(std::size_t offset) const
+  {
+    return advanceIndex(m_readIndex, offset);
+  }
+
+  template <std::size_t elementCount, bool powerOfTwo>
+  std::size_t ringBufferIndex<elementCount, powerOfTwo>::writePosition() const
+  {
+    return m_writeIndex;
+  }
+
+  template <std::size_t elementCount, bool powerOfTwo>
+  void ringBufferIndex<elementCount, powerOfTwo>::advanceRead(std::size_t steps)
+  {
+    m_readIndex = advanceIndex(m_readIndex, steps);
+    m_elementsStored -= steps;
+  }
+
+  template <std::size_t elementCount, bool powerOfTwo>
+  void ringBufferIndex<elementCount, powerOfTwo>::advanceWrite(std::size_t steps)
+  {
+    m_writeIndex = advanceIndex(m_writeIndex, steps);
+    m_elementsStored += steps;
+  }
+
+  template <std::size_t elementCount, bool powerOfTwo>
+  std::size_t ringBufferIndex<elementCount, powerOfTwo>::advanceIndex(std::size_t index, std::size_t steps)
+  {
+    index += steps;
+    return (index >= elementCount) ? index - elementCount : index;
+  }
+
+  template <std::size_t elementCount>
+  ringBufferIndex<elementCount, true>::ringBufferIndex() : m_readCounter(0), m_writeCounter(0)
+  {
+  }
+
+  template <std::size_t elementCount>
+  void ringBufferIndex<elementCount, true>::reset()
+  {
+    m_readCounter  = 0;
+    m_writeCounter = 0;
+  }
+
+  template <std::size_t elementCount>
+  std::size_t ringBufferIndex<elementCount, true>::count() const
+  {
+    return m_writeCounter - m_readCounter;
+  }
+
+  template <std::size_t elementCount>
+  std::size_t ringBufferIndex<elementCount, true>::readPosition(std::size_t offset) const
+  {
+    return (m_readCounter + offset) & indexMask;
+  }
+
+  template <std::size_t elementCount>
+  std::size_t ringBufferIndex<elementCount, true>::writePosition() const
+  {
+    return m_writeCounter & indexMask;
+  }
+
+  template <std::size_t elementCount>
+  void ringBufferIndex<elementCount, true>::advanceRead(std::size_t steps)
+  {
+    m_readCounter += steps;
+  }
+
+  template <std::size_t elementCount>
+  void ringBufferIndex<elementCount, true>::advanceWrite(std::size_t steps)
+  {
+    m_writeCounter += steps;
+  }
+
+  /*************************************************************************\
+   * ringBuffer Implementation
+  \*************************************************************************/
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  ringBuffer<T, bufferSize, statistics_t>::ringBuffer(MEM::ringBufferOverwrite_e overwrite) : m_overwriteSetting(overwrite)
+  {
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  ringBuffer<T, bufferSize, statistics_t>::~ringBuffer()
+  {
+    readRelease(m_index.count());
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  void ringBuffer<T, bufferSize, statistics_t>::reset()
+  {
+    readRelease(m_index.count());
+    m_index.reset();
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  void ringBuffer<T, bufferSize, statistics_t>::setOverwriteBehavior(MEM::ringBufferOverwrite_e overwrite)
   {
     m_overwriteSetting = overwrite;
   }
 
-  template <typename T, std::size_t bufferSize>
-  MEM::ringBufferOverwrite_e ringBuffer<T, bufferSize>::getOverwriteBehavior() const
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  MEM::ringBufferOverwrite_e ringBuffer<T, bufferSize, statistics_t>::getOverwriteBehavior() const
   {
     return m_overwriteSetting;
   }
 
-  template <typename T, std::size_t bufferSize>
-  bool ringBuffer<T, bufferSize>::isEmpty() const
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  bool ringBuffer<T, bufferSize, statistics_t>::isEmpty() const
   {
-    return m_elementsStored == 0;
+    return m_index.count() == 0;
   }
 
-  template <typename T, std::size_t bufferSize>
-  bool ringBuffer<T, bufferSize>::isFull() const
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  bool ringBuffer<T, bufferSize, statistics_t>::isFull() const
   {
-    return m_elementsStored == elementCount;
+    return m_index.count() == elementCount;
   }
 
-  template <typename T, std::size_t bufferSize>
-  std::size_t ringBuffer<T, bufferSize>::count() const
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  std::size_t ringBuffer<T, bufferSize, statistics_t>::count() const
   {
-    return m_elementsStored;
+    return m_index.count();
   }
 
-  template <typename T, std::size_t bufferSize>
-  constexpr std::size_t ringBuffer<T, bufferSize>::capacity() const
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  constexpr std::size_t ringBuffer<T, bufferSize, statistics_t>::capacity() const
   {
     return elementCount;
   }
 
-  template <typename T, std::size_t bufferSize>
-  bool ringBuffer<T, bufferSize>::write(const T& data)
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  bool ringBuffer<T, bufferSize, statistics_t>::write(const T& data)
+  {
+    return emplace(data);
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  bool ringBuffer<T, bufferSize, statistics_t>::write(T&& data)
+  {
+    return emplace(std::move(data));
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  template <typename... Args>
+  bool ringBuffer<T, bufferSize, statistics_t>::emplace(Args&&... args)
+  {
+    if (!construct(std::forward<Args>(args)...))
+    {
+      return false;
+    }
+    statistics_t::recordWrite(m_index.count());
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  template <typename... Args>
+  bool ringBuffer<T, bufferSize, statistics_t>::construct(Args&&... args)
   {
     if (isFull())
     {
       if (m_overwriteSetting == MEM::RINGBUFFER_ALLOW_OVERWRITE)
       {
-        // Overwrite the oldest data
-        m_dataArray[m_writeIndex] = data;
-        m_writeIndex              = nextIndex(m_writeIndex);
-        m_readIndex               = nextIndex(m_readIndex); // Move read index forward
-        // m_elementsStored remains the same
+        // The arguments may refer to the oldest element, so build the new one before destroying it to make room
+        T item(std::forward<Args>(args)...);
+        readRelease(1);
+        statistics_t::recordDropped(1);
+
+        new (storage(m_index.writePosition())) T(std::move(item));
+        m_index.advanceWrite(1);
         return true;
       }
       else
       {
         // Cannot write, buffer is full
+        statistics_t::recordRejected(1);
         return false;
       }
     }
-    else
-    {
-      // There is space in the buffer
-      m_dataArray[m_writeIndex] = data;
-      m_writeIndex              = nextIndex(m_writeIndex);
-      ++m_elementsStored;
-      return true;
-    }
+
+    new (storage(m_index.writePosition())) T(std::forward<Args>(args)...);
+    m_index.advanceWrite(1);
+    return true;
   }
 
-  template <typename T, std::size_t bufferSize>
-  std::size_t ringBuffer<T, bufferSize>::write(const T data[], std::size_t dataCount)
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  std::size_t ringBuffer<T, bufferSize, statistics_t>::write(const T data[], std::size_t dataCount)
   {
-    std::size_t itemsWritten = 0;
-
-    for (std::size_t i = 0; i < dataCount; ++i)
+    if constexpr (std::is_trivially_copyable<T>::value)
     {
-      if (write(data[i]))
+      std::size_t copyCount = dataCount;
+      std::size_t freeSpace = elementCount - m_index.count();
+
+      if (copyCount > freeSpace)
+      {
+        if (m_overwriteSetting == MEM::RINGBUFFER_ALLOW_OVERWRITE)
+        {
+          // Every element beyond the free space costs one element, stored or from this write
+          statistics_t::recordDropped(copyCount - freeSpace);
+
+          // Only the newest elements survive, skip the ones that would be overwritten by this write itself
+          if (copyCount > elementCount)
+          {
+            data += copyCount - elementCount;
+            copyCount = elementCount;
+          }
+          // Drop the oldest stored elements to make room in one step
+          readRelease(copyCount - freeSpace);
+        }
+        else
+        {
+          // Buffer becomes full and overwriting is not allowed
+          statistics_t::recordRejected(copyCount - freeSpace);
+          copyCount = freeSpace;
+          dataCount = freeSpace;
+        }
+      }
+
+      MEM::memorySpanPair<T> spans = writeReserve(copyCount);
+      if (spans.first.size > 0)
       {
-        ++itemsWritten;
+        std::memcpy(spans.first.data, data, spans.first.size * sizeof(T));
       }
-      else
+      if (spans.second.size > 0)
       {
-        // Buffer is full and overwriting is not allowed
-        break;
+        std::memcpy(spans.second.data, data + spans.first.size, spans.second.size * sizeof(T));
       }
+      writeCommit(copyCount);
+
+      return dataCount;
     }
+    else
+    {
+      std::size_t itemsWritten = 0;
+
+      for (std::size_t i = 0; i < dataCount; ++i)
+      {
+        if (construct(data[i]))
+        {
+          ++itemsWritten;
+        }
+        else
+        {
+          // Buffer is full and overwriting is not allowed, the failed write recorded only one of the rejected elements
+          statistics_t::recordRejected(dataCount - itemsWritten - 1);
+          break;
+        }
+      }
 
-    return itemsWritten;
+      // Sample the occupancy once per call, like the bulk copy above
+      if (itemsWritten > 0)
+      {
+        statistics_t::recordWrite(m_index.count());
+      }
+      return itemsWritten;
+    }
   }
 
-  template <typename T, std::size_t bufferSize>
-  bool ringBuffer<T, bufferSize>::read(T& data)
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  bool ringBuffer<T, bufferSize, statistics_t>::read(T& data)
   {
     if (isEmpty())
     {
@@ -316,16 +921,34 @@ namespace MEM
     }
     else
     {
-      data        = m_dataArray[m_readIndex];
-      m_readIndex = nextIndex(m_readIndex);
-      --m_elementsStored;
+      data = std::move(*element(m_index.readPosition()));
+      readRelease(1);
       return true;
     }
   }
 
-  template <typename T, std::size_t bufferSize>
-  std::size_t ringBuffer<T, bufferSize>::read(T data[], std::size_t dataCount)
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  std::size_t ringBuffer<T, bufferSize, statistics_t>::read(T data[], std::size_t dataCount)
   {
+    if constexpr (std::is_trivially_copyable<T>::value)
+    {
+      MEM::memorySpanPair<const T> spans      = readAcquire();
+      const std::size_t            firstCount = (dataCount < spans.first.size) ? dataCount : spans.first.size;
+      const std::size_t            secondCount =
+        ((dataCount - firstCount) < spans.second.size) ? (dataCount - firstCount) : spans.second.size;
+
+      if (firstCount > 0)
+      {
+        std::memcpy(data, spans.first.data, firstCount * sizeof(T));
+      }
+      if (secondCount > 0)
+      {
+        std::memcpy(data + firstCount, spans.second.data, secondCount * sizeof(T));
+      }
+
+      return readRelease(firstCount + secondCount);
+    }
+
     std::size_t itemsRead = 0;
 
     for (std::size_t i = 0; i < dataCount; ++i)
@@ -344,40 +967,135 @@ namespace MEM
     return itemsRead;
   }
 
-  template <typename T, std::size_t bufferSize>
-  bool ringBuffer<T, bufferSize>::peek(T& data, std::size_t index) const
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  bool ringBuffer<T, bufferSize, statistics_t>::peek(T& data, std::size_t index) const
   {
-    if (index >= m_elementsStored)
+    if (index >= m_index.count())
     {
       // Index is out of range
       return false;
     }
     else
     {
-      std::size_t actualIndex = (m_readIndex + index) % elementCount;
-      data                    = m_dataArray[actualIndex];
+      data = *element(m_index.readPosition(index));
       return true;
     }
   }
 
-  template <typename T, std::size_t bufferSize>
-  const T& ringBuffer<T, bufferSize>::operator[](std::size_t index) const
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  const T& ringBuffer<T, bufferSize, statistics_t>::operator[](std::size_t index) const
   {
-    if (index >= m_elementsStored)
+    if (index >= m_index.count())
     {
       throw std::out_of_range("Index out of range");
     }
     else
     {
-      std::size_t actualIndex = (m_readIndex + index) % elementCount;
-      return m_dataArray[actualIndex];
+      return *element(m_index.readPosition(index));
+    }
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  MEM::memorySpanPair<T> ringBuffer<T, bufferSize, statistics_t>::writeReserve(std::size_t dataCount)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Reserving storage requires a trivially copyable type T.");
+
+    const std::size_t writePosition = m_index.writePosition();
+    const std::size_t freeSpace     = elementCount - m_index.count();
+    const std::size_t reservedCount = (dataCount < freeSpace) ? dataCount : freeSpace;
+    const std::size_t firstCount    = ((elementCount - writePosition) < reservedCount) ? (elementCount - writePosition) : reservedCount;
+
+    MEM::memorySpanPair<T> spans;
+    spans.first.data  = (firstCount > 0) ? storage(writePosition) : nullptr;
+    spans.first.size  = firstCount;
+    spans.second.data = (reservedCount > firstCount) ? storage(0) : nullptr;
+    spans.second.size = reservedCount - firstCount;
+    return spans;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  std::size_t ringBuffer<T, bufferSize, statistics_t>::writeCommit(std::size_t dataCount)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Committing reserved storage requires a trivially copyable type T.");
+
+    const std::size_t freeSpace      = elementCount - m_index.count();
+    const std::size_t committedCount = (dataCount < freeSpace) ? dataCount : freeSpace;
+
+    m_index.advanceWrite(committedCount);
+    if (committedCount > 0)
+    {
+      statistics_t::recordWrite(m_index.count());
+    }
+    return committedCount;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  MEM::memorySpanPair<const T> ringBuffer<T, bufferSize, statistics_t>::readAcquire() const
+  {
+    const std::size_t readPosition   = m_index.readPosition();
+    const std::size_t elementsStored = m_index.count();
+    const std::size_t firstCount     = ((elementCount - readPosition) < elementsStored) ? (elementCount - readPosition) : elementsStored;
+
+    MEM::memorySpanPair<const T> spans;
+    spans.first.data  = (firstCount > 0) ? element(readPosition) : nullptr;
+    spans.first.size  = firstCount;
+    spans.second.data = (elementsStored > firstCount) ? element(0) : nullptr;
+    spans.second.size = elementsStored - firstCount;
+    return spans;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  std::size_t ringBuffer<T, bufferSize, statistics_t>::readRelease(std::size_t dataCount)
+  {
+    const std::size_t elementsStored = m_index.count();
+    const std::size_t releasedCount  = (dataCount < elementsStored) ? dataCount : elementsStored;
+
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+      for (std::size_t i = 0; i < releasedCount; ++i)
+      {
+        element(m_index.readPosition(i))->~T();
+      }
     }
+
+    m_index.advanceRead(releasedCount);
+    return releasedCount;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  MEM::ringBufferStatistics_t ringBuffer<T, bufferSize, statistics_t>::getStatistics() const
+  {
+    return statistics_t::snapshot();
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  void ringBuffer<T, bufferSize, statistics_t>::resetStatistics()
+  {
+    statistics_t::clear();
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  T* ringBuffer<T, bufferSize, statistics_t>::storage(std::size_t position)
+  {
+    return reinterpret_cast<T*>(m_dataArray) + position;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  const T* ringBuffer<T, bufferSize, statistics_t>::storage(std::size_t position) const
+  {
+    return reinterpret_cast<const T*>(m_dataArray) + position;
+  }
+
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  T* ringBuffer<T, bufferSize, statistics_t>::element(std::size_t position)
+  {
+    return std::launder(storage(position));
   }
 
-  template <typename T, std::size_t bufferSize>
-  std::size_t ringBuffer<T, bufferSize>::nextIndex(std::size_t index) const
+  template <typename T, std::size_t bufferSize, typename statistics_t>
+  const T* ringBuffer<T, bufferSize, statistics_t>::element(std::size_t position) const
   {
-    return (index + 1) % elementCount;
+    return std::launder(storage(position));
   }
 
 } // namespace MEM
@@ -1,5 +1,7 @@
 #include "../../Tools/Testing/test_helper.hpp"
 #include "../ring_buffer.hpp"
+#include <memory>
+#include <string>
 
 
 #if defined(QT_TESTLIB_LIB)
@@ -24,6 +26,18 @@ private slots:
   void testRingBufferReset();
   void testRingBufferOverwrite();
   void testRingBufferDifferentTypes();
+  void testRingBufferWriteReserveCommit();
+  void testRingBufferReadAcquireRelease();
+  void testRingBufferBulkTransfer();
+  void testRingBufferBulkOverwrite();
+  void testRingBufferBulkNonTrivialType();
+  void testRingBufferPowerOfTwoCapacity();
+  void testRingBufferMoveOnlyType();
+  void testRingBufferElementLifetime();
+  void testRingBufferOverwriteFromOldest();
+  void testRingBufferStatisticsDisabled();
+  void testRingBufferStatisticsOverwrite();
+  void testRingBufferStatisticsRejected();
 };
 #endif
 
@@ -284,6 +298,362 @@ TEST_CASE(testRingBuffer, testRingBufferDifferentTypes)
   QCOMPARE(static_cast<char>(charArrayRingBuffer[1].string[2]), 'f');
 }
 
+TEST_CASE(testRingBuffer, testRingBufferWriteReserveCommit)
+{
+  MEM::ringBuffer<int, 5 * sizeof(int)> myRingBuffer;
+  int                                   value;
+
+  // Move the write position close to the end so the reservation wraps around
+  myRingBuffer.write(0);
+  myRingBuffer.write(0);
+  myRingBuffer.write(0);
+  myRingBuffer.read(value);
+  myRingBuffer.read(value);
+  myRingBuffer.read(value);
+
+  // Reserve more than the free space, only the free space is handed out, split at the wrap point
+  MEM::memorySpanPair<int> spans = myRingBuffer.writeReserve(8);
+  QCOMPARE(static_cast<int>(spans.size()), 5);
+  QCOMPARE(static_cast<int>(spans.first.size), 2);
+  QCOMPARE(static_cast<int>(spans.second.size), 3);
+
+  // Fill the storage directly and publish only part of it
+  spans.first.data[0]  = 1;
+  spans.first.data[1]  = 2;
+  spans.second.data[0] = 3;
+  QCOMPARE(static_cast<int>(myRingBuffer.writeCommit(3)), 3);
+  QCOMPARE(static_cast<int>(myRingBuffer.count()), 3);
+  QCOMPARE(myRingBuffer[0], 1);
+  QCOMPARE(myRingBuffer[1], 2);
+  QCOMPARE(myRingBuffer[2], 3);
+
+  // A reservation that fits before the end of the storage consists of a single span
+  spans = myRingBuffer.writeReserve(1);
+  QCOMPARE(static_cast<int>(spans.first.size), 1);
+  QCOMPARE(static_cast<int>(spans.second.size), 0);
+  QVERIFY(spans.second.data == nullptr);
+
+  // Committing more than the free space is limited to the free space
+  QCOMPARE(static_cast<int>(myRingBuffer.writeCommit(4)), 2);
+  QVERIFY(myRingBuffer.isFull());
+  QCOMPARE(static_cast<int>(myRingBuffer.writeReserve(1).size()), 0);
+}
+
+TEST_CASE(testRingBuffer, testRingBufferReadAcquireRelease)
+{
+  MEM::ringBuffer<int, 5 * sizeof(int)> myRingBuffer;
+  int                                   data[5] = { 1, 2, 3, 4, 5 };
+  int                                   value;
+
+  // An empty buffer hands out no data
+  QCOMPARE(static_cast<int>(myRingBuffer.readAcquire().size()), 0);
+
+  // Store elements across the end of the storage
+  myRingBuffer.write(data, 4);
+  myRingBuffer.read(value);
+  myRingBuffer.read(value);
+  myRingBuffer.read(value);
+  myRingBuffer.write(&data[4], 1);
+  myRingBuffer.write(data, 2);
+
+  // The stored elements are handed out oldest first, split at the wrap point
+  MEM::memorySpanPair<const int> spans = myRingBuffer.readAcquire();
+  QCOMPARE(static_cast<int>(spans.size()), 4);
+  QCOMPARE(static_cast<int>(spans.first.size), 2);
+  QCOMPARE(spans.first.data[0], 4);
+  QCOMPARE(spans.first.data[1], 5);
+  QCOMPARE(static_cast<int>(spans.second.size), 2);
+  QCOMPARE(spans.second.data[0], 1);
+  QCOMPARE(spans.second.data[1], 2);
+
+  // Releasing frees the oldest elements only
+  QCOMPARE(static_cast<int>(myRingBuffer.readRelease(3)), 3);
+  QCOMPARE(static_cast<int>(myRingBuffer.count()), 1);
+  QVERIFY(myRingBuffer.read(value));
+  QCOMPARE(value, 2);
+
+  // Releasing more than is stored is limited to the stored elements
+  myRingBuffer.write(7);
+  QCOMPARE(static_cast<int>(myRingBuffer.readRelease(3)), 1);
+  QVERIFY(myRingBuffer.isEmpty());
+}
+
+TEST_CASE(testRingBuffer, testRingBufferBulkTransfer)
+{
+  MEM::ringBuffer<uint8_t, 16> myRingBuffer;
+  uint8_t                      data[32];
+  uint8_t                      values[32];
+
+  for (uint8_t i = 0; i < 32; ++i)
+  {
+    data[i] = i;
+  }
+
+  // Move the positions so that the next bulk transfers cross the end of the storage
+  QCOMPARE(static_cast<int>(myRingBuffer.write(data, 10)), 10);
+  QCOMPARE(static_cast<int>(myRingBuffer.read(values, 7)), 7);
+  QCOMPARE(values[6], 6);
+
+  // Only the free space is written when overwriting is not allowed
+  QCOMPARE(static_cast<int>(myRingBuffer.write(&data[10], 20)), 13);
+  QVERIFY(myRingBuffer.isFull());
+
+  // All stored elements are read back in order across the wrap point
+  QCOMPARE(static_cast<int>(myRingBuffer.read(values, 32)), 16);
+  for (uint8_t i = 0; i < 16; ++i)
+  {
+    QCOMPARE(values[i], static_cast<uint8_t>(i + 7));
+  }
+  QVERIFY(myRingBuffer.isEmpty());
+  QCOMPARE(static_cast<int>(myRingBuffer.read(values, 4)), 0);
+}
+
+TEST_CASE(testRingBuffer, testRingBufferBulkOverwrite)
+{
+  MEM::ringBuffer<int, 5 * sizeof(int)> myRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+  int                                   data[12] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+  int                                   values[5];
+
+  // Overwriting drops the oldest elements to make room
+  QCOMPARE(static_cast<int>(myRingBuffer.write(data, 3)), 3);
+  QCOMPARE(static_cast<int>(myRingBuffer.write(&data[3], 4)), 4);
+  QVERIFY(myRingBuffer.isFull());
+  QCOMPARE(myRingBuffer[0], 3);
+  QCOMPARE(myRingBuffer[4], 7);
+
+  // Writing more than the capacity keeps only the newest elements
+  QCOMPARE(static_cast<int>(myRingBuffer.write(data, 12)), 12);
+  QCOMPARE(static_cast<int>(myRingBuffer.read(values, 5)), 5);
+  for (int i = 0; i < 5; ++i)
+  {
+    QCOMPARE(values[i], i + 8);
+  }
+}
+
+TEST_CASE(testRingBuffer, testRingBufferBulkNonTrivialType)
+{
+  MEM::ringBuffer<std::string, 3 * sizeof(std::string)> myRingBuffer;
+  std::string                                           data[4] = { "a", "b", "c", "d" };
+  std::string                                           values[4];
+
+  // Types that are not trivially copyable are transferred element by element
+  QCOMPARE(static_cast<int>(myRingBuffer.write(data, 4)), 3);
+  QCOMPARE(static_cast<int>(myRingBuffer.read(values, 4)), 3);
+  QCOMPARE(values[0], std::string("a"));
+  QCOMPARE(values[2], std::string("c"));
+}
+
+TEST_CASE(testRingBuffer, testRingBufferPowerOfTwoCapacity)
+{
+  // A capacity of four elements selects the free-running counter implementation
+  MEM::ringBuffer<int, 4 * sizeof(int)> myRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+  int                                   value;
+
+  QCOMPARE(static_cast<int>(myRingBuffer.capacity()), 4);
+
+  // Cycle through the storage several times so the masked positions wrap around
+  for (int i = 0; i < 10; ++i)
+  {
+    QVERIFY(myRingBuffer.write(i));
+    QVERIFY(myRingBuffer.write(i + 100));
+    QCOMPARE(static_cast<int>(myRingBuffer.count()), 2);
+    QCOMPARE(myRingBuffer[1], i + 100);
+    QVERIFY(myRingBuffer.read(value));
+    QCOMPARE(value, i);
+    QVERIFY(myRingBuffer.read(value));
+    QCOMPARE(value, i + 100);
+  }
+  QVERIFY(myRingBuffer.isEmpty());
+
+  // Full and empty are told apart by the counter difference alone
+  for (int i = 0; i < 6; ++i)
+  {
+    QVERIFY(myRingBuffer.write(i));
+  }
+  QVERIFY(myRingBuffer.isFull());
+  QCOMPARE(static_cast<int>(myRingBuffer.count()), 4);
+  QVERIFY(myRingBuffer.peek(value, 0));
+  QCOMPARE(value, 2);
+  QVERIFY(myRingBuffer.peek(value, 3));
+  QCOMPARE(value, 5);
+  QVERIFY(!myRingBuffer.peek(value, 4));
+
+  myRingBuffer.setOverwriteBehavior(MEM::RINGBUFFER_NO_OVERWRITE);
+  QVERIFY(!myRingBuffer.write(6));
+  QCOMPARE(static_cast<int>(myRingBuffer.readRelease(4)), 4);
+  QVERIFY(myRingBuffer.isEmpty());
+}
+
+TEST_CASE(testRingBuffer, testRingBufferMoveOnlyType)
+{
+  MEM::ringBuffer<std::unique_ptr<int>, 2 * sizeof(std::unique_ptr<int>)> myRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+  std::unique_ptr<int>                                                     value;
+
+  QVERIFY(myRingBuffer.write(std::unique_ptr<int>(new int(1))));
+  QVERIFY(myRingBuffer.emplace(new int(2)));
+  QVERIFY(myRingBuffer.emplace(new int(3)));
+  QCOMPARE(static_cast<int>(myRingBuffer.count()), 2);
+  QCOMPARE(*myRingBuffer[0], 2);
+
+  QVERIFY(myRingBuffer.read(value));
+  QCOMPARE(*value, 2);
+  QVERIFY(myRingBuffer.read(value));
+  QCOMPARE(*value, 3);
+  QVERIFY(!myRingBuffer.read(value));
+}
+
+TEST_CASE(testRingBuffer, testRingBufferElementLifetime)
+{
+  // Element type without default constructor that counts its live instances
+  struct trackedElement
+  {
+    int  value;
+    int* liveCount;
+
+    trackedElement(int initialValue, int* counter) : value(initialValue), liveCount(counter)
+    {
+      ++(*liveCount);
+    }
+    trackedElement(const trackedElement& other) : value(other.value), liveCount(other.liveCount)
+    {
+      ++(*liveCount);
+    }
+    trackedElement& operator=(const trackedElement& other) = default;
+    ~trackedElement()
+    {
+      --(*liveCount);
+    }
+  };
+
+  int liveCount = 0;
+  {
+    MEM::ringBuffer<trackedElement, 4 * sizeof(trackedElement)> myRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+
+    // No element is constructed up front
+    QCOMPARE(liveCount, 0);
+
+    for (int i = 0; i < 6; ++i)
+    {
+      QVERIFY(myRingBuffer.emplace(i, &liveCount));
+    }
+    QCOMPARE(liveCount, 4);
+    QCOMPARE(myRingBuffer[0].value, 2);
+
+    trackedElement value(0, &liveCount);
+    QVERIFY(myRingBuffer.read(value));
+    QCOMPARE(value.value, 2);
+    QCOMPARE(liveCount, 4);
+
+    QCOMPARE(static_cast<int>(myRingBuffer.readRelease(1)), 1);
+    QCOMPARE(liveCount, 3);
+
+    myRingBuffer.reset();
+    QCOMPARE(liveCount, 1);
+
+    QVERIFY(myRingBuffer.emplace(7, &liveCount));
+    QVERIFY(myRingBuffer.write(value));
+    QCOMPARE(liveCount, 3);
+  }
+
+  // The destructor destroys the remaining elements
+  QCOMPARE(liveCount, 0);
+}
+
+TEST_CASE(testRingBuffer, testRingBufferOverwriteFromOldest)
+{
+  MEM::ringBuffer<std::string, 3 * sizeof(std::string)> myRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+  const std::string                                     FIRST(64, 'a');
+  std::string                                           value;
+
+  myRingBuffer.write(FIRST);
+  myRingBuffer.write(std::string(64, 'b'));
+  myRingBuffer.write(std::string(64, 'c'));
+
+  // Writing the oldest element into a full buffer copies it before it is overwritten
+  QVERIFY(myRingBuffer.write(myRingBuffer[0]));
+  QVERIFY(myRingBuffer.emplace(myRingBuffer[0]));
+  QVERIFY(myRingBuffer.read(value));
+  QCOMPARE(value, std::string(64, 'c'));
+  QVERIFY(myRingBuffer.read(value));
+  QCOMPARE(value, FIRST);
+  QVERIFY(myRingBuffer.read(value));
+  QCOMPARE(value, std::string(64, 'b'));
+}
+
+TEST_CASE(testRingBuffer, testRingBufferStatisticsDisabled)
+{
+  MEM::ringBuffer<int, 4 * sizeof(int)> myRingBuffer;
+
+  // The default policy adds no memory and reports nothing
+  QVERIFY(sizeof(myRingBuffer) < sizeof(MEM::ringBuffer<int, 4 * sizeof(int), MEM::ringBufferStatisticsCollector>));
+  QVERIFY(myRingBuffer.write(1));
+  MEM::ringBufferStatistics_t statistics = myRingBuffer.getStatistics();
+  QCOMPARE(static_cast<int>(statistics.highWatermark), 0);
+  QCOMPARE(static_cast<int>(statistics.occupancyHistogram[0]), 0);
+}
+
+TEST_CASE(testRingBuffer, testRingBufferStatisticsOverwrite)
+{
+  MEM::ringBuffer<int, 4 * sizeof(int), MEM::ringBufferStatisticsCollector> myRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+  int                                                                        data[6] = { 1, 2, 3, 4, 5, 6 };
+  int                                                                        value;
+
+  // Occupancy after the writes: 1, 2, 3, 4, 4, 4
+  for (int i = 0; i < 6; ++i)
+  {
+    QVERIFY(myRingBuffer.write(i));
+  }
+  MEM::ringBufferStatistics_t statistics = myRingBuffer.getStatistics();
+  QCOMPARE(static_cast<int>(statistics.droppedCount), 2);
+  QCOMPARE(static_cast<int>(statistics.rejectedCount), 0);
+  QCOMPARE(static_cast<int>(statistics.highWatermark), 4);
+  QCOMPARE(static_cast<int>(statistics.occupancyHistogram[0]), 1);
+  QCOMPARE(static_cast<int>(statistics.occupancyHistogram[1]), 2);
+  QCOMPARE(static_cast<int>(statistics.occupancyHistogram[2]), 3);
+
+  // A bulk write of 6 elements into 2 free slots drops 4 elements
+  QVERIFY(myRingBuffer.read(value));
+  QVERIFY(myRingBuffer.read(value));
+  QCOMPARE(static_cast<int>(myRingBuffer.write(data, 6)), 6);
+  statistics = myRingBuffer.getStatistics();
+  QCOMPARE(static_cast<int>(statistics.droppedCount), 6);
+  QCOMPARE(static_cast<int>(statistics.occupancyHistogram[2]), 4);
+
+  // Resetting the buffer keeps the statistics, resetting the statistics clears them
+  myRingBuffer.reset();
+  QCOMPARE(static_cast<int>(myRingBuffer.getStatistics().highWatermark), 4);
+  myRingBuffer.resetStatistics();
+  statistics = myRingBuffer.getStatistics();
+  QCOMPARE(static_cast<int>(statistics.droppedCount), 0);
+  QCOMPARE(static_cast<int>(statistics.highWatermark), 0);
+  QCOMPARE(static_cast<int>(statistics.occupancyHistogram[2]), 0);
+}
+
+TEST_CASE(testRingBuffer, testRingBufferStatisticsRejected)
+{
+  MEM::ringBuffer<int, 3 * sizeof(int), MEM::ringBufferStatisticsCollector>                 intRingBuffer;
+  MEM::ringBuffer<std::string, 3 * sizeof(std::string), MEM::ringBufferStatisticsCollector> stringRingBuffer;
+  int                                                                                       intData[5]    = { 1, 2, 3, 4, 5 };
+  std::string                                                                               stringData[5] = { "a", "b", "c", "d", "e" };
+
+  // Both the bulk copy and the element-wise path count every element that did not fit
+  QCOMPARE(static_cast<int>(intRingBuffer.write(intData, 5)), 3);
+  QVERIFY(!intRingBuffer.write(6));
+  QCOMPARE(static_cast<int>(intRingBuffer.getStatistics().rejectedCount), 3);
+  QCOMPARE(static_cast<int>(intRingBuffer.getStatistics().droppedCount), 0);
+  QCOMPARE(static_cast<int>(intRingBuffer.getStatistics().highWatermark), 3);
+
+  QCOMPARE(static_cast<int>(stringRingBuffer.write(stringData, 5)), 3);
+  QCOMPARE(static_cast<int>(stringRingBuffer.getStatistics().rejectedCount), 2);
+  QCOMPARE(static_cast<int>(stringRingBuffer.getStatistics().highWatermark), 3);
+
+  // Both paths sample the occupancy once per bulk write, not once per element
+  QCOMPARE(static_cast<int>(intRingBuffer.getStatistics().occupancyHistogram[0]), 0);
+  QCOMPARE(static_cast<int>(intRingBuffer.getStatistics().occupancyHistogram[1]), 1);
+  QCOMPARE(static_cast<int>(stringRingBuffer.getStatistics().occupancyHistogram[0]), 0);
+  QCOMPARE(static_cast<int>(stringRingBuffer.getStatistics().occupancyHistogram[1]), 1);
+}
+
 #if defined(QT_TESTLIB_LIB)
 QTEST_GUILESS_MAIN(testRingBuffer)
 #include "debug/ring_buffer_test.moc"
@@ -11,6 +11,7 @@ SOURCES +=  \
 
 HEADERS += \
     ../ring_buffer.hpp \
+    ../memory_span.hpp \
     ../../CoreComponents/global.hpp \
 
 INCLUDEPATH += \
@@ -0,0 +1,320 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     sharded_queue.hpp
+ * @version  0.1
+ * @brief    Definition of the shardedQueue class.
+ * @details  The `shardedQueue` class is a lock-free multi-producer/single-consumer FIFO queue with statically allocated
+ *           memory, split into one lane per producer. Every lane is an `spscRingBuffer`, so a producer only ever writes its
+ *           own lane and never competes with other producers for a lock or a cache line. The single consumer visits the
+ *           lanes round-robin. Producer throughput therefore scales with the number of producers, where a `fifoQueue` with
+ *           a single lock is limited to one core's worth of pushes.
+ *
+ *           The elements of one lane leave the queue in the order in which its producer pushed them. There is no order
+ *           between different lanes: two elements pushed by different producers may be popped in any order. Code that needs
+ *           a strict order between some elements pushes them through the same lane.
+ *
+ *           The consumer takes up to the drain batch of elements from a lane before it moves on to the next lane. A batch of
+ *           1 (the default) interleaves the producers fairly. A larger batch saves lane switches and lets `popN()` copy longer
+ *           runs, while a busy producer can delay the others by up to one batch.
+ *
+ *           The template parameters are the data type (`T`), the number of elements per lane (`laneSize`) and the number of
+ *           lanes (`laneCount`), which is the maximum number of producers.
+ *
+ *           To use the `shardedQueue` class, follow these steps:
+ *           -# Instantiate an instance with the desired data type, lane size and lane count as template parameters,
+ *              like this: `shardedQueue<int, 256, 8> myShardedQueue;`.
+ *           -# Let every producer thread call `attachProducer()` once to get its own lane, like this:
+ *              `const std::size_t myLane = myShardedQueue.attachProducer();`.
+ *           -# Call `push()` with that lane only from the producer that owns it, like this: `myShardedQueue.push(myLane, 42);`.
+ *           -# Call `pop()` or `popN()` only from the consumer thread, like this: `int myValue; myShardedQueue.pop(myValue);`.
+ *           -# Optionally call `setDrainBatch()` from the consumer to take several elements from a lane at once, like this:
+ *              `myShardedQueue.setDrainBatch(16);`.
+ *
+ * @note     A full lane rejects new elements, like the lock-free `fifoQueue`; the other lanes are not affected. `size()` and
+ *           `isEmpty()` are snapshots under concurrent access. `reset()` is not thread-safe and also detaches all producers.
+ *           `T` must be default constructible and copy assignable.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include "spsc_ring_buffer.hpp"
+#include <atomic>
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+  /**
+   * @brief    Class template for a lock-free multi-producer/single-consumer queue with one lane per producer.
+   * @tparam   T
+   *           Data type of the elements in the queue.
+   * @tparam   laneSize
+   *           The number of elements each lane can hold.
+   * @tparam   laneCount
+   *           The number of lanes, which is the maximum number of attached producers.
+   */
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  class shardedQueue
+  {
+  public:
+    static constexpr std::size_t invalidLane = laneCount; //!< Returned by `attachProducer()` when all lanes are taken.
+
+    /**
+     * @brief  Constructor that initializes an empty queue without attached producers.
+     */
+    shardedQueue();
+
+    // Rule of Five
+    shardedQueue(const shardedQueue&)            = delete;
+    shardedQueue& operator=(const shardedQueue&) = delete;
+    shardedQueue(shardedQueue&&)                 = delete;
+    shardedQueue& operator=(shardedQueue&&)      = delete;
+    ~shardedQueue()                              = default;
+
+    /**
+     * @brief  Reset the queue to its initial, empty state and detach all producers.
+     * @note   Not thread-safe, no other thread may access the queue during the reset.
+     */
+    void reset();
+
+    /**
+     * @brief   Assign a lane to the calling producer. May be called by any thread.
+     * @return  The lane that the producer owns from now on, or `invalidLane` if all lanes are taken.
+     */
+    std::size_t attachProducer();
+
+    /**
+     * @brief   Check if the queue is empty.
+     * @return  `true` if all lanes were empty at the time of the call, `false` otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief   Get the number of elements currently stored in all lanes.
+     * @return  The number of elements, which is a snapshot under concurrent access.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief   Get the maximum number of elements that can be stored in all lanes together.
+     * @return  The capacity of the queue.
+     */
+    constexpr std::size_t capacity() const;
+
+    /**
+     * @brief      Add an element to a lane. May only be called by the producer that owns the lane.
+     * @param[in]  lane
+     *             The lane returned by `attachProducer()`.
+     * @param[in]  item
+     *             The element to be added.
+     * @return     `true` if the element was added, `false` if the lane is full or invalid.
+     */
+    bool push(std::size_t lane, const T& item);
+
+    /**
+     * @brief      Add multiple elements to a lane and publish them to the consumer at once. May only be called by the
+     *             producer that owns the lane.
+     * @param[in]  lane
+     *             The lane returned by `attachProducer()`.
+     * @param[in]  data
+     *             The array of elements to add.
+     * @param[in]  count
+     *             The number of elements in the array.
+     * @return     The number of elements added, less than `count` if the lane became full, and 0 if the lane is invalid.
+     */
+    std::size_t pushN(std::size_t lane, const T data[], std::size_t count);
+
+    /**
+     * @brief       Remove an element from the queue, visiting the lanes round-robin. May only be called by the consumer.
+     * @param[out]  item
+     *              A reference to store the popped element.
+     * @return      `true` if an element was removed, `false` if all lanes are empty.
+     */
+    bool pop(T& item);
+
+    /**
+     * @brief       Remove multiple elements from the queue, visiting the lanes round-robin. May only be called by the consumer.
+     * @details     Each visit takes up to the drain batch of elements from one lane with a single bulk read.
+     * @param[out]  data
+     *              The array to store the removed elements.
+     * @param[in]   count
+     *              The maximum number of elements to remove.
+     * @return      The number of elements removed, less than `count` if all lanes ran empty.
+     */
+    std::size_t popN(T data[], std::size_t count);
+
+    /**
+     * @brief      Set the number of elements the consumer takes from a lane before it moves on to the next lane.
+     * @details    A larger batch saves lane switches, a batch of 1 interleaves the producers most fairly. The default is 1.
+     * @param[in]  batch
+     *             The number of elements, clamped to the range from 1 to `laneSize`.
+     * @note       May only be called by the consumer.
+     */
+    void setDrainBatch(std::size_t batch);
+
+  private:
+    static_assert(laneCount > 0, "The queue needs at least one lane.");
+
+    using lane_t = MEM::spscRingBuffer<T, laneSize * sizeof(T)>; //!< Ring buffer of one producer and the consumer.
+
+    /**
+     * @brief  Move the consumer to the next lane and start a new drain batch there.
+     */
+    void nextLane();
+
+    lane_t                                          m_lanes[laneCount];  //!< The lanes, one per producer.
+    alignas(cacheLineSize) std::atomic<std::size_t> m_attachedProducers; //!< Number of lanes handed out to producers.
+    alignas(cacheLineSize) std::size_t              m_currentLane;       //!< Lane the consumer takes elements from.
+    std::size_t                                     m_laneTaken;         //!< Elements taken from the current lane in this visit.
+    std::size_t                                     m_drainBatch;        //!< Elements taken from a lane per visit.
+  };
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+namespace MEM
+{
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  shardedQueue<T, laneSize, laneCount>::shardedQueue() : m_attachedProducers(0), m_currentLane(0), m_laneTaken(0), m_drainBatch(1)
+  {
+  }
+
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  void shardedQueue<T, laneSize, laneCount>::reset()
+  {
+    for (lane_t& lane : m_lanes)
+    {
+      lane.reset();
+    }
+    m_currentLane = 0;
+    m_laneTaken   = 0;
+    m_attachedProducers.store(0, std::memory_order_release);
+  }
+
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  std::size_t shardedQueue<T, laneSize, laneCount>::attachProducer()
+  {
+    std::size_t lane = m_attachedProducers.load(std::memory_order_relaxed);
+    do
+    {
+      if (lane >= laneCount)
+      {
+        return invalidLane;
+      }
+    } while (!m_attachedProducers.compare_exchange_weak(lane, lane + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    return lane;
+  }
+
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  bool shardedQueue<T, laneSize, laneCount>::isEmpty() const
+  {
+    for (const lane_t& lane : m_lanes)
+    {
+      if (!lane.isEmpty())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  std::size_t shardedQueue<T, laneSize, laneCount>::size() const
+  {
+    std::size_t count = 0;
+    for (const lane_t& lane : m_lanes)
+    {
+      count += lane.count();
+    }
+    return count;
+  }
+
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  constexpr std::size_t shardedQueue<T, laneSize, laneCount>::capacity() const
+  {
+    return laneSize * laneCount;
+  }
+
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  bool shardedQueue<T, laneSize, laneCount>::push(std::size_t lane, const T& item)
+  {
+    return (lane < laneCount) && m_lanes[lane].write(item);
+  }
+
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  std::size_t shardedQueue<T, laneSize, laneCount>::pushN(std::size_t lane, const T data[], std::size_t count)
+  {
+    return (lane < laneCount) ? m_lanes[lane].write(data, count) : 0;
+  }
+
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  bool shardedQueue<T, laneSize, laneCount>::pop(T& item)
+  {
+    // Visit every lane at most once, starting with the rest of the current batch
+    for (std::size_t visited = 0; visited < laneCount; ++visited)
+    {
+      if (m_lanes[m_currentLane].read(item))
+      {
+        if (++m_laneTaken >= m_drainBatch)
+        {
+          nextLane();
+        }
+        return true;
+      }
+      nextLane();
+    }
+    return false;
+  }
+
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  std::size_t shardedQueue<T, laneSize, laneCount>::popN(T data[], std::size_t count)
+  {
+    std::size_t taken      = 0;
+    std::size_t emptyLanes = 0;
+
+    // Stop once a whole round over all lanes found nothing
+    while ((taken < count) && (emptyLanes < laneCount))
+    {
+      const std::size_t batchLeft = m_drainBatch - m_laneTaken;
+      const std::size_t wanted    = (count - taken < batchLeft) ? count - taken : batchLeft;
+      const std::size_t read      = m_lanes[m_currentLane].read(data + taken, wanted);
+
+      taken += read;
+      m_laneTaken += read;
+      emptyLanes = (read == 0) ? emptyLanes + 1 : 0;
+      if ((read < wanted) || (m_laneTaken >= m_drainBatch))
+      {
+        nextLane();
+      }
+    }
+    return taken;
+  }
+
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  void shardedQueue<T, laneSize, laneCount>::setDrainBatch(std::size_t batch)
+  {
+    m_drainBatch = (batch == 0) ? 1 : (batch > laneSize) ? laneSize : batch;
+    m_laneTaken  = 0;
+  }
+
+  template <typename T, std::size_t laneSize, std::size_t laneCount>
+  void shardedQueue<T, laneSize, laneCount>::nextLane()
+  {
+    m_currentLane = (m_currentLane + 1 == laneCount) ? 0 : m_currentLane + 1;
+    m_laneTaken   = 0;
+  }
+
+} // namespace MEM
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
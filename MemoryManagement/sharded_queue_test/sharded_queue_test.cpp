@@ -0,0 +1,175 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../sharded_queue.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class testShardedQueue : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testShardedQueueLanes();
+  void testShardedQueueRoundRobin();
+  void testShardedQueueDrainBatch();
+  void testShardedQueueConcurrentProducers();
+};
+#endif
+
+TEST_CASE(testShardedQueue, testShardedQueueLanes)
+{
+  MEM::shardedQueue<int, 4, 2> myShardedQueue;
+  int                          value;
+
+  QVERIFY(myShardedQueue.isEmpty());
+  QCOMPARE(static_cast<int>(myShardedQueue.capacity()), 8);
+  QVERIFY(!myShardedQueue.pop(value));
+
+  // Every producer gets its own lane until all lanes are taken
+  const std::size_t firstLane  = myShardedQueue.attachProducer();
+  const std::size_t secondLane = myShardedQueue.attachProducer();
+  QCOMPARE(static_cast<int>(firstLane), 0);
+  QCOMPARE(static_cast<int>(secondLane), 1);
+  QCOMPARE(myShardedQueue.attachProducer(), (MEM::shardedQueue<int, 4, 2>::invalidLane));
+  QVERIFY(!myShardedQueue.push(MEM::shardedQueue<int, 4, 2>::invalidLane, 1));
+
+  // A full lane rejects new elements without affecting the other lane
+  const int VALUES[] = {1, 2, 3, 4, 5};
+  QCOMPARE(static_cast<int>(myShardedQueue.pushN(firstLane, VALUES, 5)), 4);
+  QVERIFY(!myShardedQueue.push(firstLane, 5));
+  QVERIFY(myShardedQueue.push(secondLane, 10));
+  QCOMPARE(static_cast<int>(myShardedQueue.size()), 5);
+
+  myShardedQueue.reset();
+  QVERIFY(myShardedQueue.isEmpty());
+  QCOMPARE(static_cast<int>(myShardedQueue.attachProducer()), 0);
+}
+
+TEST_CASE(testShardedQueue, testShardedQueueRoundRobin)
+{
+  MEM::shardedQueue<int, 8, 3> myShardedQueue;
+  const std::size_t            firstLane  = myShardedQueue.attachProducer();
+  const std::size_t            secondLane = myShardedQueue.attachProducer();
+  const std::size_t            thirdLane  = myShardedQueue.attachProducer();
+  int                          value;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    myShardedQueue.push(firstLane, 10 + i);
+    myShardedQueue.push(secondLane, 20 + i);
+  }
+  myShardedQueue.push(thirdLane, 30);
+
+  // The lanes are interleaved, each in FIFO order, and empty lanes are skipped
+  const int EXPECTED[] = {10, 20, 30, 11, 21, 12, 22};
+  for (int expected : EXPECTED)
+  {
+    QVERIFY(myShardedQueue.pop(value));
+    QCOMPARE(value, expected);
+  }
+  QVERIFY(!myShardedQueue.pop(value));
+}
+
+TEST_CASE(testShardedQueue, testShardedQueueDrainBatch)
+{
+  MEM::shardedQueue<int, 8, 2> myShardedQueue;
+  const std::size_t            firstLane  = myShardedQueue.attachProducer();
+  const std::size_t            secondLane = myShardedQueue.attachProducer();
+  const int                    FIRST[]    = {10, 11, 12, 13, 14};
+  const int                    SECOND[]   = {20, 21, 22};
+  int                          values[16];
+  int                          value;
+
+  myShardedQueue.pushN(firstLane, FIRST, 5);
+  myShardedQueue.pushN(secondLane, SECOND, 3);
+
+  // With a batch of 2 the consumer takes two elements from a lane before it moves on
+  myShardedQueue.setDrainBatch(2);
+  QVERIFY(myShardedQueue.pop(value));
+  QCOMPARE(value, 10);
+  QCOMPARE(static_cast<int>(myShardedQueue.popN(values, 16)), 7);
+  const int EXPECTED[] = {11, 20, 21, 12, 13, 22, 14};
+  for (int i = 0; i < 7; ++i)
+  {
+    QCOMPARE(values[i], EXPECTED[i]);
+  }
+  QCOMPARE(static_cast<int>(myShardedQueue.popN(values, 16)), 0);
+
+  // A batch larger than a lane drains each lane completely, continuing with the lane after the last visited one
+  myShardedQueue.setDrainBatch(100);
+  myShardedQueue.pushN(firstLane, FIRST, 5);
+  myShardedQueue.pushN(secondLane, SECOND, 3);
+  QCOMPARE(static_cast<int>(myShardedQueue.popN(values, 6)), 6);
+  QCOMPARE(values[2], 22);
+  QCOMPARE(values[3], 10);
+  QCOMPARE(static_cast<int>(myShardedQueue.popN(values, 16)), 2);
+  QCOMPARE(values[1], 14);
+}
+
+TEST_CASE(testShardedQueue, testShardedQueueConcurrentProducers)
+{
+  const int                                          PRODUCER_COUNT = 4;
+  const int                                          ITEM_COUNT     = 20000;
+  static MEM::shardedQueue<int, 256, PRODUCER_COUNT> myShardedQueue;
+  std::vector<std::thread>                           producers;
+
+  for (int producer = 0; producer < PRODUCER_COUNT; ++producer)
+  {
+    producers.emplace_back([producer]() {
+      const std::size_t lane = myShardedQueue.attachProducer();
+      for (int i = 0; i < ITEM_COUNT;)
+      {
+        if (myShardedQueue.push(lane, producer * ITEM_COUNT + i))
+        {
+          ++i;
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // Every element arrives exactly once, and the elements of each producer in the order they were pushed
+  int  nextItem[PRODUCER_COUNT] = {};
+  bool inOrder                  = true;
+  int  received                 = 0;
+  int  values[64];
+  myShardedQueue.setDrainBatch(16);
+  while (received < PRODUCER_COUNT * ITEM_COUNT)
+  {
+    const std::size_t count = myShardedQueue.popN(values, 64);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const int producer = values[i] / ITEM_COUNT;
+      inOrder            = inOrder && (values[i] % ITEM_COUNT == nextItem[producer]);
+      nextItem[producer]++;
+    }
+    received += static_cast<int>(count);
+    if (count == 0)
+    {
+      std::this_thread::yield();
+    }
+  }
+  for (auto& producer : producers)
+  {
+    producer.join();
+  }
+
+  QVERIFY(inOrder);
+  QVERIFY(myShardedQueue.isEmpty());
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testShardedQueue)
+#include "sharded_queue_test.moc"
+#endif
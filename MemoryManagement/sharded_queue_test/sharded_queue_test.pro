@@ -0,0 +1,20 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle release
+
+TEMPLATE = app
+
+SOURCES +=  \
+    sharded_queue_test.cpp \
+
+HEADERS += \
+    ../sharded_queue.hpp \
+    ../spsc_ring_buffer.hpp \
+    ../wait_point.hpp \
+    ../../CoreComponents/global.hpp \
+
+INCLUDEPATH += \
+    ../../CoreComponents \
+    ../MemoryManagement \
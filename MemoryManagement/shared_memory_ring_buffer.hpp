@@ -0,0 +1,593 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     shared_memory_ring_buffer.hpp
+ * @version  0.1
+ * @brief    Definition of the sharedMemoryRingBuffer class.
+ * @details  The `sharedMemoryRingBuffer` class is a single-producer/single-consumer ring buffer for Linux hosts whose header
+ *           and storage live in a named POSIX shared-memory segment (`shm_open()` + `mmap()`), so two processes on the same
+ *           machine can hand data to each other without a pipe or socket. Once both sides are attached, transfers are plain
+ *           memory accesses; no system call is made per element or per block.
+ *
+ *           Like `spscRingBuffer`, the producer owns the write counter and the consumer owns the read counter, each on its
+ *           own cache line and published with release semantics. The counters are 64 bits wide and run freely, so processes
+ *           built for different word sizes agree on the layout. The header also records a magic number, a layout version,
+ *           the element size, alignment and count; `attach()` refuses a segment whose layout differs from its own.
+ *
+ *           To use the `sharedMemoryRingBuffer` class, follow these steps:
+ *           -# Instantiate an instance in each process with the same data type and buffer size in bytes as template
+ *              parameters, like this: `sharedMemoryRingBuffer<sample_t, 65536> mySharedRingBuffer;`.
+ *           -# Let one process create the segment, like this: `mySharedRingBuffer.create("/acquisition");`.
+ *           -# Let the other process attach to it, like this: `mySharedRingBuffer.attach("/acquisition");`.
+ *           -# Call `write()` (or `writeReserve()`/`writeCommit()`) only in the producer and `read()` (or
+ *              `readAcquire()`/`readRelease()`) only in the consumer.
+ *           -# Call `detach()` or destroy the instance when done. The segment is removed when the creator detaches, processes
+ *              that are still attached keep their mapping until they detach as well.
+ *
+ * @note     `create()` replaces a segment with the same name, such as one left behind by a crashed process.
+ *           `attach()` fails while the creator has not finished initializing the segment; retry in that case.
+ *           `T` must be trivially copyable and must not contain pointers, since the processes map the segment at different
+ *           addresses. Overwriting the oldest element is not supported, since only the consumer may move the read counter.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include "memory_span.hpp"
+#include <atomic>
+#include <cstring>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+#if defined(__linux__)
+  /**
+   * @brief  Layout version of the shared-memory segment, incremented whenever the header changes.
+   */
+  constexpr uint32_t sharedMemoryRingBufferVersion = 1;
+
+  /**
+   * @brief    Header at the start of the shared-memory segment of a `sharedMemoryRingBuffer`.
+   * @details  Only fixed-width fields are used, so the layout does not depend on the word size of the process.
+   */
+  struct sharedMemoryRingBufferHeader_t
+  {
+    std::atomic<uint32_t> magic;            //!< Identifies an initialized segment, written last by the creator.
+    uint32_t              version;          //!< Layout version of the segment.
+    uint32_t              headerSize;       //!< Size of this header in bytes, the storage starts directly after it.
+    uint32_t              elementSize;      //!< Size of a single element in bytes.
+    uint32_t              elementAlignment; //!< Alignment of a single element in bytes.
+    std::atomic<uint32_t> attachCount;      //!< Number of instances that are currently attached.
+    uint64_t              elementCount;     //!< Number of elements that fit in the storage.
+    alignas(cacheLineSize) std::atomic<uint64_t> writeCounter; //!< Total number of elements written, owned by the producer.
+    alignas(cacheLineSize) std::atomic<uint64_t> readCounter;  //!< Total number of elements read, owned by the consumer.
+  };
+
+  /**
+   * @brief    Class template for a single-producer/single-consumer ring buffer in a POSIX shared-memory segment.
+   * @details  The `bufferSize` specifies the size of the storage in bytes, the header is placed in front of it.
+   *           The class calculates how many elements of type `T` can fit into the buffer.
+   * @tparam   T
+   *           Data type of the elements in the ring buffer, must be trivially copyable.
+   * @tparam   bufferSize
+   *           The size of the storage in bytes.
+   */
+  template <typename T, std::size_t bufferSize>
+  class sharedMemoryRingBuffer
+  {
+  public:
+    /**
+     * @brief  Constructor that initializes an instance that is not attached to a segment.
+     */
+    sharedMemoryRingBuffer();
+
+    /**
+     * @brief  Destructor that detaches from the segment.
+     */
+    ~sharedMemoryRingBuffer();
+
+    // Rule of Five
+    sharedMemoryRingBuffer(const sharedMemoryRingBuffer&)            = delete;
+    sharedMemoryRingBuffer& operator=(const sharedMemoryRingBuffer&) = delete;
+    sharedMemoryRingBuffer(sharedMemoryRingBuffer&&)                 = delete;
+    sharedMemoryRingBuffer& operator=(sharedMemoryRingBuffer&&)      = delete;
+
+    /**
+     * @brief      Create a new, empty segment and attach to it.
+     * @param[in]  name
+     *             The name of the segment, starting with a slash, like `"/acquisition"`.
+     * @return     `true` if the segment was created, `false` if this instance is already attached or the segment cannot be
+     *             created.
+     */
+    bool create(const char* name);
+
+    /**
+     * @brief      Attach to an existing segment that was created by another instance.
+     * @param[in]  name
+     *             The name of the segment.
+     * @return     `true` if attached, `false` if this instance is already attached, the segment does not exist, is not
+     *             initialized yet, or its layout does not match this instance.
+     */
+    bool attach(const char* name);
+
+    /**
+     * @brief  Detach from the segment and remove its name if this instance created it. Does nothing if not attached.
+     */
+    void detach();
+
+    /**
+     * @brief   Check if this instance is attached to a segment.
+     * @return  `true` if attached, `false` otherwise.
+     */
+    bool isAttached() const;
+
+    /**
+     * @brief   Get the number of instances, in all processes, that are attached to the segment.
+     * @return  The number of attached instances, 0 if this instance is not attached.
+     */
+    std::size_t attachCount() const;
+
+    /**
+     * @brief   Check if the ring buffer is empty.
+     * @return  `true` if the buffer is empty or not attached, `false` otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief   Check if the ring buffer is full.
+     * @return  `true` if the buffer is full, `false` otherwise.
+     */
+    bool isFull() const;
+
+    /**
+     * @brief   Get the number of elements currently stored in the ring buffer.
+     * @return  The number of elements currently stored, 0 if not attached.
+     */
+    std::size_t count() const;
+
+    /**
+     * @brief   Get the maximum number of elements that can be stored in the ring buffer.
+     * @return  The capacity of the ring buffer.
+     */
+    constexpr std::size_t capacity() const;
+
+    /**
+     * @brief      Write a single element to the ring buffer. Only call this from the producer.
+     * @param[in]  data
+     *             The element to be written to the buffer.
+     * @return     `true` if the data was written successfully, `false` if the buffer is full or not attached.
+     */
+    bool write(const T& data);
+
+    /**
+     * @brief      Write multiple elements to the ring buffer. Only call this from the producer.
+     * @param[in]  data
+     *             The array of elements to write.
+     * @param[in]  dataCount
+     *             The number of elements to write.
+     * @return     The number of elements actually written to the buffer, limited to the free space.
+     */
+    std::size_t write(const T data[], std::size_t dataCount);
+
+    /**
+     * @brief       Read a single element from the ring buffer. Only call this from the consumer.
+     * @param[out]  data
+     *              The variable to store the read element.
+     * @return      `true` if an element was read successfully, `false` if the buffer is empty or not attached.
+     */
+    bool read(T& data);
+
+    /**
+     * @brief       Read multiple elements from the ring buffer. Only call this from the consumer.
+     * @param[out]  data
+     *              The array to store the read elements.
+     * @param[in]   dataCount
+     *              The maximum number of elements to read.
+     * @return      The number of elements actually read from the buffer.
+     */
+    std::size_t read(T data[], std::size_t dataCount);
+
+    /**
+     * @brief      Reserve free storage in the segment for writing without copying. Only call this from the producer.
+     * @param[in]  dataCount
+     *             The maximum number of elements to reserve.
+     * @return     The reserved storage, limited to the free space of the buffer.
+     */
+    MEM::memorySpanPair<T> writeReserve(std::size_t dataCount);
+
+    /**
+     * @brief      Publish elements that were written into storage obtained with `writeReserve()`. Only call this from the producer.
+     * @param[in]  dataCount
+     *             The number of elements that were written, counted from the start of the reserved storage.
+     * @return     The number of elements actually published, limited to the free space of the buffer.
+     */
+    std::size_t writeCommit(std::size_t dataCount);
+
+    /**
+     * @brief   Acquire the stored elements for reading without copying. Only call this from the consumer.
+     * @return  All stored elements, oldest first, as spans inside the segment.
+     */
+    MEM::memorySpanPair<const T> readAcquire();
+
+    /**
+     * @brief      Free the oldest elements after they were processed through `readAcquire()`. Only call this from the consumer.
+     * @param[in]  dataCount
+     *             The number of elements to free.
+     * @return     The number of elements actually freed, limited to the number of stored elements.
+     */
+    std::size_t readRelease(std::size_t dataCount);
+
+  private:
+    static constexpr uint32_t    headerMagic  = 0x42525444;             //!< Marks an initialized segment ("DTRB").
+    static constexpr std::size_t elementCount = bufferSize / sizeof(T); //!< Number of elements that can fit in the buffer.
+    static constexpr std::size_t segmentSize  = sizeof(MEM::sharedMemoryRingBufferHeader_t) + elementCount * sizeof(T);
+    static_assert(elementCount > 0, "Buffer size is too small to hold even one element of type T.");
+    static_assert(std::is_trivially_copyable<T>::value, "Type T must be trivially copyable.");
+    static_assert(alignof(T) <= cacheLineSize, "Type T must not require a larger alignment than a cache line.");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "The counters must be lock-free to be shared between processes.");
+
+    MEM::sharedMemoryRingBufferHeader_t* m_header;             //!< Header at the start of the mapped segment.
+    T*                                   m_dataArray;          //!< Storage in the mapped segment, directly after the header.
+    bool                                 m_isCreator;          //!< `true` if this instance created the segment.
+    std::string                          m_name;               //!< Name of the segment.
+    uint64_t                             m_cachedReadCounter;  //!< Producer's last observed read counter.
+    uint64_t                             m_cachedWriteCounter; //!< Consumer's last observed write counter.
+
+    /**
+     * @brief      Open and map a segment.
+     * @param[in]  name
+     *             The name of the segment.
+     * @param[in]  openFlags
+     *             The flags passed to `shm_open()`.
+     * @return     `true` if the segment is mapped, `false` otherwise.
+     */
+    bool map(const char* name, int openFlags);
+
+    /**
+     * @brief  Release the mapping of the segment.
+     */
+    void unmap();
+
+    /**
+     * @brief      Get the elements between two counters as spans inside the segment.
+     * @param[in]  startCounter
+     *             The counter of the first element.
+     * @param[in]  count
+     *             The number of elements, at most the capacity.
+     * @return     The elements as spans, split at the end of the storage.
+     */
+    MEM::memorySpanPair<T> spansAt(uint64_t startCounter, std::size_t count) const;
+  };
+#endif
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+#if defined(__linux__)
+namespace MEM
+{
+  template <typename T, std::size_t bufferSize>
+  sharedMemoryRingBuffer<T, bufferSize>::sharedMemoryRingBuffer() :
+    m_header(nullptr),
+    m_dataArray(nullptr),
+    m_isCreator(false),
+    m_name(),
+    m_cachedReadCounter(0),
+    m_cachedWriteCounter(0)
+  {
+  }
+
+  template <typename T, std::size_t bufferSize>
+  sharedMemoryRingBuffer<T, bufferSize>::~sharedMemoryRingBuffer()
+  {
+    detach();
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool sharedMemoryRingBuffer<T, bufferSize>::create(const char* name)
+  {
+    if (isAttached())
+    {
+      return false;
+    }
+
+    shm_unlink(name);
+    if (!map(name, O_CREAT | O_EXCL | O_RDWR))
+    {
+      return false;
+    }
+
+    // The segment is zero-filled by ftruncate(), so the counters start at 0 and the magic number is not yet valid
+    m_header->version          = MEM::sharedMemoryRingBufferVersion;
+    m_header->headerSize       = static_cast<uint32_t>(sizeof(MEM::sharedMemoryRingBufferHeader_t));
+    m_header->elementSize      = static_cast<uint32_t>(sizeof(T));
+    m_header->elementAlignment = static_cast<uint32_t>(alignof(T));
+    m_header->elementCount     = elementCount;
+    m_header->attachCount.store(1, std::memory_order_relaxed);
+    m_header->magic.store(headerMagic, std::memory_order_release);
+
+    m_isCreator          = true;
+    m_cachedReadCounter  = 0;
+    m_cachedWriteCounter = 0;
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool sharedMemoryRingBuffer<T, bufferSize>::attach(const char* name)
+  {
+    if (isAttached() || !map(name, O_RDWR))
+    {
+      return false;
+    }
+
+    const bool layoutMatches = (m_header->magic.load(std::memory_order_acquire) == headerMagic) &&
+                               (m_header->version == MEM::sharedMemoryRingBufferVersion) &&
+                               (m_header->headerSize == sizeof(MEM::sharedMemoryRingBufferHeader_t)) &&
+                               (m_header->elementSize == sizeof(T)) && (m_header->elementAlignment == alignof(T)) &&
+                               (m_header->elementCount == elementCount);
+    if (!layoutMatches)
+    {
+      unmap();
+      return false;
+    }
+
+    m_header->attachCount.fetch_add(1, std::memory_order_relaxed);
+    m_isCreator          = false;
+    m_cachedReadCounter  = m_header->readCounter.load(std::memory_order_acquire);
+    m_cachedWriteCounter = m_header->writeCounter.load(std::memory_order_acquire);
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  void sharedMemoryRingBuffer<T, bufferSize>::detach()
+  {
+    if (!isAttached())
+    {
+      return;
+    }
+
+    m_header->attachCount.fetch_sub(1, std::memory_order_relaxed);
+    if (m_isCreator)
+    {
+      // Attached processes keep their mapping, only the name disappears
+      shm_unlink(m_name.c_str());
+    }
+    unmap();
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool sharedMemoryRingBuffer<T, bufferSize>::isAttached() const
+  {
+    return m_header != nullptr;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t sharedMemoryRingBuffer<T, bufferSize>::attachCount() const
+  {
+    return isAttached() ? m_header->attachCount.load(std::memory_order_relaxed) : 0;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool sharedMemoryRingBuffer<T, bufferSize>::isEmpty() const
+  {
+    return count() == 0;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool sharedMemoryRingBuffer<T, bufferSize>::isFull() const
+  {
+    return count() == elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t sharedMemoryRingBuffer<T, bufferSize>::count() const
+  {
+    if (!isAttached())
+    {
+      return 0;
+    }
+    // The read counter is loaded first, so the difference never goes negative. It can exceed the capacity when the consumer
+    // and the producer both move on between the two loads, but no more than the capacity is ever stored
+    const uint64_t readCounter = m_header->readCounter.load(std::memory_order_acquire);
+    const uint64_t difference  = m_header->writeCounter.load(std::memory_order_acquire) - readCounter;
+    return (difference > elementCount) ? elementCount : static_cast<std::size_t>(difference);
+  }
+
+  template <typename T, std::size_t bufferSize>
+  constexpr std::size_t sharedMemoryRingBuffer<T, bufferSize>::capacity() const
+  {
+    return elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool sharedMemoryRingBuffer<T, bufferSize>::write(const T& data)
+  {
+    return write(&data, 1) == 1;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t sharedMemoryRingBuffer<T, bufferSize>::write(const T data[], std::size_t dataCount)
+  {
+    const MEM::memorySpanPair<T> spans = writeReserve(dataCount);
+    if (spans.first.size > 0)
+    {
+      std::memcpy(spans.first.data, data, spans.first.size * sizeof(T));
+    }
+    if (spans.second.size > 0)
+    {
+      std::memcpy(spans.second.data, data + spans.first.size, spans.second.size * sizeof(T));
+    }
+    return writeCommit(spans.size());
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool sharedMemoryRingBuffer<T, bufferSize>::read(T& data)
+  {
+    return read(&data, 1) == 1;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t sharedMemoryRingBuffer<T, bufferSize>::read(T data[], std::size_t dataCount)
+  {
+    const MEM::memorySpanPair<const T> spans = readAcquire().subRange(0, dataCount);
+    if (spans.first.size > 0)
+    {
+      std::memcpy(data, spans.first.data, spans.first.size * sizeof(T));
+    }
+    if (spans.second.size > 0)
+    {
+      std::memcpy(data + spans.first.size, spans.second.data, spans.second.size * sizeof(T));
+    }
+    return readRelease(spans.size());
+  }
+
+  template <typename T, std::size_t bufferSize>
+  MEM::memorySpanPair<T> sharedMemoryRingBuffer<T, bufferSize>::writeReserve(std::size_t dataCount)
+  {
+    if (!isAttached())
+    {
+      return MEM::memorySpanPair<T>{};
+    }
+
+    const uint64_t writeCounter = m_header->writeCounter.load(std::memory_order_relaxed);
+    std::size_t    freeSpace    = elementCount - static_cast<std::size_t>(writeCounter - m_cachedReadCounter);
+    if (freeSpace < dataCount)
+    {
+      // Only look at the consumer's cache line when the cached counter does not show enough free space
+      m_cachedReadCounter = m_header->readCounter.load(std::memory_order_acquire);
+      freeSpace           = elementCount - static_cast<std::size_t>(writeCounter - m_cachedReadCounter);
+    }
+    return spansAt(writeCounter, (dataCount < freeSpace) ? dataCount : freeSpace);
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t sharedMemoryRingBuffer<T, bufferSize>::writeCommit(std::size_t dataCount)
+  {
+    if (!isAttached())
+    {
+      return 0;
+    }
+
+    const uint64_t    writeCounter = m_header->writeCounter.load(std::memory_order_relaxed);
+    const std::size_t freeSpace    = elementCount - static_cast<std::size_t>(writeCounter - m_cachedReadCounter);
+    const std::size_t commitCount  = (dataCount < freeSpace) ? dataCount : freeSpace;
+    m_header->writeCounter.store(writeCounter + commitCount, std::memory_order_release);
+    return commitCount;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  MEM::memorySpanPair<const T> sharedMemoryRingBuffer<T, bufferSize>::readAcquire()
+  {
+    if (!isAttached())
+    {
+      return MEM::memorySpanPair<const T>{};
+    }
+
+    const uint64_t readCounter = m_header->readCounter.load(std::memory_order_relaxed);
+    m_cachedWriteCounter       = m_header->writeCounter.load(std::memory_order_acquire);
+
+    const MEM::memorySpanPair<T> spans = spansAt(readCounter, static_cast<std::size_t>(m_cachedWriteCounter - readCounter));
+    return MEM::memorySpanPair<const T>{{spans.first.data, spans.first.size}, {spans.second.data, spans.second.size}};
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t sharedMemoryRingBuffer<T, bufferSize>::readRelease(std::size_t dataCount)
+  {
+    if (!isAttached())
+    {
+      return 0;
+    }
+
+    const uint64_t readCounter = m_header->readCounter.load(std::memory_order_relaxed);
+    std::size_t    storedCount = static_cast<std::size_t>(m_cachedWriteCounter - readCounter);
+    if (storedCount < dataCount)
+    {
+      m_cachedWriteCounter = m_header->writeCounter.load(std::memory_order_acquire);
+      storedCount          = static_cast<std::size_t>(m_cachedWriteCounter - readCounter);
+    }
+    const std::size_t releaseCount = (dataCount < storedCount) ? dataCount : storedCount;
+    m_header->readCounter.store(readCounter + releaseCount, std::memory_order_release);
+    return releaseCount;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool sharedMemoryRingBuffer<T, bufferSize>::map(const char* name, int openFlags)
+  {
+    const int fileDescriptor = shm_open(name, openFlags, S_IRUSR | S_IWUSR);
+    if (fileDescriptor < 0)
+    {
+      return false;
+    }
+
+    bool sizeValid = true;
+    if ((openFlags & O_CREAT) != 0)
+    {
+      sizeValid = (ftruncate(fileDescriptor, static_cast<off_t>(segmentSize)) == 0);
+    }
+    else
+    {
+      // A smaller segment belongs to a different layout and must not be mapped beyond its end
+      struct stat status;
+      sizeValid = (fstat(fileDescriptor, &status) == 0) && (static_cast<std::size_t>(status.st_size) == segmentSize);
+    }
+
+    void* mapping = sizeValid ? mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0) : MAP_FAILED;
+    close(fileDescriptor);
+    if (mapping == MAP_FAILED)
+    {
+      if ((openFlags & O_CREAT) != 0)
+      {
+        shm_unlink(name);
+      }
+      return false;
+    }
+
+    m_header    = static_cast<MEM::sharedMemoryRingBufferHeader_t*>(mapping);
+    m_dataArray = reinterpret_cast<T*>(static_cast<uint8_t*>(mapping) + sizeof(MEM::sharedMemoryRingBufferHeader_t));
+    m_name      = name;
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  void sharedMemoryRingBuffer<T, bufferSize>::unmap()
+  {
+    munmap(m_header, segmentSize);
+    m_header    = nullptr;
+    m_dataArray = nullptr;
+    m_isCreator = false;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  MEM::memorySpanPair<T> sharedMemoryRingBuffer<T, bufferSize>::spansAt(uint64_t startCounter, std::size_t count) const
+  {
+    const std::size_t position  = static_cast<std::size_t>(startCounter % elementCount);
+    const std::size_t firstSize = ((elementCount - position) < count) ? (elementCount - position) : count;
+
+    MEM::memorySpanPair<T> spans;
+    spans.first.data  = (firstSize > 0) ? &m_dataArray[position] : nullptr;
+    spans.first.size  = firstSize;
+    spans.second.data = (count > firstSize) ? m_dataArray : nullptr;
+    spans.second.size = count - firstSize;
+    return spans;
+  }
+
+} // namespace MEM
+#endif
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
@@ -0,0 +1,243 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../shared_memory_ring_buffer.hpp"
+#include <thread>
+
+#if defined(__linux__)
+#include <sys/wait.h>
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class testSharedMemoryRingBuffer : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testSharedMemoryRingBufferCreateAttach();
+  void testSharedMemoryRingBufferWriteRead();
+  void testSharedMemoryRingBufferReserveAcquire();
+  void testSharedMemoryRingBufferLayoutValidation();
+  void testSharedMemoryRingBufferBetweenProcesses();
+};
+#endif
+
+#if defined(__linux__)
+namespace
+{
+  /**
+   * @brief      Build a segment name that is unique for the test process.
+   * @param[in]  suffix
+   *             Distinguishes the segments of the test cases.
+   * @return     The segment name.
+   */
+  std::string segmentName(const char* suffix)
+  {
+    return "/device_t_test_" + std::to_string(getpid()) + "_" + suffix;
+  }
+} // namespace
+#endif
+
+TEST_CASE(testSharedMemoryRingBuffer, testSharedMemoryRingBufferCreateAttach)
+{
+#if defined(__linux__)
+  const std::string                         NAME = segmentName("attach");
+  MEM::sharedMemoryRingBuffer<uint32_t, 64> producer;
+  MEM::sharedMemoryRingBuffer<uint32_t, 64> consumer;
+
+  QVERIFY(!producer.isAttached());
+  QVERIFY(!producer.write(1));
+  QVERIFY(!consumer.attach(NAME.c_str()));
+
+  QVERIFY(producer.create(NAME.c_str()));
+  QVERIFY(!producer.create(NAME.c_str()));
+  QCOMPARE(static_cast<int>(producer.attachCount()), 1);
+  QVERIFY(consumer.attach(NAME.c_str()));
+  QCOMPARE(static_cast<int>(producer.attachCount()), 2);
+
+  // The mapping stays valid for attached instances after the creator has detached and the name is gone
+  QVERIFY(producer.write(42));
+  producer.detach();
+  QVERIFY(!producer.isAttached());
+  QCOMPARE(static_cast<int>(consumer.attachCount()), 1);
+  uint32_t value = 0;
+  QVERIFY(consumer.read(value));
+  QCOMPARE(value, 42u);
+
+  MEM::sharedMemoryRingBuffer<uint32_t, 64> lateConsumer;
+  QVERIFY(!lateConsumer.attach(NAME.c_str()));
+  consumer.detach();
+  QVERIFY(!consumer.isAttached());
+#endif
+}
+
+TEST_CASE(testSharedMemoryRingBuffer, testSharedMemoryRingBufferWriteRead)
+{
+#if defined(__linux__)
+  const std::string                                           NAME = segmentName("write_read");
+  MEM::sharedMemoryRingBuffer<uint32_t, 8 * sizeof(uint32_t)> producer;
+  MEM::sharedMemoryRingBuffer<uint32_t, 8 * sizeof(uint32_t)> consumer;
+  QVERIFY(producer.create(NAME.c_str()));
+  QVERIFY(consumer.attach(NAME.c_str()));
+  QCOMPARE(static_cast<int>(producer.capacity()), 8);
+
+  const uint32_t input[10]  = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  uint32_t       output[10] = {};
+
+  // Fills up, the rest is rejected
+  QCOMPARE(static_cast<int>(producer.write(input, 10)), 8);
+  QVERIFY(producer.isFull());
+  QVERIFY(consumer.isFull());
+  QCOMPARE(static_cast<int>(consumer.read(output, 5)), 5);
+  QCOMPARE(output[4], 5u);
+
+  // Crosses the end of the storage
+  QCOMPARE(static_cast<int>(producer.write(&input[8], 2)), 2);
+  QCOMPARE(static_cast<int>(consumer.count()), 5);
+  QCOMPARE(static_cast<int>(consumer.read(output, 10)), 5);
+  QCOMPARE(output[0], 6u);
+  QCOMPARE(output[2], 8u);
+  QCOMPARE(output[3], 9u);
+  QCOMPARE(output[4], 10u);
+  QVERIFY(consumer.isEmpty());
+#endif
+}
+
+TEST_CASE(testSharedMemoryRingBuffer, testSharedMemoryRingBufferReserveAcquire)
+{
+#if defined(__linux__)
+  const std::string                                            NAME = segmentName("reserve");
+  MEM::sharedMemoryRingBuffer<uint16_t, 16 * sizeof(uint16_t)> producer;
+  MEM::sharedMemoryRingBuffer<uint16_t, 16 * sizeof(uint16_t)> consumer;
+  QVERIFY(producer.create(NAME.c_str()));
+  QVERIFY(consumer.attach(NAME.c_str()));
+
+  MEM::memorySpanPair<uint16_t> reserved = producer.writeReserve(12);
+  QCOMPARE(static_cast<int>(reserved.first.size), 12);
+  for (std::size_t i = 0; i < reserved.first.size; ++i)
+  {
+    reserved.first.data[i] = static_cast<uint16_t>(i);
+  }
+  QCOMPARE(static_cast<int>(producer.writeCommit(12)), 12);
+  QCOMPARE(static_cast<int>(consumer.readRelease(10)), 10);
+
+  // The free space now wraps, so it is split into two spans
+  reserved = producer.writeReserve(100);
+  QCOMPARE(static_cast<int>(reserved.first.size), 4);
+  QCOMPARE(static_cast<int>(reserved.second.size), 10);
+  reserved.first.data[0]  = 100;
+  reserved.second.data[0] = 200;
+  QCOMPARE(static_cast<int>(producer.writeCommit(5)), 5);
+
+  const MEM::memorySpanPair<const uint16_t> stored = consumer.readAcquire();
+  QCOMPARE(static_cast<int>(stored.size()), 7);
+  QCOMPARE(static_cast<int>(stored.first.data[0]), 10);
+  QCOMPARE(static_cast<int>(stored.first.data[2]), 100);
+  QCOMPARE(static_cast<int>(stored.second.data[0]), 200);
+  QCOMPARE(static_cast<int>(consumer.readRelease(100)), 7);
+  QVERIFY(consumer.isEmpty());
+#endif
+}
+
+TEST_CASE(testSharedMemoryRingBuffer, testSharedMemoryRingBufferLayoutValidation)
+{
+#if defined(__linux__)
+  const std::string                          NAME = segmentName("layout");
+  MEM::sharedMemoryRingBuffer<uint32_t, 256> producer;
+  QVERIFY(producer.create(NAME.c_str()));
+
+  // Same segment size, different element type
+  MEM::sharedMemoryRingBuffer<uint64_t, 256> wrongType;
+  QVERIFY(!wrongType.attach(NAME.c_str()));
+  QVERIFY(!wrongType.isAttached());
+
+  // Different segment size
+  MEM::sharedMemoryRingBuffer<uint32_t, 128> wrongSize;
+  QVERIFY(!wrongSize.attach(NAME.c_str()));
+
+  MEM::sharedMemoryRingBuffer<uint32_t, 256> consumer;
+  QVERIFY(consumer.attach(NAME.c_str()));
+  QCOMPARE(static_cast<int>(producer.attachCount()), 2);
+
+  // A segment of the right size whose header was never initialized
+  const std::string RAW_NAME       = segmentName("raw");
+  const int         fileDescriptor = shm_open(RAW_NAME.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+  QVERIFY(fileDescriptor >= 0);
+  QVERIFY(ftruncate(fileDescriptor, sizeof(MEM::sharedMemoryRingBufferHeader_t) + 256) == 0);
+  close(fileDescriptor);
+  MEM::sharedMemoryRingBuffer<uint32_t, 256> uninitialized;
+  QVERIFY(!uninitialized.attach(RAW_NAME.c_str()));
+  shm_unlink(RAW_NAME.c_str());
+#endif
+}
+
+TEST_CASE(testSharedMemoryRingBuffer, testSharedMemoryRingBufferBetweenProcesses)
+{
+#if defined(__linux__)
+  const std::string                           NAME           = segmentName("processes");
+  const uint32_t                              TRANSFER_COUNT = 200000;
+  MEM::sharedMemoryRingBuffer<uint32_t, 4096> producer;
+  QVERIFY(producer.create(NAME.c_str()));
+
+  const pid_t child = fork();
+  if (child == 0)
+  {
+    // Consumer process: checks that every value arrives once and in order
+    MEM::sharedMemoryRingBuffer<uint32_t, 4096> consumer;
+    if (!consumer.attach(NAME.c_str()))
+    {
+      _exit(2);
+    }
+    uint32_t expected = 0;
+    uint32_t values[64];
+    while (expected < TRANSFER_COUNT)
+    {
+      const std::size_t readCount = consumer.read(values, 64);
+      for (std::size_t i = 0; i < readCount; ++i)
+      {
+        if (values[i] != expected++)
+        {
+          _exit(1);
+        }
+      }
+      if (readCount == 0)
+      {
+        std::this_thread::yield();
+      }
+    }
+    consumer.detach();
+    _exit(0);
+  }
+  QVERIFY(child > 0);
+
+  uint32_t next = 0;
+  while (next < TRANSFER_COUNT)
+  {
+    if (producer.write(next))
+    {
+      ++next;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  int status = -1;
+  QCOMPARE(waitpid(child, &status, 0), child);
+  QVERIFY(WIFEXITED(status));
+  QCOMPARE(WEXITSTATUS(status), 0);
+  QVERIFY(producer.isEmpty());
+  QCOMPARE(static_cast<int>(producer.attachCount()), 1);
+#endif
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testSharedMemoryRingBuffer)
+#include "shared_memory_ring_buffer_test.moc"
+#endif
@@ -0,0 +1,21 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle release
+
+TEMPLATE = app
+
+SOURCES +=  \
+    shared_memory_ring_buffer_test.cpp \
+
+HEADERS += \
+    ../shared_memory_ring_buffer.hpp \
+    ../memory_span.hpp \
+    ../../CoreComponents/global.hpp \
+
+INCLUDEPATH += \
+    ../../CoreComponents \
+    ../MemoryManagement \
+
+unix:!macx: LIBS += -lrt
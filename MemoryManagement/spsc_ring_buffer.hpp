@@ -0,0 +1,437 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     spsc_ring_buffer.hpp
+ * @version  0.3
+ * @brief    Definition of the spscRingBuffer class.
+ * @details  The `spscRingBuffer` class is a lock-free single-producer/single-consumer variant of `ringBuffer` with statically
+ *           allocated memory. Exactly one thread (or interrupt) may write and exactly one thread may read at the same time,
+ *           without any additional locking.
+ *
+ *           The producer owns the write index and the consumer owns the read index. Each index is only ever modified by
+ *           its owner and published with release semantics, the other side observes it with acquire semantics. There is no
+ *           shared element counter; the number of stored elements is derived from the distance between both indices.
+ *           Both indices run over twice the capacity, which allows a full buffer to be told apart from an empty one without
+ *           sacrificing a slot and without any division. Each index lives on its own cache line, together with the owner's
+ *           cached copy of the other index, so producer and consumer do not invalidate each other's cache lines on every call.
+ *
+ *           To use the `spscRingBuffer` class, follow these steps:
+ *           -# Instantiate an instance with the desired data type and buffer size in bytes as template parameters,
+ *              like this: `spscRingBuffer<int, 64> mySpscRingBuffer;`.
+ *           -# Call `write()` only from the producer thread, like this: `mySpscRingBuffer.write(42);`.
+ *           -# Call `read()` only from the consumer thread, like this: `int myValue; mySpscRingBuffer.read(myValue);`.
+ *           -# Check the return value of `write()` and `read()` to determine whether or not an operation was successful.
+ *           -# Optionally call `readWait()` or `writeWait()` to sleep until data or free space is available instead of polling,
+ *              like this: `if (mySpscRingBuffer.readWait(std::chrono::milliseconds(10))) { mySpscRingBuffer.read(myValue); }`.
+ *           -# Optionally call `setWakeupThreshold()` to let a sleeping consumer only be woken once a batch of elements is
+ *              available, like this: `mySpscRingBuffer.setWakeupThreshold(16);`.
+ *
+ *           The wakeups are issued by `write()` and `read()` themselves. While no thread sleeps, they only cost a memory fence
+ *           and a load, no system call.
+ *
+ * @note     Unlike `ringBuffer`, overwriting the oldest element is not supported, since only the consumer may move the read index.
+ *           `reset()` and `setWakeupThreshold()` are not thread-safe and may only be called while neither side is accessing the buffer.
+ *           The buffer size (`bufferSize`) must be large enough to hold at least one element of type `T`.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include "wait_point.hpp"
+#include <atomic>
+#include <chrono>
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+  /**
+   * @brief    Class template for a lock-free single-producer/single-consumer ring buffer with statically allocated memory.
+   * @details  The `bufferSize` specifies the size of the buffer in bytes.
+   *           The class calculates how many elements of type `T` can fit into the buffer.
+   * @tparam   T
+   *           Data type of the elements in the ring buffer.
+   * @tparam   bufferSize
+   *           The size of the buffer in bytes.
+   */
+  template <typename T, std::size_t bufferSize>
+  class spscRingBuffer
+  {
+  public:
+    /**
+     * @brief  Constructor that initializes an empty ring buffer.
+     */
+    spscRingBuffer();
+
+    // Rule of Five
+    spscRingBuffer(const spscRingBuffer&)            = delete;
+    spscRingBuffer& operator=(const spscRingBuffer&) = delete;
+    spscRingBuffer(spscRingBuffer&&)                 = delete;
+    spscRingBuffer& operator=(spscRingBuffer&&)      = delete;
+    ~spscRingBuffer()                                = default;
+
+    /**
+     * @brief  Reset the ring buffer to its initial, empty state.
+     * @note   Not thread-safe, neither producer nor consumer may access the buffer during the reset.
+     */
+    void reset();
+
+    /**
+     * @brief   Check if the ring buffer is empty.
+     * @return  `true` if the buffer is empty, `false` otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief   Check if the ring buffer is full.
+     * @return  `true` if the buffer is full, `false` otherwise.
+     */
+    bool isFull() const;
+
+    /**
+     * @brief   Get the number of elements currently stored in the ring buffer.
+     * @return  The number of elements currently stored, which may already be outdated when called from a third thread.
+     */
+    std::size_t count() const;
+
+    /**
+     * @brief   Get the maximum number of elements that can be stored in the ring buffer.
+     * @return  The capacity of the ring buffer.
+     */
+    constexpr std::size_t capacity() const;
+
+    /**
+     * @brief      Write a single element to the ring buffer, may only be called by the producer.
+     * @param[in]  data
+     *             The element to be written to the buffer.
+     * @return     `true` if the data was written successfully, `false` if the buffer is full.
+     */
+    bool write(const T& data);
+
+    /**
+     * @brief      Write multiple elements to the ring buffer, may only be called by the producer.
+     * @details    All elements that fit are published to the consumer at once.
+     * @param[in]  data
+     *             The array of elements to write.
+     * @param[in]  dataCount
+     *             The number of elements to write.
+     * @return     The number of elements actually written to the buffer.
+     */
+    std::size_t write(const T data[], std::size_t dataCount);
+
+    /**
+     * @brief      Write a single element to the ring buffer (move semantics), may only be called by the producer.
+     * @param[in]  data
+     *             The element to be moved into the buffer.
+     * @return     `true` if the data was written successfully, `false` if the buffer is full.
+     */
+    bool write(T&& data);
+
+    /**
+     * @brief       Read a single element from the ring buffer, may only be called by the consumer.
+     * @param[out]  data
+     *              The variable to store the read element.
+     * @return      `true` if an element was read successfully, `false` if the buffer is empty.
+     */
+    bool read(T& data);
+
+    /**
+     * @brief       Read multiple elements from the ring buffer, may only be called by the consumer.
+     * @details     All elements that are read are released to the producer at once.
+     * @param[out]  data
+     *              The array to store the read elements.
+     * @param[in]   dataCount
+     *              The maximum number of elements to read.
+     * @return      The number of elements actually read from the buffer.
+     */
+    std::size_t read(T data[], std::size_t dataCount);
+
+    /**
+     * @brief      Wait until elements are available for reading, may only be called by the consumer.
+     * @details    The consumer sleeps until at least the wakeup threshold of elements is stored or the timeout expires.
+     * @param[in]  timeout
+     *             The maximum time to wait.
+     * @return     `true` if at least one element can be read (on timeout possibly fewer than the threshold), `false` if the
+     *             buffer is still empty.
+     */
+    bool readWait(std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief      Wait until free space is available for writing, may only be called by the producer.
+     * @param[in]  timeout
+     *             The maximum time to wait.
+     * @return     `true` if at least one element can be written, `false` if the buffer is still full.
+     */
+    bool writeWait(std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief      Set the number of stored elements at which a consumer sleeping in `readWait()` is woken.
+     * @details    A larger threshold lets the consumer process elements in batches and saves wakeups. The default is 1.
+     * @param[in]  threshold
+     *             The number of elements, clamped to the range from 1 to the capacity.
+     * @note       Not thread-safe, may only be called while no thread is waiting.
+     */
+    void setWakeupThreshold(std::size_t threshold);
+
+  private:
+    static constexpr std::size_t elementCount = bufferSize / sizeof(T); //!< Number of elements that can fit in the buffer.
+    static_assert(elementCount > 0, "Buffer size is too small to hold even one element of type T.");
+    static constexpr std::size_t indexRange = 2 * elementCount; //!< Indices run over twice the capacity to tell full from empty.
+
+    alignas(cacheLineSize) std::atomic<std::size_t> m_writeIndex;     //!< Write position, owned by the producer.
+    std::size_t                                     m_cachedReadIndex;  //!< Producer's last observed read position.
+    std::size_t                                     m_wakeupThreshold;  //!< Number of stored elements that wakes the consumer.
+    alignas(cacheLineSize) std::atomic<std::size_t> m_readIndex;        //!< Read position, owned by the consumer.
+    std::size_t                                     m_cachedWriteIndex; //!< Consumer's last observed write position.
+    alignas(cacheLineSize) T m_dataArray[elementCount];                 //!< The statically allocated array used as the ring buffer.
+    alignas(cacheLineSize) waitPoint m_readWaitPoint;                   //!< Consumer sleeps here until elements are available.
+    alignas(cacheLineSize) waitPoint m_writeWaitPoint;                  //!< Producer sleeps here until free space is available.
+
+    /**
+     * @brief      Calculate the number of elements between a read and a write index.
+     * @param[in]  writeIndex
+     *             The write index.
+     * @param[in]  readIndex
+     *             The read index.
+     * @return     The number of elements stored between both indices.
+     */
+    static std::size_t distance(std::size_t writeIndex, std::size_t readIndex);
+
+    /**
+     * @brief      Get the free space for the producer, refreshing the cached read index only if it is insufficient.
+     * @param[in]  writeIndex
+     *             The current write index.
+     * @param[in]  dataCount
+     *             The number of elements the producer wants to write.
+     * @return     The number of elements that can be written.
+     */
+    std::size_t freeSpace(std::size_t writeIndex, std::size_t dataCount);
+
+    /**
+     * @brief      Publish written elements to the consumer and wake it once the wakeup threshold is reached.
+     * @param[in]  writeIndex
+     *             The write index before the elements were written.
+     * @param[in]  itemsWritten
+     *             The number of elements written, at least 1.
+     */
+    void publishWrite(std::size_t writeIndex, std::size_t itemsWritten);
+
+    /**
+     * @brief      Advances an index by a number of positions, wrapping around the index range if necessary.
+     * @param[in]  index
+     *             The current index.
+     * @param[in]  steps
+     *             The number of positions to advance, at most the capacity.
+     * @return     The advanced index.
+     */
+    static std::size_t advanceIndex(std::size_t index, std::size_t steps);
+
+    /**
+     * @brief      Convert an index to the position in the data array.
+     * @param[in]  index
+     *             The index to convert.
+     * @return     The position in `m_dataArray`.
+     */
+    static std::size_t arrayPosition(std::size_t index);
+  };
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+namespace MEM
+{
+  template <typename T, std::size_t bufferSize>
+  spscRingBuffer<T, bufferSize>::spscRingBuffer() : m_writeIndex(0), m_cachedReadIndex(0), m_wakeupThreshold(1), m_readIndex(0),
+                                                   m_cachedWriteIndex(0)
+  {
+    static_assert(std::is_default_constructible<T>::value, "Type T must be default constructible.");
+  }
+
+  template <typename T, std::size_t bufferSize>
+  void spscRingBuffer<T, bufferSize>::reset()
+  {
+    m_writeIndex.store(0, std::memory_order_relaxed);
+    m_readIndex.store(0, std::memory_order_relaxed);
+    m_cachedReadIndex  = 0;
+    m_cachedWriteIndex = 0;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool spscRingBuffer<T, bufferSize>::isEmpty() const
+  {
+    return count() == 0;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool spscRingBuffer<T, bufferSize>::isFull() const
+  {
+    return count() == elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t spscRingBuffer<T, bufferSize>::count() const
+  {
+    return distance(m_writeIndex.load(std::memory_order_acquire), m_readIndex.load(std::memory_order_acquire));
+  }
+
+  template <typename T, std::size_t bufferSize>
+  constexpr std::size_t spscRingBuffer<T, bufferSize>::capacity() const
+  {
+    return elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool spscRingBuffer<T, bufferSize>::write(const T& data)
+  {
+    return write(&data, 1) == 1;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t spscRingBuffer<T, bufferSize>::write(const T data[], std::size_t dataCount)
+  {
+    const std::size_t writeIndex   = m_writeIndex.load(std::memory_order_relaxed);
+    const std::size_t available    = freeSpace(writeIndex, dataCount);
+    const std::size_t itemsWritten = (dataCount < available) ? dataCount : available;
+    std::size_t       position     = arrayPosition(writeIndex);
+
+    for (std::size_t i = 0; i < itemsWritten; ++i)
+    {
+      m_dataArray[position] = data[i];
+      position              = (position + 1 == elementCount) ? 0 : position + 1;
+    }
+
+    if (itemsWritten > 0)
+    {
+      publishWrite(writeIndex, itemsWritten);
+    }
+
+    return itemsWritten;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool spscRingBuffer<T, bufferSize>::write(T&& data)
+  {
+    const std::size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+    if (freeSpace(writeIndex, 1) == 0)
+    {
+      return false;
+    }
+
+    m_dataArray[arrayPosition(writeIndex)] = std::move(data);
+    publishWrite(writeIndex, 1);
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool spscRingBuffer<T, bufferSize>::read(T& data)
+  {
+    return read(&data, 1) == 1;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t spscRingBuffer<T, bufferSize>::read(T data[], std::size_t dataCount)
+  {
+    const std::size_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+    std::size_t       available = distance(m_cachedWriteIndex, readIndex);
+
+    if (available < dataCount)
+    {
+      // Only touch the producer's cache line when the cached view is insufficient
+      m_cachedWriteIndex = m_writeIndex.load(std::memory_order_acquire);
+      available          = distance(m_cachedWriteIndex, readIndex);
+    }
+
+    const std::size_t itemsRead = (dataCount < available) ? dataCount : available;
+    std::size_t       position  = arrayPosition(readIndex);
+
+    for (std::size_t i = 0; i < itemsRead; ++i)
+    {
+      data[i]  = std::move(m_dataArray[position]);
+      position = (position + 1 == elementCount) ? 0 : position + 1;
+    }
+
+    if (itemsRead > 0)
+    {
+      m_readIndex.store(advanceIndex(readIndex, itemsRead), std::memory_order_release);
+      m_writeWaitPoint.notify();
+    }
+
+    return itemsRead;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool spscRingBuffer<T, bufferSize>::readWait(std::chrono::nanoseconds timeout)
+  {
+    m_readWaitPoint.waitUntil([this]() { return count() >= m_wakeupThreshold; }, timeout);
+    return !isEmpty();
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool spscRingBuffer<T, bufferSize>::writeWait(std::chrono::nanoseconds timeout)
+  {
+    return m_writeWaitPoint.waitUntil([this]() { return !isFull(); }, timeout);
+  }
+
+  template <typename T, std::size_t bufferSize>
+  void spscRingBuffer<T, bufferSize>::setWakeupThreshold(std::size_t threshold)
+  {
+    m_wakeupThreshold = (threshold == 0) ? 1 : (threshold > elementCount) ? elementCount : threshold;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t spscRingBuffer<T, bufferSize>::distance(std::size_t writeIndex, std::size_t readIndex)
+  {
+    return (writeIndex >= readIndex) ? writeIndex - readIndex : writeIndex + indexRange - readIndex;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t spscRingBuffer<T, bufferSize>::freeSpace(std::size_t writeIndex, std::size_t dataCount)
+  {
+    std::size_t available = elementCount - distance(writeIndex, m_cachedReadIndex);
+
+    if (available < dataCount)
+    {
+      // Only touch the consumer's cache line when the cached view is insufficient
+      m_cachedReadIndex = m_readIndex.load(std::memory_order_acquire);
+      available         = elementCount - distance(writeIndex, m_cachedReadIndex);
+    }
+    return available;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  void spscRingBuffer<T, bufferSize>::publishWrite(std::size_t writeIndex, std::size_t itemsWritten)
+  {
+    const std::size_t nextWriteIndex = advanceIndex(writeIndex, itemsWritten);
+    m_writeIndex.store(nextWriteIndex, std::memory_order_release);
+
+    // The cached read index is never ahead of the real one, so a crossed threshold is never missed
+    if (distance(nextWriteIndex, m_cachedReadIndex) >= m_wakeupThreshold)
+    {
+      m_readWaitPoint.notify();
+    }
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t spscRingBuffer<T, bufferSize>::advanceIndex(std::size_t index, std::size_t steps)
+  {
+    index += steps;
+    return (index >= indexRange) ? index - indexRange : index;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t spscRingBuffer<T, bufferSize>::arrayPosition(std::size_t index)
+  {
+    return (index >= elementCount) ? index - elementCount : index;
+  }
+
+} // namespace MEM
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
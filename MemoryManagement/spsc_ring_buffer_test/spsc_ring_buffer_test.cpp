@@ -0,0 +1,246 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../spsc_ring_buffer.hpp"
+#include <memory>
+#include <thread>
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class testSpscRingBuffer : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testSpscRingBufferWriteRead();
+  void testSpscRingBufferWriteReadMultiple();
+  void testSpscRingBufferWrapAround();
+  void testSpscRingBufferReset();
+  void testSpscRingBufferMoveOnly();
+  void testSpscRingBufferConcurrentTransfer();
+  void testSpscRingBufferWaitTimeout();
+  void testSpscRingBufferBlockingTransfer();
+};
+#endif
+
+TEST_CASE(testSpscRingBuffer, testSpscRingBufferWriteRead)
+{
+  MEM::spscRingBuffer<int, 5 * sizeof(int)> mySpscRingBuffer;
+
+  QVERIFY(mySpscRingBuffer.isEmpty());
+  QCOMPARE(static_cast<int>(mySpscRingBuffer.capacity()), 5);
+
+  // Fill the buffer and verify that it rejects further writes
+  for (int i = 1; i <= 5; ++i)
+  {
+    QVERIFY(mySpscRingBuffer.write(i));
+  }
+  QVERIFY(mySpscRingBuffer.isFull());
+  QVERIFY(!mySpscRingBuffer.write(6));
+  QCOMPARE(static_cast<int>(mySpscRingBuffer.count()), 5);
+
+  // Drain the buffer in FIFO order
+  int value;
+  for (int i = 1; i <= 5; ++i)
+  {
+    QVERIFY(mySpscRingBuffer.read(value));
+    QCOMPARE(value, i);
+  }
+  QVERIFY(!mySpscRingBuffer.read(value));
+  QVERIFY(mySpscRingBuffer.isEmpty());
+}
+
+TEST_CASE(testSpscRingBuffer, testSpscRingBufferWriteReadMultiple)
+{
+  MEM::spscRingBuffer<int, 5 * sizeof(int)> mySpscRingBuffer;
+  int                                       data[7] = { 1, 2, 3, 4, 5, 6, 7 };
+
+  // Only the elements that fit are written
+  QCOMPARE(static_cast<int>(mySpscRingBuffer.write(data, 7)), 5);
+  QVERIFY(mySpscRingBuffer.isFull());
+
+  int values[7];
+  QCOMPARE(static_cast<int>(mySpscRingBuffer.read(values, 3)), 3);
+  QCOMPARE(values[0], 1);
+  QCOMPARE(values[2], 3);
+
+  // Only the elements that are stored are read
+  QCOMPARE(static_cast<int>(mySpscRingBuffer.read(values, 7)), 2);
+  QCOMPARE(values[0], 4);
+  QCOMPARE(values[1], 5);
+  QVERIFY(mySpscRingBuffer.isEmpty());
+}
+
+TEST_CASE(testSpscRingBuffer, testSpscRingBufferWrapAround)
+{
+  MEM::spscRingBuffer<int, 3 * sizeof(int)> mySpscRingBuffer;
+  int                                       value;
+
+  // Cycle through the index range several times to cover every wrap position
+  for (int i = 0; i < 20; ++i)
+  {
+    QVERIFY(mySpscRingBuffer.write(2 * i));
+    QVERIFY(mySpscRingBuffer.write(2 * i + 1));
+    QCOMPARE(static_cast<int>(mySpscRingBuffer.count()), 2);
+    QVERIFY(mySpscRingBuffer.read(value));
+    QCOMPARE(value, 2 * i);
+    QVERIFY(mySpscRingBuffer.read(value));
+    QCOMPARE(value, 2 * i + 1);
+    QVERIFY(mySpscRingBuffer.isEmpty());
+  }
+}
+
+TEST_CASE(testSpscRingBuffer, testSpscRingBufferReset)
+{
+  MEM::spscRingBuffer<int, 5 * sizeof(int)> mySpscRingBuffer;
+
+  mySpscRingBuffer.write(1);
+  mySpscRingBuffer.write(2);
+  QVERIFY(!mySpscRingBuffer.isEmpty());
+
+  mySpscRingBuffer.reset();
+  QVERIFY(mySpscRingBuffer.isEmpty());
+  QCOMPARE(static_cast<int>(mySpscRingBuffer.count()), 0);
+}
+
+TEST_CASE(testSpscRingBuffer, testSpscRingBufferMoveOnly)
+{
+  MEM::spscRingBuffer<std::unique_ptr<int>, 2 * sizeof(std::unique_ptr<int>)> mySpscRingBuffer;
+  std::unique_ptr<int>                                                           value(new int(1));
+
+  // Elements are moved in and out of the buffer, never copied
+  QVERIFY(mySpscRingBuffer.write(std::move(value)));
+  QVERIFY(!value);
+  QVERIFY(mySpscRingBuffer.write(std::unique_ptr<int>(new int(2))));
+  QVERIFY(!mySpscRingBuffer.write(std::unique_ptr<int>(new int(3))));
+
+  QVERIFY(mySpscRingBuffer.read(value));
+  QCOMPARE(*value, 1);
+  QVERIFY(mySpscRingBuffer.read(value));
+  QCOMPARE(*value, 2);
+  QVERIFY(mySpscRingBuffer.isEmpty());
+}
+
+TEST_CASE(testSpscRingBuffer, testSpscRingBufferConcurrentTransfer)
+{
+  static MEM::spscRingBuffer<uint32_t, 64 * sizeof(uint32_t)> mySpscRingBuffer;
+  const uint32_t                                               ELEMENT_COUNT = 200000;
+
+  // The producer alternates between single and bulk writes
+  std::thread producer(
+    [&]()
+    {
+      uint32_t next = 0;
+      while (next < ELEMENT_COUNT)
+      {
+        if (mySpscRingBuffer.isFull())
+        {
+          std::this_thread::yield();
+        }
+        else if ((next % 2) == 0)
+        {
+          next += mySpscRingBuffer.write(next) ? 1 : 0;
+        }
+        else
+        {
+          uint32_t burst[8];
+          uint32_t burstSize = ((ELEMENT_COUNT - next) < 8) ? (ELEMENT_COUNT - next) : 8;
+          for (uint32_t i = 0; i < burstSize; ++i)
+          {
+            burst[i] = next + i;
+          }
+          next += static_cast<uint32_t>(mySpscRingBuffer.write(burst, burstSize));
+        }
+      }
+    });
+
+  // The consumer verifies that every element arrives exactly once and in order
+  uint32_t expected = 0;
+  bool     inOrder  = true;
+  while (expected < ELEMENT_COUNT)
+  {
+    uint32_t    values[16];
+    std::size_t itemsRead = mySpscRingBuffer.read(values, 16);
+    if (itemsRead == 0)
+    {
+      std::this_thread::yield();
+    }
+    for (std::size_t i = 0; i < itemsRead; ++i)
+    {
+      inOrder = inOrder && (values[i] == expected);
+      ++expected;
+    }
+  }
+  producer.join();
+
+  QVERIFY(inOrder);
+  QVERIFY(mySpscRingBuffer.isEmpty());
+}
+
+TEST_CASE(testSpscRingBuffer, testSpscRingBufferWaitTimeout)
+{
+  MEM::spscRingBuffer<int, 4 * sizeof(int)> mySpscRingBuffer;
+  const auto                                TIMEOUT = std::chrono::milliseconds(10);
+
+  QVERIFY(!mySpscRingBuffer.readWait(TIMEOUT));
+  QVERIFY(mySpscRingBuffer.writeWait(TIMEOUT));
+
+  // Below the wakeup threshold the wait times out, but the stored elements are still readable
+  mySpscRingBuffer.setWakeupThreshold(3);
+  QVERIFY(mySpscRingBuffer.write(1));
+  QVERIFY(mySpscRingBuffer.readWait(TIMEOUT));
+
+  for (int i = 2; i <= 4; ++i)
+  {
+    QVERIFY(mySpscRingBuffer.write(i));
+  }
+  QVERIFY(!mySpscRingBuffer.writeWait(TIMEOUT));
+}
+
+TEST_CASE(testSpscRingBuffer, testSpscRingBufferBlockingTransfer)
+{
+  static MEM::spscRingBuffer<uint32_t, 16 * sizeof(uint32_t)> mySpscRingBuffer;
+  const uint32_t                                               ELEMENT_COUNT = 20000;
+  const auto                                                   TIMEOUT       = std::chrono::seconds(5);
+  mySpscRingBuffer.setWakeupThreshold(4);
+
+  // Both sides sleep instead of polling, the producer finishes with a partial batch
+  std::thread producer(
+    [&]()
+    {
+      for (uint32_t next = 0; next < ELEMENT_COUNT; ++next)
+      {
+        while (!mySpscRingBuffer.write(next))
+        {
+          mySpscRingBuffer.writeWait(TIMEOUT);
+        }
+      }
+    });
+
+  uint32_t expected = 0;
+  bool     inOrder  = true;
+  while (expected < ELEMENT_COUNT)
+  {
+    uint32_t values[16];
+    mySpscRingBuffer.readWait(TIMEOUT);
+    std::size_t itemsRead = mySpscRingBuffer.read(values, 16);
+    for (std::size_t i = 0; i < itemsRead; ++i)
+    {
+      inOrder = inOrder && (values[i] == expected);
+      ++expected;
+    }
+  }
+  producer.join();
+
+  QVERIFY(inOrder);
+  QVERIFY(mySpscRingBuffer.isEmpty());
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testSpscRingBuffer)
+#include "spsc_ring_buffer_test.moc"
+#endif
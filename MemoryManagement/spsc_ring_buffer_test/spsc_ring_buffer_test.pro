@@ -0,0 +1,19 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle release
+
+TEMPLATE = app
+
+SOURCES +=  \
+    spsc_ring_buffer_test.cpp \
+
+HEADERS += \
+    ../spsc_ring_buffer.hpp \
+    ../wait_point.hpp \
+    ../../CoreComponents/global.hpp \
+
+INCLUDEPATH += \
+    ../../CoreComponents \
+    ../MemoryManagement \
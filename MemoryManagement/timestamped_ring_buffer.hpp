@@ -0,0 +1,321 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     timestamped_ring_buffer.hpp
+ * @version  0.1
+ * @brief    Definition of the timestampedRingBuffer class.
+ * @details  The `timestampedRingBuffer` class is a `ringBuffer` in which every element carries a timestamp, so that the
+ *           elements of a time window can be found without visiting every stored element.
+ *
+ *           The timestamps are kept in their own ring buffer next to the one with the payloads, and both are advanced in
+ *           lockstep, so an element and its timestamp always share the same position. Because the timestamps must not
+ *           decrease, they are sorted from the oldest to the newest element and a time window is found with two binary
+ *           searches over the densely packed timestamps only. The result refers to the stored elements directly, as (at most
+ *           two) contiguous spans.
+ *
+ *           To use the `timestampedRingBuffer` class, follow these steps:
+ *           -# Instantiate an instance with the desired data type, payload buffer size in bytes and optionally the timestamp
+ *              type as template parameters, like this: `timestampedRingBuffer<gpsFix_t, 4096> myTimestampedRingBuffer;`.
+ *           -# Use the `write()` function to add elements with their timestamp, like this:
+ *              `myTimestampedRingBuffer.write(HAL_GetTick(), myFix);`.
+ *           -# Use the `rangeByTime()` function to obtain all elements within a time window, like this:
+ *              `memorySpanPair<const gpsFix_t> myFixes = myTimestampedRingBuffer.rangeByTime(t0, t1);`.
+ *           -# Use the `releaseBefore()` function to drop elements that are older than the window of interest.
+ *
+ * @note     The timestamps of consecutive writes must not decrease, a write with an older timestamp is rejected.
+ *           Timestamps are compared as plain numbers, so they must not wrap around while elements are stored. The default
+ *           `uint64_t` does not wrap in practice, as long as the source counts in 64 bits too. A 32-bit millisecond tick like
+ *           `HAL_GetTick()` wraps after about 49.7 days: every later write is rejected until the buffer is drained, and with
+ *           overwriting nothing drains it, so the caller must either extend the tick to 64 bits or `reset()` the buffer when
+ *           the tick wraps.
+ *           The timestamps are stored in addition to `bufferSize`, in an array of the same number of elements.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include "memory_span.hpp"
+#include "ring_buffer.hpp"
+#include <algorithm>
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+  /**
+   * @brief    Class template for a ring buffer with statically allocated memory in which every element carries a timestamp.
+   * @details  The `bufferSize` specifies the size of the payload storage in bytes.
+   *           The class calculates how many elements of type `T` can fit into the buffer.
+   * @tparam   T
+   *           Data type of the elements in the ring buffer.
+   * @tparam   bufferSize
+   *           The size of the payload storage in bytes.
+   * @tparam   timestamp_t
+   *           Unsigned integer type of the timestamps, `uint64_t` by default.
+   */
+  template <typename T, std::size_t bufferSize, typename timestamp_t = uint64_t>
+  class timestampedRingBuffer
+  {
+  public:
+    /**
+     * @brief      Constructor that initializes the ring buffer.
+     * @param[in]  overwrite
+     *             Specifies whether to overwrite the oldest element in the buffer when it is full.
+     *             Default is `RINGBUFFER_NO_OVERWRITE`.
+     */
+    explicit timestampedRingBuffer(MEM::ringBufferOverwrite_e overwrite = MEM::RINGBUFFER_NO_OVERWRITE);
+
+    /**
+     * @brief  Reset the ring buffer to its initial, empty state.
+     */
+    void reset();
+
+    /**
+     * @brief   Check if the ring buffer is empty.
+     * @return  `true` if the buffer is empty, `false` otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief   Check if the ring buffer is full.
+     * @return  `true` if the buffer is full, `false` otherwise.
+     */
+    bool isFull() const;
+
+    /**
+     * @brief   Get the number of elements currently stored in the ring buffer.
+     * @return  The number of elements currently stored.
+     */
+    std::size_t count() const;
+
+    /**
+     * @brief   Get the maximum number of elements that can be stored in the ring buffer.
+     * @return  The capacity of the ring buffer.
+     */
+    constexpr std::size_t capacity() const;
+
+    /**
+     * @brief      Write a single element with its timestamp to the ring buffer.
+     * @details    If the buffer is full and the overwrite behavior allows overwriting, the oldest element is overwritten.
+     * @param[in]  timestamp
+     *             The timestamp of the element, not older than the timestamp of the newest stored element.
+     * @param[in]  data
+     *             The element to be written to the buffer.
+     * @return     `true` if the data was written successfully, `false` if the timestamp is older than the newest stored one,
+     *             or if the buffer is full and overwriting is not allowed.
+     */
+    bool write(timestamp_t timestamp, const T& data);
+
+    /**
+     * @brief       Read the oldest element and its timestamp from the ring buffer.
+     * @param[out]  timestamp
+     *              The variable to store the timestamp of the element.
+     * @param[out]  data
+     *              The variable to store the read element.
+     * @return      `true` if an element was read successfully, `false` if the buffer is empty.
+     */
+    bool read(timestamp_t& timestamp, T& data);
+
+    /**
+     * @brief      Free all elements with a timestamp older than a given time.
+     * @param[in]  timestamp
+     *             The oldest timestamp to keep.
+     * @return     The number of elements freed.
+     */
+    std::size_t releaseBefore(timestamp_t timestamp);
+
+    /**
+     * @brief      Get all stored elements with a timestamp within a time window.
+     * @param[in]  startTime
+     *             The first timestamp of the window.
+     * @param[in]  endTime
+     *             The last timestamp of the window, included in the window.
+     * @return     The elements within the window, oldest first, as spans inside the buffer. Both spans are empty if no element
+     *             lies within the window.
+     */
+    MEM::memorySpanPair<const T> rangeByTime(timestamp_t startTime, timestamp_t endTime) const;
+
+    /**
+     * @brief      Get the timestamps of all stored elements within a time window.
+     * @details    The result has the same layout as the one of `rangeByTime()` for the same window, so the spans of both can be
+     *             processed side by side.
+     * @param[in]  startTime
+     *             The first timestamp of the window.
+     * @param[in]  endTime
+     *             The last timestamp of the window, included in the window.
+     * @return     The timestamps within the window, oldest first, as spans inside the buffer.
+     */
+    MEM::memorySpanPair<const timestamp_t> timestampsByTime(timestamp_t startTime, timestamp_t endTime) const;
+
+  private:
+    static constexpr std::size_t elementCount = bufferSize / sizeof(T); //!< Number of elements that can fit in the buffer.
+    static_assert(elementCount > 0, "Buffer size is too small to hold even one element of type T.");
+    static_assert(std::is_unsigned<timestamp_t>::value, "Type timestamp_t must be an unsigned integer type.");
+
+    MEM::ringBuffer<T, bufferSize>                                   m_data;       //!< The payloads.
+    MEM::ringBuffer<timestamp_t, elementCount * sizeof(timestamp_t)> m_timestamps; //!< The timestamps, at the payload positions.
+
+    /**
+     * @brief       Find the stored elements within a time window with two binary searches.
+     * @param[in]   startTime
+     *              The first timestamp of the window.
+     * @param[in]   endTime
+     *              The last timestamp of the window, included in the window.
+     * @param[out]  offset
+     *              The zero-based index of the first element in the window, relative to the oldest element.
+     * @return      The number of elements in the window.
+     */
+    std::size_t findRange(timestamp_t startTime, timestamp_t endTime, std::size_t& offset) const;
+
+    /**
+     * @brief      Count the stored timestamps that are smaller than a value, or not larger than it.
+     * @param[in]  spans
+     *             The stored timestamps, oldest first.
+     * @param[in]  timestamp
+     *             The value to compare with.
+     * @param[in]  inclusive
+     *             `true` to also count timestamps equal to the value.
+     * @return     The number of counted timestamps, which is the offset of the first timestamp not counted.
+     */
+    static std::size_t countBefore(const MEM::memorySpanPair<const timestamp_t>& spans, timestamp_t timestamp, bool inclusive);
+  };
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+namespace MEM
+{
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  timestampedRingBuffer<T, bufferSize, timestamp_t>::timestampedRingBuffer(MEM::ringBufferOverwrite_e overwrite)
+    : m_data(overwrite), m_timestamps(overwrite)
+  {
+  }
+
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  void timestampedRingBuffer<T, bufferSize, timestamp_t>::reset()
+  {
+    m_data.reset();
+    m_timestamps.reset();
+  }
+
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  bool timestampedRingBuffer<T, bufferSize, timestamp_t>::isEmpty() const
+  {
+    return m_timestamps.isEmpty();
+  }
+
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  bool timestampedRingBuffer<T, bufferSize, timestamp_t>::isFull() const
+  {
+    return m_timestamps.isFull();
+  }
+
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  std::size_t timestampedRingBuffer<T, bufferSize, timestamp_t>::count() const
+  {
+    return m_timestamps.count();
+  }
+
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  constexpr std::size_t timestampedRingBuffer<T, bufferSize, timestamp_t>::capacity() const
+  {
+    return elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  bool timestampedRingBuffer<T, bufferSize, timestamp_t>::write(timestamp_t timestamp, const T& data)
+  {
+    if (!m_timestamps.isEmpty() && (timestamp < m_timestamps[m_timestamps.count() - 1]))
+    {
+      // Keep the timestamps sorted for the binary search
+      return false;
+    }
+
+    // Both buffers are full or not full at the same time, so they overwrite or reject in lockstep
+    if (!m_data.write(data))
+    {
+      return false;
+    }
+    m_timestamps.write(timestamp);
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  bool timestampedRingBuffer<T, bufferSize, timestamp_t>::read(timestamp_t& timestamp, T& data)
+  {
+    if (!m_data.read(data))
+    {
+      return false;
+    }
+    m_timestamps.read(timestamp);
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  std::size_t timestampedRingBuffer<T, bufferSize, timestamp_t>::releaseBefore(timestamp_t timestamp)
+  {
+    const std::size_t releasedCount = countBefore(m_timestamps.readAcquire(), timestamp, false);
+
+    m_data.readRelease(releasedCount);
+    return m_timestamps.readRelease(releasedCount);
+  }
+
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  MEM::memorySpanPair<const T> timestampedRingBuffer<T, bufferSize, timestamp_t>::rangeByTime(timestamp_t startTime,
+                                                                                             timestamp_t endTime) const
+  {
+    std::size_t       offset;
+    const std::size_t rangeCount = findRange(startTime, endTime, offset);
+    return m_data.readAcquire().subRange(offset, rangeCount);
+  }
+
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  MEM::memorySpanPair<const timestamp_t> timestampedRingBuffer<T, bufferSize, timestamp_t>::timestampsByTime(timestamp_t startTime,
+                                                                                                             timestamp_t endTime) const
+  {
+    std::size_t       offset;
+    const std::size_t rangeCount = findRange(startTime, endTime, offset);
+    return m_timestamps.readAcquire().subRange(offset, rangeCount);
+  }
+
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  std::size_t timestampedRingBuffer<T, bufferSize, timestamp_t>::findRange(timestamp_t  startTime,
+                                                                            timestamp_t  endTime,
+                                                                            std::size_t& offset) const
+  {
+    const MEM::memorySpanPair<const timestamp_t> spans = m_timestamps.readAcquire();
+
+    offset = countBefore(spans, startTime, false);
+    if (endTime < startTime)
+    {
+      return 0;
+    }
+    return countBefore(spans, endTime, true) - offset;
+  }
+
+  template <typename T, std::size_t bufferSize, typename timestamp_t>
+  std::size_t timestampedRingBuffer<T, bufferSize, timestamp_t>::countBefore(const MEM::memorySpanPair<const timestamp_t>& spans,
+                                                                              timestamp_t                                   timestamp,
+                                                                              bool                                          inclusive)
+  {
+    // The second span only holds newer timestamps, so it is only searched if the whole first span is counted
+    const bool inFirst = (spans.first.size > 0) && (inclusive ? (timestamp < spans.first.data[spans.first.size - 1])
+                                                              : (timestamp <= spans.first.data[spans.first.size - 1]));
+    const timestamp_t* begin = inFirst ? spans.first.data : spans.second.data;
+    const timestamp_t* end   = inFirst ? spans.first.data + spans.first.size : spans.second.data + spans.second.size;
+    const timestamp_t* bound = inclusive ? std::upper_bound(begin, end, timestamp) : std::lower_bound(begin, end, timestamp);
+
+    return (inFirst ? 0 : spans.first.size) + static_cast<std::size_t>(bound - begin);
+  }
+
+} // namespace MEM
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
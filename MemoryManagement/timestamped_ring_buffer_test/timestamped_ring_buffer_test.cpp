@@ -0,0 +1,215 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../timestamped_ring_buffer.hpp"
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class testTimestampedRingBuffer : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testTimestampedRingBufferWriteRead();
+  void testTimestampedRingBufferRejectOlderTimestamp();
+  void testTimestampedRingBufferRangeByTime();
+  void testTimestampedRingBufferRangeAcrossWrap();
+  void testTimestampedRingBufferReleaseBefore();
+  void testTimestampedRingBufferOverwrite();
+  void testTimestampedRingBufferTimestampWrap();
+};
+#endif
+
+namespace
+{
+  /**
+   * @brief       Collect the elements of a span pair into an array, oldest first.
+   * @param[in]   spans
+   *              The span pair to collect.
+   * @param[out]  values
+   *              The array to store the elements, large enough for all of them.
+   * @return      The number of collected elements.
+   */
+  template <typename T>
+  std::size_t collect(const MEM::memorySpanPair<const T>& spans, T values[])
+  {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < spans.first.size; ++i)
+    {
+      values[count++] = spans.first.data[i];
+    }
+    for (std::size_t i = 0; i < spans.second.size; ++i)
+    {
+      values[count++] = spans.second.data[i];
+    }
+    return count;
+  }
+} // namespace
+
+TEST_CASE(testTimestampedRingBuffer, testTimestampedRingBufferWriteRead)
+{
+  MEM::timestampedRingBuffer<int, 4 * sizeof(int)> myTimestampedRingBuffer;
+  uint64_t                                         timestamp = 0;
+  int                                              value;
+
+  QVERIFY(myTimestampedRingBuffer.isEmpty());
+  QCOMPARE(static_cast<int>(myTimestampedRingBuffer.capacity()), 4);
+  QVERIFY(myTimestampedRingBuffer.write(100, 1));
+  QVERIFY(myTimestampedRingBuffer.write(200, 2));
+  QCOMPARE(static_cast<int>(myTimestampedRingBuffer.count()), 2);
+
+  QVERIFY(myTimestampedRingBuffer.read(timestamp, value));
+  QCOMPARE(static_cast<int>(timestamp), 100);
+  QCOMPARE(value, 1);
+
+  myTimestampedRingBuffer.reset();
+  QVERIFY(myTimestampedRingBuffer.isEmpty());
+  QVERIFY(!myTimestampedRingBuffer.read(timestamp, value));
+}
+
+TEST_CASE(testTimestampedRingBuffer, testTimestampedRingBufferRejectOlderTimestamp)
+{
+  MEM::timestampedRingBuffer<int, 2 * sizeof(int)> myTimestampedRingBuffer;
+
+  QVERIFY(myTimestampedRingBuffer.write(100, 1));
+  QVERIFY(myTimestampedRingBuffer.write(100, 2));
+  QVERIFY(!myTimestampedRingBuffer.write(99, 3));
+  QVERIFY(myTimestampedRingBuffer.isFull());
+  QVERIFY(!myTimestampedRingBuffer.write(101, 3));
+  QCOMPARE(static_cast<int>(myTimestampedRingBuffer.count()), 2);
+}
+
+TEST_CASE(testTimestampedRingBuffer, testTimestampedRingBufferRangeByTime)
+{
+  MEM::timestampedRingBuffer<int, 8 * sizeof(int)> myTimestampedRingBuffer;
+  int                                              values[8];
+  uint64_t                                         timestamps[8];
+
+  // Timestamps 10, 20, 20, 30, 40 with values 0 to 4
+  const uint64_t TIMES[5] = { 10, 20, 20, 30, 40 };
+  for (int i = 0; i < 5; ++i)
+  {
+    QVERIFY(myTimestampedRingBuffer.write(TIMES[i], i));
+  }
+
+  QCOMPARE(static_cast<int>(collect(myTimestampedRingBuffer.rangeByTime(20, 30), values)), 3);
+  QCOMPARE(values[0], 1);
+  QCOMPARE(values[2], 3);
+  QCOMPARE(static_cast<int>(collect(myTimestampedRingBuffer.timestampsByTime(20, 30), timestamps)), 3);
+  QCOMPARE(static_cast<int>(timestamps[0]), 20);
+  QCOMPARE(static_cast<int>(timestamps[2]), 30);
+
+  // Window bounds between stored timestamps, outside of them, and an inverted window
+  QCOMPARE(static_cast<int>(collect(myTimestampedRingBuffer.rangeByTime(15, 35), values)), 3);
+  QCOMPARE(values[0], 1);
+  QCOMPARE(static_cast<int>(collect(myTimestampedRingBuffer.rangeByTime(15, 45), values)), 4);
+  QCOMPARE(values[3], 4);
+  QCOMPARE(static_cast<int>(collect(myTimestampedRingBuffer.rangeByTime(0, 1000), values)), 5);
+  QCOMPARE(static_cast<int>(myTimestampedRingBuffer.rangeByTime(41, 1000).size()), 0);
+  QCOMPARE(static_cast<int>(myTimestampedRingBuffer.rangeByTime(0, 9).size()), 0);
+  QCOMPARE(static_cast<int>(myTimestampedRingBuffer.rangeByTime(31, 39).size()), 0);
+  QCOMPARE(static_cast<int>(myTimestampedRingBuffer.rangeByTime(30, 20).size()), 0);
+  QVERIFY(myTimestampedRingBuffer.rangeByTime(31, 39).first.data == nullptr);
+}
+
+TEST_CASE(testTimestampedRingBuffer, testTimestampedRingBufferRangeAcrossWrap)
+{
+  MEM::timestampedRingBuffer<int, 4 * sizeof(int), uint64_t> myTimestampedRingBuffer;
+  uint64_t                                                   timestamp = 0;
+  int                                                        values[4];
+  int                                                        value;
+
+  // Stored timestamps 30, 40 at the end of the storage and 50, 60 at its start
+  for (int i = 1; i <= 4; ++i)
+  {
+    QVERIFY(myTimestampedRingBuffer.write(static_cast<uint64_t>(i) * 10, i));
+  }
+  QVERIFY(myTimestampedRingBuffer.read(timestamp, value));
+  QVERIFY(myTimestampedRingBuffer.read(timestamp, value));
+  QVERIFY(myTimestampedRingBuffer.write(50, 5));
+  QVERIFY(myTimestampedRingBuffer.write(60, 6));
+
+  MEM::memorySpanPair<const int> spans = myTimestampedRingBuffer.rangeByTime(35, 55);
+  QCOMPARE(static_cast<int>(spans.first.size), 1);
+  QCOMPARE(static_cast<int>(spans.second.size), 1);
+  QCOMPARE(spans.first.data[0], 4);
+  QCOMPARE(spans.second.data[0], 5);
+
+  // A window that lies entirely in the wrapped part is returned as a single span
+  spans = myTimestampedRingBuffer.rangeByTime(50, 60);
+  QCOMPARE(static_cast<int>(spans.first.size), 2);
+  QCOMPARE(static_cast<int>(spans.second.size), 0);
+  QCOMPARE(static_cast<int>(collect(spans, values)), 2);
+  QCOMPARE(values[1], 6);
+}
+
+TEST_CASE(testTimestampedRingBuffer, testTimestampedRingBufferReleaseBefore)
+{
+  MEM::timestampedRingBuffer<int, 8 * sizeof(int)> myTimestampedRingBuffer;
+  uint64_t                                         timestamp = 0;
+  int                                              value;
+
+  for (int i = 0; i < 6; ++i)
+  {
+    QVERIFY(myTimestampedRingBuffer.write(static_cast<uint64_t>(i) * 100, i));
+  }
+
+  QCOMPARE(static_cast<int>(myTimestampedRingBuffer.releaseBefore(250)), 3);
+  QCOMPARE(static_cast<int>(myTimestampedRingBuffer.releaseBefore(300)), 0);
+  QVERIFY(myTimestampedRingBuffer.read(timestamp, value));
+  QCOMPARE(static_cast<int>(timestamp), 300);
+  QCOMPARE(value, 3);
+  QCOMPARE(static_cast<int>(myTimestampedRingBuffer.releaseBefore(10000)), 2);
+  QVERIFY(myTimestampedRingBuffer.isEmpty());
+}
+
+TEST_CASE(testTimestampedRingBuffer, testTimestampedRingBufferOverwrite)
+{
+  MEM::timestampedRingBuffer<int, 3 * sizeof(int)> myTimestampedRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+  int                                              values[3];
+  uint64_t                                         timestamps[3];
+
+  // Payloads and timestamps are overwritten in lockstep
+  for (int i = 0; i < 5; ++i)
+  {
+    QVERIFY(myTimestampedRingBuffer.write(static_cast<uint64_t>(i), i * 10));
+  }
+  QCOMPARE(static_cast<int>(collect(myTimestampedRingBuffer.rangeByTime(0, 10), values)), 3);
+  QCOMPARE(static_cast<int>(collect(myTimestampedRingBuffer.timestampsByTime(0, 10), timestamps)), 3);
+  for (int i = 0; i < 3; ++i)
+  {
+    QCOMPARE(values[i], static_cast<int>(timestamps[i]) * 10);
+    QCOMPARE(static_cast<int>(timestamps[i]), i + 2);
+  }
+}
+
+TEST_CASE(testTimestampedRingBuffer, testTimestampedRingBufferTimestampWrap)
+{
+  MEM::timestampedRingBuffer<int, 3 * sizeof(int), uint16_t> myTimestampedRingBuffer(MEM::RINGBUFFER_ALLOW_OVERWRITE);
+  uint16_t                                                   timestamp = 0;
+  int                                                        value;
+
+  QVERIFY(myTimestampedRingBuffer.write(65534, 1));
+  QVERIFY(myTimestampedRingBuffer.write(65535, 2));
+
+  // After the timestamp wraps, writes are rejected even though overwriting is allowed
+  QVERIFY(!myTimestampedRingBuffer.write(0, 3));
+  QVERIFY(!myTimestampedRingBuffer.write(1, 4));
+  QCOMPARE(static_cast<int>(myTimestampedRingBuffer.count()), 2);
+
+  // Resetting on the wrap accepts the new timestamps again
+  myTimestampedRingBuffer.reset();
+  QVERIFY(myTimestampedRingBuffer.write(1, 4));
+  QVERIFY(myTimestampedRingBuffer.read(timestamp, value));
+  QCOMPARE(static_cast<int>(timestamp), 1);
+  QCOMPARE(value, 4);
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testTimestampedRingBuffer)
+#include "timestamped_ring_buffer_test.moc"
+#endif
@@ -0,0 +1,203 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     wait_point.hpp
+ * @version  0.1
+ * @brief    Definition of the waitPoint class.
+ * @details  The `waitPoint` class lets a thread sleep until a condition on a shared container becomes true, instead of spinning
+ *           on it. Threads that change the container call `notify()` afterwards. A notification only results in a wakeup
+ *           (and on Linux in a system call) when at least one thread is actually sleeping, so producers pay no more than a
+ *           memory fence and a load while nobody waits.
+ *
+ *           On Linux the sleeping is implemented with a futex on an epoch counter. On other platforms a
+ *           `std::condition_variable` is used instead.
+ *
+ *           To use the `waitPoint` class, follow these steps:
+ *           -# Let the waiting thread call `waitUntil()` with a predicate that checks the condition and a timeout, like this:
+ *              `myWaitPoint.waitUntil([&]() { return !myBuffer.isEmpty(); }, std::chrono::milliseconds(10));`.
+ *           -# Let the modifying thread call `notify()` after every change that may satisfy the condition.
+ *
+ * @note     The predicate must only depend on state that is published before `notify()` is called, with at least release
+ *           semantics (atomics with release stores, or a mutex).
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include <atomic>
+#include <chrono>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+  /**
+   * @brief    Sleep/wakeup point for threads that wait for a condition on a shared container.
+   * @details  Counts the sleeping threads, so that `notify()` can skip the wakeup when there are none.
+   */
+  class waitPoint
+  {
+  public:
+    /**
+     * @brief  Constructor that initializes a wait point without sleeping threads.
+     */
+    waitPoint();
+
+    // Rule of Five
+    waitPoint(const waitPoint&)            = delete;
+    waitPoint& operator=(const waitPoint&) = delete;
+    waitPoint(waitPoint&&)                 = delete;
+    waitPoint& operator=(waitPoint&&)      = delete;
+    ~waitPoint()                           = default;
+
+    /**
+     * @brief      Sleep until a condition becomes true or a timeout expires.
+     * @param[in]  ready
+     *             Predicate without arguments that returns `true` once the condition is met.
+     * @param[in]  timeout
+     *             The maximum time to wait.
+     * @return     The result of `ready()` when the function returns: `true` if the condition is met, `false` on timeout.
+     */
+    template <typename predicate_t>
+    bool waitUntil(predicate_t ready, std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief  Wake all sleeping threads so they re-evaluate their condition, does nothing if no thread is sleeping.
+     */
+    void notify();
+
+    /**
+     * @brief   Check if any thread is currently sleeping on the wait point.
+     * @return  `true` if at least one thread is waiting, `false` otherwise.
+     */
+    bool hasWaiters() const;
+
+  private:
+    std::atomic<uint32_t> m_epoch;   //!< Incremented on every wakeup, sleeping threads wait for it to change.
+    std::atomic<uint32_t> m_waiters; //!< Number of threads that are about to sleep or are sleeping.
+#if !defined(__linux__)
+    std::mutex              m_mutex;     //!< Protects the epoch check of the condition variable.
+    std::condition_variable m_condition; //!< Condition variable the threads sleep on.
+#endif
+
+    /**
+     * @brief      Sleep as long as the epoch still has the expected value, at most until the timeout expires.
+     * @param[in]  epoch
+     *             The epoch observed before the condition was checked.
+     * @param[in]  timeout
+     *             The maximum time to sleep.
+     */
+    void sleep(uint32_t epoch, std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief  Wake all threads sleeping in `sleep()`.
+     */
+    void wakeAll();
+  };
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+namespace MEM
+{
+  inline waitPoint::waitPoint() : m_epoch(0), m_waiters(0)
+  {
+  }
+
+  template <typename predicate_t>
+  bool waitPoint::waitUntil(predicate_t ready, std::chrono::nanoseconds timeout)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (!ready())
+    {
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline)
+      {
+        return false;
+      }
+
+      // Announce the sleeper before the final check, so a concurrent notify() either sees it or the check sees the change
+      m_waiters.fetch_add(1, std::memory_order_seq_cst);
+      const uint32_t epoch = m_epoch.load(std::memory_order_seq_cst);
+      if (!ready())
+      {
+        sleep(epoch, deadline - now);
+      }
+      m_waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    return true;
+  }
+
+  inline void waitPoint::notify()
+  {
+    // Order the caller's preceding stores before the waiter check, pairs with the increment in waitUntil()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiters.load(std::memory_order_relaxed) != 0)
+    {
+      wakeAll();
+    }
+  }
+
+  inline bool waitPoint::hasWaiters() const
+  {
+    return m_waiters.load(std::memory_order_relaxed) != 0;
+  }
+
+#if defined(__linux__)
+  inline void waitPoint::sleep(uint32_t epoch, std::chrono::nanoseconds timeout)
+  {
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "The futex word must be a plain 32-bit integer.");
+
+    struct timespec relativeTimeout;
+    relativeTimeout.tv_sec  = static_cast<time_t>(timeout.count() / 1000000000);
+    relativeTimeout.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+
+    // Returns immediately if the epoch changed after it was observed, so no wakeup is lost
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_epoch), FUTEX_WAIT_PRIVATE, epoch, &relativeTimeout, nullptr, 0);
+  }
+
+  inline void waitPoint::wakeAll()
+  {
+    m_epoch.fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_epoch), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+  }
+#else
+  inline void waitPoint::sleep(uint32_t epoch, std::chrono::nanoseconds timeout)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait_for(lock, timeout, [&]() { return m_epoch.load(std::memory_order_relaxed) != epoch; });
+  }
+
+  inline void waitPoint::wakeAll()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_epoch.fetch_add(1, std::memory_order_release);
+    }
+    m_condition.notify_all();
+  }
+#endif
+
+} // namespace MEM
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
@@ -0,0 +1,86 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../wait_point.hpp"
+#include <thread>
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class testWaitPoint : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testWaitPointReadyImmediately();
+  void testWaitPointTimeout();
+  void testWaitPointNotifyWakesWaiter();
+  void testWaitPointNotifyWithoutWaiters();
+};
+#endif
+
+TEST_CASE(testWaitPoint, testWaitPointReadyImmediately)
+{
+  MEM::waitPoint myWaitPoint;
+
+  QVERIFY(myWaitPoint.waitUntil([]() { return true; }, std::chrono::milliseconds(0)));
+  QVERIFY(!myWaitPoint.hasWaiters());
+}
+
+TEST_CASE(testWaitPoint, testWaitPointTimeout)
+{
+  MEM::waitPoint myWaitPoint;
+  const auto     TIMEOUT = std::chrono::milliseconds(20);
+
+  const auto start  = std::chrono::steady_clock::now();
+  const bool result = myWaitPoint.waitUntil([]() { return false; }, TIMEOUT);
+  const auto stop   = std::chrono::steady_clock::now();
+
+  QVERIFY(!result);
+  QVERIFY((stop - start) >= TIMEOUT);
+  QVERIFY(!myWaitPoint.hasWaiters());
+}
+
+TEST_CASE(testWaitPoint, testWaitPointNotifyWakesWaiter)
+{
+  MEM::waitPoint    myWaitPoint;
+  std::atomic<bool> ready(false);
+
+  std::thread notifier(
+    [&]()
+    {
+      // Only notify once the waiter is asleep, so the wakeup itself is tested
+      while (!myWaitPoint.hasWaiters())
+      {
+        std::this_thread::yield();
+      }
+      ready.store(true, std::memory_order_release);
+      myWaitPoint.notify();
+    });
+
+  const auto start  = std::chrono::steady_clock::now();
+  const bool result = myWaitPoint.waitUntil([&]() { return ready.load(std::memory_order_acquire); }, std::chrono::seconds(10));
+  const auto stop   = std::chrono::steady_clock::now();
+  notifier.join();
+
+  QVERIFY(result);
+  QVERIFY((stop - start) < std::chrono::seconds(5));
+}
+
+TEST_CASE(testWaitPoint, testWaitPointNotifyWithoutWaiters)
+{
+  MEM::waitPoint myWaitPoint;
+
+  QVERIFY(!myWaitPoint.hasWaiters());
+  myWaitPoint.notify();
+  QVERIFY(!myWaitPoint.hasWaiters());
+  QVERIFY(myWaitPoint.waitUntil([]() { return true; }, std::chrono::milliseconds(1)));
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testWaitPoint)
+#include "wait_point_test.moc"
+#endif
@@ -0,0 +1,253 @@
+/*************************************************************************\
+ * Documentation
+\*************************************************************************/
+/**
+ * @file     work_stealing_deque.hpp
+ * @version  0.1
+ * @brief    Definition of the workStealingDeque class.
+ * @details  The `workStealingDeque` class is a bounded, lock-free work-stealing deque with statically allocated memory, after
+ *           Chase and Lev. It is meant for task runtimes where every worker thread owns one deque: the owner pushes and pops
+ *           tasks at the bottom like a stack, and idle workers steal the oldest tasks from the top of other workers' deques.
+ *
+ *           The owner works without any locking or read-modify-write instruction, except when it takes the very last task,
+ *           which it may race with a thief for. A thief claims the top task with a single compare-and-swap. The top and
+ *           bottom positions each live on their own cache line, so the owner and the thieves only share a cache line while
+ *           the deque is nearly empty.
+ *
+ *           The template parameters are the data type (`T`) and the buffer size in bytes (`bufferSize`), as for the other
+ *           lock-free ring buffers. The elements are stored as `std::atomic<T>`, since a thief may read a slot that the owner
+ *           overwrites at the same time; the thief then loses the compare-and-swap and discards the value. `T` must therefore
+ *           be trivially copyable and should be small, typically a pointer or an index of a task.
+ *
+ *           To use the `workStealingDeque` class, follow these steps:
+ *           -# Instantiate one instance per worker with the desired data type and buffer size in bytes as template parameters,
+ *              like this: `workStealingDeque<task_t*, 1024> myWorkStealingDeque;`.
+ *           -# Call `push()` and `pop()` only from the owning worker, like this: `myWorkStealingDeque.push(myTask);`.
+ *           -# Call `steal()` from any other worker, like this: `task_t* myTask; myWorkStealingDeque.steal(myTask);`.
+ *           -# Check the return value of `push()`, `pop()` and `steal()` to determine whether or not an operation was successful.
+ *
+ * @note     The number of elements that fit into `bufferSize` must be a power of two, so that slot positions can be derived
+ *           with a mask. If it is not, a compile-time error will occur. `push()` rejects new elements when the deque is full.
+ *           `reset()` is not thread-safe.
+ */
+
+#pragma once
+/*************************************************************************\
+ * Includes
+\*************************************************************************/
+#include "global.hpp"
+#include <atomic>
+
+/*************************************************************************\
+ * Prototypes
+\*************************************************************************/
+namespace MEM
+{
+  /**
+   * @brief    Class template for a bounded lock-free work-stealing deque with statically allocated memory.
+   * @details  The `bufferSize` specifies the size of the element storage in bytes.
+   *           The class calculates how many elements of type `T` can fit into the buffer.
+   * @tparam   T
+   *           Data type of the elements in the deque, which must be trivially copyable.
+   * @tparam   bufferSize
+   *           The size of the element storage in bytes.
+   */
+  template <typename T, std::size_t bufferSize>
+  class workStealingDeque
+  {
+  public:
+    /**
+     * @brief  Constructor that initializes an empty deque.
+     */
+    workStealingDeque();
+
+    // Rule of Five
+    workStealingDeque(const workStealingDeque&)            = delete;
+    workStealingDeque& operator=(const workStealingDeque&) = delete;
+    workStealingDeque(workStealingDeque&&)                 = delete;
+    workStealingDeque& operator=(workStealingDeque&&)      = delete;
+    ~workStealingDeque()                                   = default;
+
+    /**
+     * @brief  Reset the deque to its initial, empty state.
+     * @note   Not thread-safe, no other thread may access the deque during the reset.
+     */
+    void reset();
+
+    /**
+     * @brief   Check if the deque is empty.
+     * @return  `true` if the deque was empty at the time of the call, `false` otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief   Get the number of elements currently stored in the deque.
+     * @return  The number of elements, which is a snapshot under concurrent access.
+     */
+    std::size_t count() const;
+
+    /**
+     * @brief   Get the maximum number of elements that can be stored in the deque.
+     * @return  The capacity of the deque.
+     */
+    constexpr std::size_t capacity() const;
+
+    /**
+     * @brief      Add an element at the bottom of the deque. May only be called by the owner.
+     * @param[in]  data
+     *             The element to be added.
+     * @return     `true` if the element was added successfully, `false` if the deque is full.
+     */
+    bool push(const T& data);
+
+    /**
+     * @brief       Take the newest element from the bottom of the deque. May only be called by the owner.
+     * @param[out]  data
+     *              The variable to store the element.
+     * @return      `true` if an element was taken, `false` if the deque is empty or a thief took the last element.
+     */
+    bool pop(T& data);
+
+    /**
+     * @brief       Take the oldest element from the top of the deque. May be called by any thread.
+     * @param[out]  data
+     *              The variable to store the element.
+     * @return      `true` if an element was taken, `false` if the deque is empty or another thread took the element first.
+     *              In the latter case the caller typically tries another deque instead of retrying right away.
+     */
+    bool steal(T& data);
+
+  private:
+    static constexpr std::size_t elementCount = bufferSize / sizeof(T); //!< Number of elements that can fit in the buffer.
+    static_assert(elementCount > 0, "Buffer size is too small to hold even one element of type T.");
+    static_assert(isPowerOfTwo(elementCount), "The number of elements that fit in the buffer must be a power of two.");
+    static constexpr std::size_t indexMask = elementCount - 1; //!< Mask to convert a position into a slot index.
+
+    // The positions are signed, since the owner's pop() temporarily moves the bottom below the top of an empty deque
+    alignas(cacheLineSize) std::atomic<std::ptrdiff_t> m_top;    //!< Position of the oldest element, advanced by thieves.
+    alignas(cacheLineSize) std::atomic<std::ptrdiff_t> m_bottom; //!< Position behind the newest element, owned by the owner.
+    alignas(cacheLineSize) std::atomic<T> m_dataArray[elementCount]; //!< The statically allocated slots.
+  };
+
+} // namespace MEM
+
+/*************************************************************************\
+ * Implementation
+\*************************************************************************/
+namespace MEM
+{
+  template <typename T, std::size_t bufferSize>
+  workStealingDeque<T, bufferSize>::workStealingDeque()
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Type T must be trivially copyable.");
+    reset();
+  }
+
+  template <typename T, std::size_t bufferSize>
+  void workStealingDeque<T, bufferSize>::reset()
+  {
+    m_top.store(0, std::memory_order_relaxed);
+    m_bottom.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool workStealingDeque<T, bufferSize>::isEmpty() const
+  {
+    return count() == 0;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  std::size_t workStealingDeque<T, bufferSize>::count() const
+  {
+    const std::ptrdiff_t top    = m_top.load(std::memory_order_acquire);
+    const std::ptrdiff_t bottom = m_bottom.load(std::memory_order_acquire);
+
+    // During a pop() or a race for the last element the bottom may be below the top
+    return (bottom > top) ? static_cast<std::size_t>(bottom - top) : 0;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  constexpr std::size_t workStealingDeque<T, bufferSize>::capacity() const
+  {
+    return elementCount;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool workStealingDeque<T, bufferSize>::push(const T& data)
+  {
+    const std::ptrdiff_t bottom = m_bottom.load(std::memory_order_relaxed);
+    const std::ptrdiff_t top    = m_top.load(std::memory_order_acquire);
+    if (bottom - top >= static_cast<std::ptrdiff_t>(elementCount))
+    {
+      return false;
+    }
+
+    m_dataArray[static_cast<std::size_t>(bottom) & indexMask].store(data, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool workStealingDeque<T, bufferSize>::pop(T& data)
+  {
+    // Reserve the bottom element first, then check whether a thief got to it in the meantime
+    const std::ptrdiff_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::ptrdiff_t top = m_top.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+      // The deque is empty
+      m_bottom.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    const T candidate = m_dataArray[static_cast<std::size_t>(bottom) & indexMask].load(std::memory_order_relaxed);
+    if (top < bottom)
+    {
+      // More elements are left, no thief can reach this one
+      data = candidate;
+      return true;
+    }
+
+    // This is the last element, race the thieves for it like a thief would
+    const bool taken = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    if (taken)
+    {
+      data = candidate;
+    }
+    return taken;
+  }
+
+  template <typename T, std::size_t bufferSize>
+  bool workStealingDeque<T, bufferSize>::steal(T& data)
+  {
+    std::ptrdiff_t top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::ptrdiff_t bottom = m_bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+    {
+      // The deque is empty
+      return false;
+    }
+
+    // The slot may be overwritten by the owner once another thief advanced the top, then the exchange fails
+    const T candidate = m_dataArray[static_cast<std::size_t>(top) & indexMask].load(std::memory_order_relaxed);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+      return false;
+    }
+    data = candidate;
+    return true;
+  }
+
+} // namespace MEM
+
+/*************************************************************************\
+ * End of file
+\*************************************************************************/
@@ -0,0 +1,177 @@
+#include "../../Tools/Testing/test_helper.hpp"
+#include "../work_stealing_deque.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if defined(QT_TESTLIB_LIB)
+#include <QCoreApplication>
+#include <QtTest/QtTest>
+#else
+#include "gtest/gtest.h"
+#endif
+
+#if defined(QT_TESTLIB_LIB)
+class testWorkStealingDeque : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void testWorkStealingDequeOwner();
+  void testWorkStealingDequeSteal();
+  void testWorkStealingDequeWrapAround();
+  void testWorkStealingDequeConcurrentSteal();
+};
+#endif
+
+TEST_CASE(testWorkStealingDeque, testWorkStealingDequeOwner)
+{
+  MEM::workStealingDeque<int, 4 * sizeof(int)> myWorkStealingDeque;
+  int                                          value;
+
+  QVERIFY(myWorkStealingDeque.isEmpty());
+  QCOMPARE(static_cast<int>(myWorkStealingDeque.capacity()), 4);
+  QVERIFY(!myWorkStealingDeque.pop(value));
+
+  // Fill the deque and verify that it rejects further elements
+  for (int i = 1; i <= 4; ++i)
+  {
+    QVERIFY(myWorkStealingDeque.push(i));
+  }
+  QVERIFY(!myWorkStealingDeque.push(5));
+  QCOMPARE(static_cast<int>(myWorkStealingDeque.count()), 4);
+
+  // The owner takes the newest element first
+  for (int i = 4; i >= 1; --i)
+  {
+    QVERIFY(myWorkStealingDeque.pop(value));
+    QCOMPARE(value, i);
+  }
+  QVERIFY(!myWorkStealingDeque.pop(value));
+  QVERIFY(myWorkStealingDeque.isEmpty());
+}
+
+TEST_CASE(testWorkStealingDeque, testWorkStealingDequeSteal)
+{
+  MEM::workStealingDeque<int, 8 * sizeof(int)> myWorkStealingDeque;
+  int                                          value;
+
+  QVERIFY(!myWorkStealingDeque.steal(value));
+  for (int i = 1; i <= 4; ++i)
+  {
+    myWorkStealingDeque.push(i);
+  }
+
+  // Thieves take the oldest element, the owner the newest
+  QVERIFY(myWorkStealingDeque.steal(value));
+  QCOMPARE(value, 1);
+  QVERIFY(myWorkStealingDeque.pop(value));
+  QCOMPARE(value, 4);
+  QVERIFY(myWorkStealingDeque.steal(value));
+  QCOMPARE(value, 2);
+
+  // The last element can be taken from both ends exactly once
+  QVERIFY(myWorkStealingDeque.steal(value));
+  QCOMPARE(value, 3);
+  QVERIFY(!myWorkStealingDeque.pop(value));
+  QVERIFY(!myWorkStealingDeque.steal(value));
+
+  myWorkStealingDeque.push(5);
+  myWorkStealingDeque.reset();
+  QVERIFY(myWorkStealingDeque.isEmpty());
+}
+
+TEST_CASE(testWorkStealingDeque, testWorkStealingDequeWrapAround)
+{
+  MEM::workStealingDeque<int, 2 * sizeof(int)> myWorkStealingDeque;
+  int                                          value;
+
+  // Stealing advances the top, so the slots are reused from both ends several times
+  for (int i = 0; i < 20; ++i)
+  {
+    QVERIFY(myWorkStealingDeque.push(i));
+    QVERIFY(myWorkStealingDeque.push(i + 100));
+    QVERIFY(!myWorkStealingDeque.push(i + 200));
+    QVERIFY(myWorkStealingDeque.steal(value));
+    QCOMPARE(value, i);
+    QVERIFY(myWorkStealingDeque.pop(value));
+    QCOMPARE(value, i + 100);
+  }
+  QVERIFY(myWorkStealingDeque.isEmpty());
+}
+
+TEST_CASE(testWorkStealingDeque, testWorkStealingDequeConcurrentSteal)
+{
+  const int                                      TASK_COUNT  = 100000;
+  const int                                      THIEF_COUNT = 3;
+  MEM::workStealingDeque<int, 256 * sizeof(int)> myWorkStealingDeque;
+  std::vector<std::atomic<int>>                  executions(TASK_COUNT);
+  std::atomic<int>                               executedCount(0);
+  std::vector<std::thread>                       thieves;
+
+  for (auto& execution : executions)
+  {
+    execution.store(0);
+  }
+
+  for (int threadIndex = 0; threadIndex < THIEF_COUNT; ++threadIndex)
+  {
+    thieves.emplace_back([&]() {
+      int task;
+      while (executedCount.load() < TASK_COUNT)
+      {
+        if (myWorkStealingDeque.steal(task))
+        {
+          executions[task].fetch_add(1);
+          executedCount.fetch_add(1);
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // The owner pushes all tasks and executes some of them itself, racing the thieves for the last ones
+  int task;
+  for (int next = 0; next < TASK_COUNT;)
+  {
+    if (myWorkStealingDeque.push(next))
+    {
+      ++next;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+    if ((next % 3 == 0 || next == TASK_COUNT) && myWorkStealingDeque.pop(task))
+    {
+      executions[task].fetch_add(1);
+      executedCount.fetch_add(1);
+    }
+  }
+  while (myWorkStealingDeque.pop(task))
+  {
+    executions[task].fetch_add(1);
+    executedCount.fetch_add(1);
+  }
+  for (auto& thief : thieves)
+  {
+    thief.join();
+  }
+
+  // Every task was executed exactly once
+  bool executedOnce = true;
+  for (auto& execution : executions)
+  {
+    executedOnce = executedOnce && (execution.load() == 1);
+  }
+  QVERIFY(executedOnce);
+  QCOMPARE(executedCount.load(), TASK_COUNT);
+}
+
+#if defined(QT_TESTLIB_LIB)
+QTEST_GUILESS_MAIN(testWorkStealingDeque)
+#include "work_stealing_deque_test.moc"
+#endif